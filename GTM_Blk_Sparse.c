@@ -0,0 +1,418 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <mpi.h>
+
+#include "GTMatrix_Retval.h"
+#include "GTMatrix_Typedef.h"
+#include "GTMatrix_Other.h"
+#include "GTM_Blk_Sparse.h"
+#include "utils.h"
+
+int GTM_createBlkSparse(
+    GTM_Blk_Sparse_t *_gtbs, MPI_Comm comm, MPI_Datatype datatype,
+    int unit_size, int my_rank, int nrows, int ncols,
+    int r_blocks, int c_blocks, int *r_displs, int *c_displs,
+    int tile_dim, int pool_size
+)
+{
+    // Validate process info before allocating anything
+    int comm_size;
+    MPI_Comm_size(comm, &comm_size);
+    if ((my_rank < 0) || (my_rank >= comm_size)) return GTM_INVALID_RANK;
+    if (r_blocks * c_blocks != comm_size) return GTM_INVALID_RCBLOCK;
+
+    GTM_Blk_Sparse_t gtbs = (GTM_Blk_Sparse_t) malloc(sizeof(struct GTM_Blk_Sparse));
+    if (gtbs == NULL) return GTM_ALLOC_FAILED;
+
+    // Copy matrix and process info
+    MPI_Comm_dup(comm, &gtbs->mpi_comm);
+    gtbs->datatype  = datatype;
+    gtbs->unit_size = unit_size;
+    gtbs->my_rank   = my_rank;
+    gtbs->comm_size = comm_size;
+    gtbs->nrows     = nrows;
+    gtbs->ncols     = ncols;
+    gtbs->r_blocks  = r_blocks;
+    gtbs->c_blocks  = c_blocks;
+    gtbs->my_rowblk = my_rank / c_blocks;
+    gtbs->my_colblk = my_rank % c_blocks;
+
+    // Copy and validate the partition, generate r_blklens and c_blklens
+    int ret = GTM_copyPartition(
+        nrows, ncols, r_blocks, c_blocks, r_displs, c_displs,
+        &gtbs->r_displs, &gtbs->r_blklens, &gtbs->c_displs, &gtbs->c_blklens
+    );
+    if (ret != GTM_SUCCESS)
+    {
+        MPI_Comm_free(&gtbs->mpi_comm);
+        free(gtbs);
+        return ret;
+    }
+    gtbs->my_nrows = gtbs->r_blklens[gtbs->my_rowblk];
+    gtbs->my_ncols = gtbs->c_blklens[gtbs->my_colblk];
+
+    // Set up tile grid of local block and tile pool size
+    if (tile_dim <= 0) tile_dim = GTM_BS_DEFAULT_TILE;
+    gtbs->tile_dim     = tile_dim;
+    gtbs->tile_msize   = tile_dim * tile_dim * unit_size;
+    gtbs->my_tile_rows = (gtbs->my_nrows + tile_dim - 1) / tile_dim;
+    gtbs->my_tile_cols = (gtbs->my_ncols + tile_dim - 1) / tile_dim;
+    int my_ntiles = gtbs->my_tile_rows * gtbs->my_tile_cols;
+    if (pool_size <= 0)
+        MPI_Allreduce(&my_ntiles, &pool_size, 1, MPI_INT, MPI_MAX, gtbs->mpi_comm);
+    gtbs->pool_size = pool_size;
+
+    // Allocate tile occupancy map and tile pool, bind them to MPI windows
+    gtbs->tile_map  = (int*) malloc(sizeof(int) * (my_ntiles + 1));
+    gtbs->tile_pool = malloc((size_t) gtbs->tile_msize * (size_t) pool_size);
+    // All processes must agree on the failure, otherwise the others will
+    // hang in MPI_Win_create
+    int alloc_ok = (gtbs->tile_map != NULL) && (gtbs->tile_pool != NULL), all_ok;
+    MPI_Allreduce(&alloc_ok, &all_ok, 1, MPI_INT, MPI_MIN, gtbs->mpi_comm);
+    if (all_ok == 0)
+    {
+        MPI_Comm_free(&gtbs->mpi_comm);
+        free(gtbs->r_displs);
+        free(gtbs->r_blklens);
+        free(gtbs->c_displs);
+        free(gtbs->c_blklens);
+        free(gtbs->tile_map);
+        free(gtbs->tile_pool);
+        free(gtbs);
+        return GTM_ALLOC_FAILED;
+    }
+    gtbs->tile_map[0] = 0;
+    for (int i = 1; i <= my_ntiles; i++) gtbs->tile_map[i] = GTM_BS_ZERO_TILE;
+    memset(gtbs->tile_pool, 0, (size_t) gtbs->tile_msize * (size_t) pool_size);
+
+    MPI_Info mpi_info;
+    MPI_Info_create(&mpi_info);
+    MPI_Aint map_msize  = (MPI_Aint) sizeof(int) * (MPI_Aint) (my_ntiles + 1);
+    MPI_Aint pool_msize = (MPI_Aint) gtbs->tile_msize * (MPI_Aint) pool_size;
+    MPI_Win_create(gtbs->tile_map,  map_msize,  sizeof(int), mpi_info, gtbs->mpi_comm, &gtbs->map_win);
+    MPI_Win_create(gtbs->tile_pool, pool_msize, unit_size,   mpi_info, gtbs->mpi_comm, &gtbs->pool_win);
+    MPI_Info_free(&mpi_info);
+
+    gtbs->map_buf_size = 0;
+    gtbs->map_buf      = NULL;
+
+    *_gtbs = gtbs;
+    return GTM_SUCCESS;
+}
+
+int GTM_destroyBlkSparse(GTM_Blk_Sparse_t gtbs)
+{
+    if (gtbs == NULL) return GTM_NULL_PTR;
+
+    MPI_Win_free(&gtbs->map_win);
+    MPI_Win_free(&gtbs->pool_win);
+    MPI_Comm_free(&gtbs->mpi_comm);
+
+    free(gtbs->r_displs);
+    free(gtbs->r_blklens);
+    free(gtbs->c_displs);
+    free(gtbs->c_blklens);
+    free(gtbs->tile_map);
+    free(gtbs->tile_pool);
+    free(gtbs->map_buf);
+    free(gtbs);
+
+    return GTM_SUCCESS;
+}
+
+int GTM_resetBlkSparse(GTM_Blk_Sparse_t gtbs)
+{
+    if (gtbs == NULL) return GTM_NULL_PTR;
+
+    // Wait all processes to finish their access before releasing the tiles
+    MPI_Barrier(gtbs->mpi_comm);
+    int my_ntiles = gtbs->my_tile_rows * gtbs->my_tile_cols;
+    int used_slots = gtbs->tile_map[0];
+    memset(gtbs->tile_pool, 0, (size_t) gtbs->tile_msize * (size_t) used_slots);
+    gtbs->tile_map[0] = 0;
+    for (int i = 1; i <= my_ntiles; i++) gtbs->tile_map[i] = GTM_BS_ZERO_TILE;
+    MPI_Barrier(gtbs->mpi_comm);
+
+    return GTM_SUCCESS;
+}
+
+int GTM_getBlkSparseLocalNnzTiles(GTM_Blk_Sparse_t gtbs)
+{
+    if (gtbs == NULL) return -GTM_NULL_PTR;
+    int my_ntiles = gtbs->my_tile_rows * gtbs->my_tile_cols;
+    int nnz_tiles = 0;
+    for (int i = 1; i <= my_ntiles; i++)
+        if (gtbs->tile_map[i] >= 0) nnz_tiles++;
+    return nnz_tiles;
+}
+
+// Fetch tile occupancy map entries of tiles [tr_s:tr_e, tc_s:tc_e] on a
+// process, map entries are stored in gtbs->map_buf with leading dimension
+// tc_e - tc_s + 1. The map window of dst_rank should be locked.
+static int GTM_BS_fetchTileMap(
+    GTM_Blk_Sparse_t gtbs, int dst_rank,
+    int tr_s, int tr_e, int tc_s, int tc_e
+)
+{
+    int dst_tile_cols = (gtbs->c_blklens[dst_rank % gtbs->c_blocks] + gtbs->tile_dim - 1) / gtbs->tile_dim;
+    int ntr = tr_e - tr_s + 1;
+    int ntc = tc_e - tc_s + 1;
+    if (ntr * ntc > gtbs->map_buf_size)
+    {
+        free(gtbs->map_buf);
+        gtbs->map_buf_size = ntr * ntc;
+        gtbs->map_buf = (int*) malloc(sizeof(int) * gtbs->map_buf_size);
+        if (gtbs->map_buf == NULL) return GTM_ALLOC_FAILED;
+    }
+    // Other processes may update the map with MPI_Compare_and_swap at
+    // the same time, read it with an atomic MPI_Get_accumulate
+    for (int tr = tr_s; tr <= tr_e; tr++)
+    {
+        int *map_row = gtbs->map_buf + (tr - tr_s) * ntc;
+        MPI_Aint map_pos = 1 + tr * dst_tile_cols + tc_s;
+        MPI_Get_accumulate(
+            NULL, 0, MPI_INT, map_row, ntc, MPI_INT,
+            dst_rank, map_pos, ntc, MPI_INT, MPI_NO_OP, gtbs->map_win
+        );
+    }
+    MPI_Win_flush(dst_rank, gtbs->map_win);
+    return GTM_SUCCESS;
+}
+
+// Get a rectangle in a single tile of a process using MPI_Get, the pool
+// window of dst_rank should be locked
+static void GTM_BS_getFromTile(
+    GTM_Blk_Sparse_t gtbs, int dst_rank, int slot, int t_row, int t_col,
+    int row_num, int col_num, void *src_buf, int src_buf_ld
+)
+{
+    MPI_Aint dst_pos = (MPI_Aint) slot * (MPI_Aint) (gtbs->tile_dim * gtbs->tile_dim);
+    dst_pos += t_row * gtbs->tile_dim + t_col;
+    MPI_Datatype dst_dt, rcv_dt;
+    MPI_Type_vector(row_num, col_num, gtbs->tile_dim, gtbs->datatype, &dst_dt);
+    MPI_Type_vector(row_num, col_num, src_buf_ld,     gtbs->datatype, &rcv_dt);
+    MPI_Type_commit(&dst_dt);
+    MPI_Type_commit(&rcv_dt);
+    MPI_Get(src_buf, 1, rcv_dt, dst_rank, dst_pos, 1, dst_dt, gtbs->pool_win);
+    MPI_Type_free(&dst_dt);
+    MPI_Type_free(&rcv_dt);
+}
+
+// Update a rectangle in a single tile of a process using MPI_Accumulate,
+// the pool window of dst_rank should be locked
+static void GTM_BS_updateToTile(
+    GTM_Blk_Sparse_t gtbs, int dst_rank, MPI_Op op, int slot, int t_row, int t_col,
+    int row_num, int col_num, void *src_buf, int src_buf_ld
+)
+{
+    MPI_Aint dst_pos = (MPI_Aint) slot * (MPI_Aint) (gtbs->tile_dim * gtbs->tile_dim);
+    dst_pos += t_row * gtbs->tile_dim + t_col;
+    MPI_Datatype dst_dt, src_dt;
+    MPI_Type_vector(row_num, col_num, gtbs->tile_dim, gtbs->datatype, &dst_dt);
+    MPI_Type_vector(row_num, col_num, src_buf_ld,     gtbs->datatype, &src_dt);
+    MPI_Type_commit(&dst_dt);
+    MPI_Type_commit(&src_dt);
+    MPI_Accumulate(src_buf, 1, src_dt, dst_rank, dst_pos, 1, dst_dt, op, gtbs->pool_win);
+    MPI_Type_free(&dst_dt);
+    MPI_Type_free(&src_dt);
+}
+
+// Allocate a pool slot on a process for a zero tile. If another process has
+// allocated a slot for this tile, use that slot. Both windows of dst_rank
+// should be locked.
+// Output parameter:
+//   *slot : Pool slot of the tile
+static int GTM_BS_allocTile(GTM_Blk_Sparse_t gtbs, int dst_rank, int tile_idx, int *slot)
+{
+    int zero_tile = GTM_BS_ZERO_TILE, alloc_tile = GTM_BS_ALLOC_TILE;
+    int new_slot, old_slot;
+    while (1)
+    {
+        // Claim the tile first so that only one process allocates a pool slot for it
+        MPI_Compare_and_swap(
+            &alloc_tile, &zero_tile, &old_slot, MPI_INT,
+            dst_rank, 1 + tile_idx, gtbs->map_win
+        );
+        MPI_Win_flush(dst_rank, gtbs->map_win);
+        if (old_slot >= 0)
+        {
+            *slot = old_slot;
+            return GTM_SUCCESS;
+        }
+        // Another process is allocating this tile, wait for it
+        if (old_slot == GTM_BS_ALLOC_TILE) continue;
+
+        // Increase the used slot counter with compare-and-swap so that it
+        // never goes past pool_size when the pool is full
+        int used, next_used;
+        MPI_Fetch_and_op(NULL, &used, MPI_INT, dst_rank, 0, MPI_NO_OP, gtbs->map_win);
+        MPI_Win_flush(dst_rank, gtbs->map_win);
+        new_slot = GTM_BS_ZERO_TILE;
+        while (used < gtbs->pool_size)
+        {
+            next_used = used + 1;
+            MPI_Compare_and_swap(&next_used, &used, &old_slot, MPI_INT, dst_rank, 0, gtbs->map_win);
+            MPI_Win_flush(dst_rank, gtbs->map_win);
+            if (old_slot == used)
+            {
+                new_slot = used;
+                break;
+            }
+            used = old_slot;
+        }
+        MPI_Accumulate(
+            &new_slot, 1, MPI_INT, dst_rank, 1 + tile_idx,
+            1, MPI_INT, MPI_REPLACE, gtbs->map_win
+        );
+        MPI_Win_flush(dst_rank, gtbs->map_win);
+        if (new_slot == GTM_BS_ZERO_TILE) return GTM_TILE_POOL_FULL;
+        *slot = new_slot;
+        return GTM_SUCCESS;
+    }
+}
+
+// Get or update (put, accumulate) a block in the block-sparse matrix
+// Input parameters:
+//   gtbs       : GTM_Blk_Sparse handle
+//   op         : MPI_NO_OP (get), MPI_REPLACE (put) or MPI_SUM (accumulate)
+//   row_start  : 1st row of the block
+//   row_num    : Number of rows the block has
+//   col_start  : 1st column of the block
+//   col_num    : Number of columns the block has
+//   *src_buf   : Receive buffer (get) or source buffer (update)
+//   src_buf_ld : Leading dimension of src_buf
+static int GTM_BS_accessBlock(
+    GTM_Blk_Sparse_t gtbs, MPI_Op op, int row_start, int row_num,
+    int col_start, int col_num, void *src_buf, int src_buf_ld
+)
+{
+    if (gtbs == NULL) return GTM_NULL_PTR;
+    if (src_buf_ld < col_num) return GTM_INVALID_SRC_LD;
+    if ((row_start < 0) || (col_start < 0) ||
+        (row_start + row_num > gtbs->nrows) ||
+        (col_start + col_num > gtbs->ncols) ||
+        (row_num * col_num == 0)) return GTM_INVALID_BLOCK;
+
+    int row_end = row_start + row_num - 1;
+    int col_end = col_start + col_num - 1;
+    int s_blk_r = GTM_findBlockIndex(gtbs->r_displs, gtbs->r_blocks, row_start);
+    int e_blk_r = GTM_findBlockIndex(gtbs->r_displs, gtbs->r_blocks, row_end);
+    int s_blk_c = GTM_findBlockIndex(gtbs->c_displs, gtbs->c_blocks, col_start);
+    int e_blk_c = GTM_findBlockIndex(gtbs->c_displs, gtbs->c_blocks, col_end);
+
+    int tile_dim  = gtbs->tile_dim;
+    int unit_size = gtbs->unit_size;
+    int ret = GTM_SUCCESS;
+    for (int blk_r = s_blk_r; blk_r <= e_blk_r; blk_r++)      // Notice: <=
+    {
+        for (int blk_c = s_blk_c; blk_c <= e_blk_c; blk_c++)  // Notice: <=
+        {
+            int dst_rank  = blk_r * gtbs->c_blocks + blk_c;
+            int dst_r_s   = gtbs->r_displs[blk_r];
+            int dst_c_s   = gtbs->c_displs[blk_c];
+            int dst_tcols = (gtbs->c_blklens[blk_c] + tile_dim - 1) / tile_dim;
+
+            // Intersection of the block and the process block, in local index
+            int l_r_s = MAX(row_start, dst_r_s) - dst_r_s;
+            int l_r_e = MIN(row_end,   gtbs->r_displs[blk_r + 1] - 1) - dst_r_s;
+            int l_c_s = MAX(col_start, dst_c_s) - dst_c_s;
+            int l_c_e = MIN(col_end,   gtbs->c_displs[blk_c + 1] - 1) - dst_c_s;
+            int tr_s  = l_r_s / tile_dim, tr_e = l_r_e / tile_dim;
+            int tc_s  = l_c_s / tile_dim, tc_e = l_c_e / tile_dim;
+            int ntc   = tc_e - tc_s + 1;
+
+            MPI_Win_lock(MPI_LOCK_SHARED, dst_rank, 0, gtbs->map_win);
+            MPI_Win_lock(MPI_LOCK_SHARED, dst_rank, 0, gtbs->pool_win);
+            ret = GTM_BS_fetchTileMap(gtbs, dst_rank, tr_s, tr_e, tc_s, tc_e);
+
+            for (int tr = tr_s; tr <= tr_e; tr++)
+            {
+                if (ret != GTM_SUCCESS) break;
+                int t_r_s = MAX(l_r_s, tr * tile_dim);
+                int t_r_e = MIN(l_r_e, tr * tile_dim + tile_dim - 1);
+                int t_nrow = t_r_e - t_r_s + 1;
+                for (int tc = tc_s; tc <= tc_e; tc++)
+                {
+                    int t_c_s = MAX(l_c_s, tc * tile_dim);
+                    int t_c_e = MIN(l_c_e, tc * tile_dim + tile_dim - 1);
+                    int t_ncol = t_c_e - t_c_s + 1;
+                    int slot   = gtbs->map_buf[(tr - tr_s) * ntc + (tc - tc_s)];
+
+                    size_t buf_offset = (size_t) (t_r_s + dst_r_s - row_start) * (size_t) src_buf_ld;
+                    buf_offset += (size_t) (t_c_s + dst_c_s - col_start);
+                    char *buf_ptr = (char*) src_buf + buf_offset * unit_size;
+
+                    if (op == MPI_NO_OP)
+                    {
+                        if (slot < 0)
+                        {
+                            for (int irow = 0; irow < t_nrow; irow++)
+                                memset(buf_ptr + irow * src_buf_ld * unit_size, 0, t_ncol * unit_size);
+                        } else {
+                            GTM_BS_getFromTile(
+                                gtbs, dst_rank, slot, t_r_s - tr * tile_dim, t_c_s - tc * tile_dim,
+                                t_nrow, t_ncol, buf_ptr, src_buf_ld
+                            );
+                        }
+                        continue;
+                    }
+
+                    // Nothing to do if accumulating a zero tile or putting
+                    // a zero tile to a zero tile
+                    if ((op == MPI_SUM || slot < 0) &&
+                        isZeroMatrixBlock(buf_ptr, src_buf_ld * unit_size, t_nrow, t_ncol * unit_size)) continue;
+
+                    if (slot < 0)
+                    {
+                        ret = GTM_BS_allocTile(gtbs, dst_rank, tr * dst_tcols + tc, &slot);
+                        if (ret != GTM_SUCCESS) break;
+                    }
+                    GTM_BS_updateToTile(
+                        gtbs, dst_rank, op, slot, t_r_s - tr * tile_dim, t_c_s - tc * tile_dim,
+                        t_nrow, t_ncol, buf_ptr, src_buf_ld
+                    );
+                }
+            }
+
+            MPI_Win_unlock(dst_rank, gtbs->pool_win);
+            MPI_Win_unlock(dst_rank, gtbs->map_win);
+            if (ret != GTM_SUCCESS) return ret;
+        }
+    }
+    return GTM_SUCCESS;
+}
+
+int GTM_getBlkSparseBlock(
+    GTM_Blk_Sparse_t gtbs, int row_start, int row_num,
+    int col_start, int col_num, void *src_buf, int src_buf_ld
+)
+{
+    return GTM_BS_accessBlock(
+        gtbs, MPI_NO_OP, row_start, row_num,
+        col_start, col_num, src_buf, src_buf_ld
+    );
+}
+
+int GTM_putBlkSparseBlock(
+    GTM_Blk_Sparse_t gtbs, int row_start, int row_num,
+    int col_start, int col_num, void *src_buf, int src_buf_ld
+)
+{
+    return GTM_BS_accessBlock(
+        gtbs, MPI_REPLACE, row_start, row_num,
+        col_start, col_num, src_buf, src_buf_ld
+    );
+}
+
+int GTM_accBlkSparseBlock(
+    GTM_Blk_Sparse_t gtbs, int row_start, int row_num,
+    int col_start, int col_num, void *src_buf, int src_buf_ld
+)
+{
+    return GTM_BS_accessBlock(
+        gtbs, MPI_SUM, row_start, row_num,
+        col_start, col_num, src_buf, src_buf_ld
+    );
+}
@@ -0,0 +1,105 @@
+#ifndef __GTM_BLK_SPARSE_H__
+#define __GTM_BLK_SPARSE_H__
+
+#include <mpi.h>
+
+// Block-sparse distributed matrix, same 2D checkerboard partition as GTMatrix.
+// Each process's matrix block is split into tile_dim * tile_dim tiles (edge
+// tiles can be smaller). Only non-zero tiles have storage: a tile occupancy
+// map records which slot of the process's tile pool holds each tile, zero
+// tiles are marked as -1 and are never transferred.
+struct GTM_Blk_Sparse
+{
+    // MPI components
+    MPI_Comm mpi_comm;           // Target communicator
+    MPI_Win  map_win, pool_win;  // MPI windows for tile occupancy map and tile pool
+    MPI_Datatype datatype;       // Matrix data type
+
+    // Matrix size and partition, same as GTMatrix
+    int nrows, ncols;            // Matrix size
+    int r_blocks,  c_blocks;     // Number of blocks on row and column directions, r_blocks * c_blocks == comm_size
+    int my_rowblk, my_colblk;    // Which row & column block this process is
+    int my_nrows,  my_ncols;     // How many row & column local block has
+    int *r_displs, *r_blklens;   // Displacements and length of each block on row direction
+    int *c_displs, *c_blklens;   // Displacements and length of each block on column direction
+    int unit_size;               // Size of matrix data type, unit is byte
+    int my_rank, comm_size;      // Rank of this process and number of process in the global communicator
+
+    // Tiles
+    int tile_dim;                // Tile size on both directions
+    int tile_msize;              // Size of a tile slot in the pool, unit is byte
+    int my_tile_rows;            // Number of tile rows in local block
+    int my_tile_cols;            // Number of tile columns in local block
+    int pool_size;               // Number of tile slots in each process's tile pool
+    int *tile_map;               // tile_map[0] is the number of used pool slots, tile_map[1 + i]
+                                 // is the pool slot of i-th local tile (row-major), < 0 == zero tile
+    void *tile_pool;             // Local tile pool, each slot is a row-major tile with ld == tile_dim
+    int *map_buf;                // Buffer for fetching remote tile occupancy map
+    int map_buf_size;            // Number of ints map_buf can hold
+};
+
+typedef struct GTM_Blk_Sparse* GTM_Blk_Sparse_t;
+
+#define GTM_BS_ZERO_TILE     -1
+#define GTM_BS_ALLOC_TILE    -2  // A process is allocating a pool slot for this tile
+#define GTM_BS_DEFAULT_TILE  64
+
+// Create and initialize a GTM_Blk_Sparse structure, all tiles are zero tiles
+// This call is collective, thread-safe
+// Input parameters:
+//   comm      : MPI communicator used in this distributed matrix
+//   datatype  : Matrix data type
+//   unit_size : Size of matrix data type, unit is byte
+//   my_rank   : MPI Rank of this process
+//   nrows     : Number of rows in matrix
+//   ncols     : Number of columns in matrix
+//   r_blocks  : Number of blocks on row direction
+//   c_blocks  : Number of blocks on column direction
+//   *r_displs : Row direction displacement array, nrows+1 elements
+//   *c_displs : Column direction displacement array, ncols+1 elements
+//   tile_dim  : Tile size, <= 0 means using GTM_BS_DEFAULT_TILE
+//   pool_size : Number of non-zero tiles each process can hold, <= 0 means
+//               the number of tiles in the largest local block (no saving)
+// Output parameter:
+//   *_gtbs : Pointer to the created GTM_Blk_Sparse structure
+int GTM_createBlkSparse(
+    GTM_Blk_Sparse_t *_gtbs, MPI_Comm comm, MPI_Datatype datatype,
+    int unit_size, int my_rank, int nrows, int ncols,
+    int r_blocks, int c_blocks, int *r_displs, int *c_displs,
+    int tile_dim, int pool_size
+);
+
+// Free a GTM_Blk_Sparse structure
+// This call is collective, thread-safe
+int GTM_destroyBlkSparse(GTM_Blk_Sparse_t gtbs);
+
+// Mark all tiles as zero tiles and release all pool slots
+// This call is collective, not thread-safe
+int GTM_resetBlkSparse(GTM_Blk_Sparse_t gtbs);
+
+// Get the number of non-zero tiles stored on this process
+int GTM_getBlkSparseLocalNnzTiles(GTM_Blk_Sparse_t gtbs);
+
+// Get a block from the block-sparse matrix, zero tiles are not transferred
+// but filled locally. Parameters are the same as GTM_getBlock().
+// Blocking call, not collective, not thread-safe
+int GTM_getBlkSparseBlock(
+    GTM_Blk_Sparse_t gtbs, int row_start, int row_num,
+    int col_start, int col_num, void *src_buf, int src_buf_ld
+);
+
+// Put / accumulate a block to the block-sparse matrix. All-zero source tiles
+// are skipped, a zero tile on target process is allocated when needed.
+// Parameters are the same as GTM_putBlock() / GTM_accBlock().
+// Return GTM_TILE_POOL_FULL if the target process has no free pool slot.
+// Blocking call, not collective, not thread-safe
+int GTM_putBlkSparseBlock(
+    GTM_Blk_Sparse_t gtbs, int row_start, int row_num,
+    int col_start, int col_num, void *src_buf, int src_buf_ld
+);
+int GTM_accBlkSparseBlock(
+    GTM_Blk_Sparse_t gtbs, int row_start, int row_num,
+    int col_start, int col_num, void *src_buf, int src_buf_ld
+);
+
+#endif
@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTM_Buffer.h"
+
+// Header before each buffer, the free list link is only used when cached
+struct GTM_Buffer_Header
+{
+    int size_class;                    // Size class, -1 for a buffer not pooled
+    struct GTM_Buffer_Header *next;    // Next cached buffer of the same size class
+};
+
+static struct GTM_Buffer_Header *GTM_buf_free_list[GTM_BUF_MAX_CLASS + 1];
+static int GTM_buf_n_cached[GTM_BUF_MAX_CLASS + 1];
+static size_t GTM_buf_cached_bytes = 0;
+static int GTM_buf_keyval = MPI_KEYVAL_INVALID;
+
+// Called when MPI_COMM_SELF is freed at the beginning of MPI_Finalize()
+static int GTM_bufferPoolFinalize(MPI_Comm comm, int keyval, void *attr_val, void *extra_state)
+{
+    GTM_releaseBufferPool();
+    MPI_Comm_free_keyval(&GTM_buf_keyval);
+    return MPI_SUCCESS;
+}
+
+// Attach an attribute to MPI_COMM_SELF so that cached buffers are released at
+// the beginning of MPI_Finalize(), MPI_Free_mem() cannot be called after it
+static void GTM_initBufferPool()
+{
+    if (GTM_buf_keyval != MPI_KEYVAL_INVALID) return;
+    MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, GTM_bufferPoolFinalize, &GTM_buf_keyval, NULL);
+    MPI_Comm_set_attr(MPI_COMM_SELF, GTM_buf_keyval, NULL);
+}
+
+void *GTM_allocBuffer(size_t msize)
+{
+    GTM_initBufferPool();
+
+    // Smallest size class that holds the buffer and its header
+    size_t total = msize + GTM_BUF_HEADER_SIZE;
+    int size_class = GTM_BUF_MIN_CLASS;
+    while ((size_class <= GTM_BUF_MAX_CLASS) && (((size_t) 1 << size_class) < total)) size_class++;
+
+    struct GTM_Buffer_Header *header = NULL;
+    if (size_class > GTM_BUF_MAX_CLASS)
+    {
+        size_class = -1;
+    } else {
+        total = (size_t) 1 << size_class;
+        header = GTM_buf_free_list[size_class];
+        if (header != NULL)
+        {
+            GTM_buf_free_list[size_class] = header->next;
+            GTM_buf_n_cached[size_class]--;
+            GTM_buf_cached_bytes -= total;
+        }
+    }
+    if (header == NULL)
+    {
+        if (MPI_Alloc_mem((MPI_Aint) total, MPI_INFO_NULL, &header) != MPI_SUCCESS) return NULL;
+        if (header == NULL) return NULL;
+    }
+    header->size_class = size_class;
+    header->next = NULL;
+    return (void*) ((char*) header + GTM_BUF_HEADER_SIZE);
+}
+
+void GTM_freeBuffer(void *buf)
+{
+    if (buf == NULL) return;
+    struct GTM_Buffer_Header *header = (struct GTM_Buffer_Header*) ((char*) buf - GTM_BUF_HEADER_SIZE);
+    int size_class = header->size_class;
+    if ((size_class < 0) || (GTM_buf_n_cached[size_class] >= GTM_BUF_MAX_CACHED) ||
+        (GTM_buf_cached_bytes + ((size_t) 1 << size_class) > GTM_BUF_MAX_CACHED_BYTES))
+    {
+        MPI_Free_mem(header);
+        return;
+    }
+    header->next = GTM_buf_free_list[size_class];
+    GTM_buf_free_list[size_class] = header;
+    GTM_buf_n_cached[size_class]++;
+    GTM_buf_cached_bytes += (size_t) 1 << size_class;
+}
+
+void GTM_releaseBufferPool()
+{
+    for (int i = GTM_BUF_MIN_CLASS; i <= GTM_BUF_MAX_CLASS; i++)
+    {
+        while (GTM_buf_free_list[i] != NULL)
+        {
+            struct GTM_Buffer_Header *header = GTM_buf_free_list[i];
+            GTM_buf_free_list[i] = header->next;
+            MPI_Free_mem(header);
+        }
+        GTM_buf_n_cached[i] = 0;
+    }
+    GTM_buf_cached_bytes = 0;
+}
@@ -0,0 +1,38 @@
+#ifndef __GTM_BUFFER_H__
+#define __GTM_BUFFER_H__
+
+#include <stddef.h>
+
+// Communication buffer allocator. Buffers are allocated with MPI_Alloc_mem,
+// so the MPI library can register them for RDMA once instead of registering
+// or copying a malloc buffer in each RMA operation. Freed buffers are kept in
+// a per-process pool with power-of-2 size classes and reused by later
+// allocations of the same class. Buffers larger than the largest class are
+// not pooled, and a freed buffer is released instead of cached if the pool 
+// would hold more than GTM_BUF_MAX_CACHED_BYTES bytes. Cached buffers are 
+// released in MPI_Finalize().
+// GTMatrix allocates its short-lived internal communication temporaries from
+// this pool, only in functions that are not thread-safe. Temporaries of 
+// thread-safe functions (e.g. symmetric storage pieces in GTM_getBlock()) are
+// allocated with MPI_Alloc_mem directly. Long-lived buffers 
+// (e.g. buffers owned by a GTMatrix or a halo) are allocated with MPI_Alloc_mem
+// directly: the power-of-2 classes would waste up to half of their size and 
+// the pool would keep them after they are freed.
+// MPI must be initialized. All functions are not collective, not thread-safe.
+
+#define GTM_BUF_MIN_CLASS   8   // Smallest size class, 2^8 bytes including the header
+#define GTM_BUF_MAX_CLASS   30  // Largest pooled size class, 2^30 bytes including the header
+#define GTM_BUF_MAX_CACHED  8   // Maximum number of cached free buffers in each size class
+#define GTM_BUF_MAX_CACHED_BYTES  ((size_t) 1 << 28)  // Maximum total size of cached free buffers
+#define GTM_BUF_HEADER_SIZE 64  // Size of the header before each buffer, keeps 64-byte offset alignment
+
+// Allocate a communication buffer of msize bytes, return NULL if failed
+void *GTM_allocBuffer(size_t msize);
+
+// Free a buffer allocated by GTM_allocBuffer(), buf can be NULL
+void GTM_freeBuffer(void *buf);
+
+// Release all cached free buffers in the pool
+void GTM_releaseBufferPool();
+
+#endif
@@ -0,0 +1,525 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <mpi.h>
+
+#include "GTMatrix_Retval.h"
+#include "GTMatrix_Typedef.h"
+#include "GTMatrix_Get.h"
+#include "GTMatrix_Update.h"
+#include "GTMatrix_Other.h"
+#include "GTM_CSR.h"
+#include "GTM_Buffer.h"
+#include "utils.h"
+
+// Expose the local CSR arrays in MPI windows
+static void GTM_createCSRWins(GTM_CSR_t csr)
+{
+    MPI_Info mpi_info;
+    MPI_Info_create(&mpi_info);
+    MPI_Aint rp_msize  = (MPI_Aint) sizeof(int)    * (MPI_Aint) (csr->my_nrows + 1);
+    MPI_Aint ci_msize  = (MPI_Aint) sizeof(int)    * (MPI_Aint) csr->nnz;
+    MPI_Aint val_msize = (MPI_Aint) sizeof(double) * (MPI_Aint) csr->nnz;
+    MPI_Win_create(csr->row_ptr, rp_msize,  sizeof(int),    mpi_info, csr->mpi_comm, &csr->rp_win);
+    MPI_Win_create(csr->col_idx, ci_msize,  sizeof(int),    mpi_info, csr->mpi_comm, &csr->ci_win);
+    MPI_Win_create(csr->val,     val_msize, sizeof(double), mpi_info, csr->mpi_comm, &csr->val_win);
+    MPI_Info_free(&mpi_info);
+}
+
+static void GTM_freeCSRWins(GTM_CSR_t csr)
+{
+    MPI_Win_free(&csr->rp_win);
+    MPI_Win_free(&csr->ci_win);
+    MPI_Win_free(&csr->val_win);
+}
+
+int GTM_createCSR(
+    GTM_CSR_t *_csr, MPI_Comm comm, int my_rank, int nrows, int ncols,
+    int r_blocks, int c_blocks, int *r_displs, int *c_displs
+)
+{
+    // Validate process info before allocating anything
+    int comm_size;
+    MPI_Comm_size(comm, &comm_size);
+    if ((my_rank < 0) || (my_rank >= comm_size)) return GTM_INVALID_RANK;
+    if (r_blocks * c_blocks != comm_size) return GTM_INVALID_RCBLOCK;
+
+    GTM_CSR_t csr = (GTM_CSR_t) malloc(sizeof(struct GTM_CSR));
+    if (csr == NULL) return GTM_ALLOC_FAILED;
+
+    // Copy matrix and process info
+    MPI_Comm_dup(comm, &csr->mpi_comm);
+    csr->my_rank   = my_rank;
+    csr->comm_size = comm_size;
+    csr->nrows     = nrows;
+    csr->ncols     = ncols;
+    csr->r_blocks  = r_blocks;
+    csr->c_blocks  = c_blocks;
+    csr->my_rowblk = my_rank / c_blocks;
+    csr->my_colblk = my_rank % c_blocks;
+
+    // Copy and validate the partition, generate r_blklens and c_blklens
+    int ret = GTM_copyPartition(
+        nrows, ncols, r_blocks, c_blocks, r_displs, c_displs,
+        &csr->r_displs, &csr->r_blklens, &csr->c_displs, &csr->c_blklens
+    );
+    if (ret != GTM_SUCCESS)
+    {
+        MPI_Comm_free(&csr->mpi_comm);
+        free(csr);
+        return ret;
+    }
+    csr->my_nrows = csr->r_blklens[csr->my_rowblk];
+    csr->my_ncols = csr->c_blklens[csr->my_colblk];
+
+    // Empty local CSR block, col_idx and val always have at least one element
+    csr->nnz     = 0;
+    csr->row_ptr = (int*)    calloc(csr->my_nrows + 1, sizeof(int));
+    csr->col_idx = (int*)    malloc(sizeof(int));
+    csr->val     = (double*) malloc(sizeof(double));
+
+    // Staging structure
+    csr->n_stage   = 0;
+    csr->stage_cap = GTM_CSR_INIT_STAGE;
+    csr->hash_cap  = GTM_CSR_INIT_STAGE * 2;
+    csr->stage_rc  = (int*)    malloc(sizeof(int)    * 2 * csr->stage_cap);
+    csr->stage_val = (double*) malloc(sizeof(double) * csr->stage_cap);
+    csr->hash_tab  = (int*)    malloc(sizeof(int)    * csr->hash_cap);
+    if ((csr->row_ptr  == NULL) || (csr->col_idx   == NULL) || (csr->val      == NULL) ||
+        (csr->stage_rc == NULL) || (csr->stage_val == NULL) || (csr->hash_tab == NULL))
+    {
+        return GTM_ALLOC_FAILED;
+    }
+    for (int i = 0; i < csr->hash_cap; i++) csr->hash_tab[i] = -1;
+
+    GTM_createCSRWins(csr);
+
+    *_csr = csr;
+    return GTM_SUCCESS;
+}
+
+int GTM_destroyCSR(GTM_CSR_t csr)
+{
+    if (csr == NULL) return GTM_NULL_PTR;
+
+    GTM_freeCSRWins(csr);
+    MPI_Comm_free(&csr->mpi_comm);
+
+    free(csr->r_displs);
+    free(csr->r_blklens);
+    free(csr->c_displs);
+    free(csr->c_blklens);
+    free(csr->row_ptr);
+    free(csr->col_idx);
+    free(csr->val);
+    free(csr->stage_rc);
+    free(csr->stage_val);
+    free(csr->hash_tab);
+    free(csr);
+
+    return GTM_SUCCESS;
+}
+
+// Hash slot of (row, col) in a table with hash_cap slots
+static int GTM_CSRHash(int row, int col, int hash_cap)
+{
+    uint64_t key = ((uint64_t) (uint32_t) row << 32) | (uint64_t) (uint32_t) col;
+    key *= 0x9E3779B97F4A7C15ULL;
+    return (int) ((key >> 32) & (uint64_t) (hash_cap - 1));
+}
+
+// Find the slot of (row, col), or the empty slot where it should be inserted
+static int GTM_CSRFindSlot(GTM_CSR_t csr, int row, int col)
+{
+    int slot = GTM_CSRHash(row, col, csr->hash_cap);
+    while (1)
+    {
+        int idx = csr->hash_tab[slot];
+        if (idx == -1) return slot;
+        if ((csr->stage_rc[2 * idx] == row) && (csr->stage_rc[2 * idx + 1] == col)) return slot;
+        slot = (slot + 1) & (csr->hash_cap - 1);
+    }
+}
+
+// Double the capacity of the staged entry arrays and the hash table
+static int GTM_growCSRStage(GTM_CSR_t csr)
+{
+    int new_cap = csr->stage_cap * 2;
+    int *new_rc = (int*) realloc(csr->stage_rc, sizeof(int) * 2 * new_cap);
+    if (new_rc == NULL) return GTM_ALLOC_FAILED;
+    csr->stage_rc = new_rc;
+    double *new_val = (double*) realloc(csr->stage_val, sizeof(double) * new_cap);
+    if (new_val == NULL) return GTM_ALLOC_FAILED;
+    csr->stage_val = new_val;
+    int *new_tab = (int*) malloc(sizeof(int) * 2 * new_cap);
+    if (new_tab == NULL) return GTM_ALLOC_FAILED;
+    free(csr->hash_tab);
+    csr->stage_cap = new_cap;
+    csr->hash_cap  = 2 * new_cap;
+    csr->hash_tab  = new_tab;
+    for (int i = 0; i < csr->hash_cap; i++) csr->hash_tab[i] = -1;
+    for (int idx = 0; idx < csr->n_stage; idx++)
+    {
+        int slot = GTM_CSRFindSlot(csr, csr->stage_rc[2 * idx], csr->stage_rc[2 * idx + 1]);
+        csr->hash_tab[slot] = idx;
+    }
+    return GTM_SUCCESS;
+}
+
+int GTM_addCSRAccEntries(GTM_CSR_t csr, int n, const int *rows, const int *cols, const double *vals)
+{
+    if (csr == NULL) return GTM_NULL_PTR;
+    if ((n > 0) && ((rows == NULL) || (cols == NULL) || (vals == NULL))) return GTM_NULL_PTR;
+    for (int i = 0; i < n; i++)
+    {
+        if ((rows[i] < 0) || (rows[i] >= csr->nrows)) return GTM_INVALID_BLOCK;
+        if ((cols[i] < 0) || (cols[i] >= csr->ncols)) return GTM_INVALID_BLOCK;
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        int slot = GTM_CSRFindSlot(csr, rows[i], cols[i]);
+        int idx  = csr->hash_tab[slot];
+        if (idx >= 0)
+        {
+            csr->stage_val[idx] += vals[i];
+            continue;
+        }
+        if (csr->n_stage == csr->stage_cap)
+        {
+            if (GTM_growCSRStage(csr) != GTM_SUCCESS) return GTM_ALLOC_FAILED;
+            slot = GTM_CSRFindSlot(csr, rows[i], cols[i]);
+        }
+        idx = csr->n_stage++;
+        csr->stage_rc[2 * idx]     = rows[i];
+        csr->stage_rc[2 * idx + 1] = cols[i];
+        csr->stage_val[idx]        = vals[i];
+        csr->hash_tab[slot]        = idx;
+    }
+    return GTM_SUCCESS;
+}
+
+// Entry of the local block used for compaction
+typedef struct
+{
+    int row, col;
+    double val;
+} GTM_CSR_Entry;
+
+static int GTM_cmpCSREntry(const void *a, const void *b)
+{
+    const GTM_CSR_Entry *ea = (const GTM_CSR_Entry*) a;
+    const GTM_CSR_Entry *eb = (const GTM_CSR_Entry*) b;
+    if (ea->row != eb->row) return (ea->row < eb->row) ? -1 : 1;
+    if (ea->col != eb->col) return (ea->col < eb->col) ? -1 : 1;
+    return 0;
+}
+
+// All processes agree on whether their allocations succeeded, so a process that
+// fails does not leave the others waiting in the next collective operation
+static int GTM_agreeCSRAlloc(GTM_CSR_t csr, int alloc_ok)
+{
+    int all_ok;
+    MPI_Allreduce(&alloc_ok, &all_ok, 1, MPI_INT, MPI_MIN, csr->mpi_comm);
+    return all_ok ? GTM_SUCCESS : GTM_ALLOC_FAILED;
+}
+
+int GTM_syncCSR(GTM_CSR_t csr)
+{
+    if (csr == NULL) return GTM_NULL_PTR;
+
+    int nproc = csr->comm_size;
+    int *send_cnt    = (int*) calloc(nproc, sizeof(int));
+    int *send_displs = (int*) malloc(sizeof(int) * (nproc + 1));
+    int *recv_cnt    = (int*) malloc(sizeof(int) * nproc);
+    int *recv_displs = (int*) malloc(sizeof(int) * (nproc + 1));
+    int *owner       = (int*) malloc(sizeof(int) * MAX(csr->n_stage, 1));
+    int *send_rc     = (int*)    malloc(sizeof(int)    * 2 * MAX(csr->n_stage, 1));
+    double *send_val = (double*) malloc(sizeof(double) * MAX(csr->n_stage, 1));
+    int *recv_rc = NULL, *new_col_idx = NULL;
+    double *recv_val = NULL, *new_val = NULL;
+    GTM_CSR_Entry *ents = NULL;
+    int ret = GTM_agreeCSRAlloc(
+        csr, (send_cnt != NULL) && (send_displs != NULL) && (recv_cnt != NULL) &&
+        (recv_displs != NULL) && (owner != NULL) && (send_rc != NULL) && (send_val != NULL)
+    );
+
+    // Group staged entries by owner and exchange them, (row, col) pairs are sent as 2 ints
+    int n_recv = 0;
+    if (ret == GTM_SUCCESS)
+    {
+        for (int idx = 0; idx < csr->n_stage; idx++)
+        {
+            int rowblk = GTM_findBlockIndex(csr->r_displs, csr->r_blocks, csr->stage_rc[2 * idx]);
+            int colblk = GTM_findBlockIndex(csr->c_displs, csr->c_blocks, csr->stage_rc[2 * idx + 1]);
+            owner[idx] = rowblk * csr->c_blocks + colblk;
+            send_cnt[owner[idx]]++;
+        }
+        send_displs[0] = 0;
+        for (int r = 0; r < nproc; r++) send_displs[r + 1] = send_displs[r] + send_cnt[r];
+        memcpy(recv_displs, send_displs, sizeof(int) * nproc);
+        for (int idx = 0; idx < csr->n_stage; idx++)
+        {
+            int pos = recv_displs[owner[idx]]++;
+            send_rc[2 * pos]     = csr->stage_rc[2 * idx];
+            send_rc[2 * pos + 1] = csr->stage_rc[2 * idx + 1];
+            send_val[pos]        = csr->stage_val[idx];
+        }
+
+        MPI_Alltoall(send_cnt, 1, MPI_INT, recv_cnt, 1, MPI_INT, csr->mpi_comm);
+        recv_displs[0] = 0;
+        for (int r = 0; r < nproc; r++) recv_displs[r + 1] = recv_displs[r] + recv_cnt[r];
+        n_recv   = recv_displs[nproc];
+        recv_rc  = (int*)    malloc(sizeof(int)    * 2 * MAX(n_recv, 1));
+        recv_val = (double*) malloc(sizeof(double) * MAX(n_recv, 1));
+        ents     = (GTM_CSR_Entry*) malloc(sizeof(GTM_CSR_Entry) * MAX(csr->nnz + n_recv, 1));
+        ret = GTM_agreeCSRAlloc(csr, (recv_rc != NULL) && (recv_val != NULL) && (ents != NULL));
+    }
+
+    // Compact the existing non-zeros and the received entries: sort by (row, col)
+    // and combine duplicates
+    int nnz = 0;
+    if (ret == GTM_SUCCESS)
+    {
+        MPI_Alltoallv(send_val, send_cnt, send_displs, MPI_DOUBLE, recv_val, recv_cnt, recv_displs, MPI_DOUBLE, csr->mpi_comm);
+        for (int r = 0; r <= nproc; r++)
+        {
+            if (r < nproc)
+            {
+                send_cnt[r] *= 2;
+                recv_cnt[r] *= 2;
+            }
+            send_displs[r] *= 2;
+            recv_displs[r] *= 2;
+        }
+        MPI_Alltoallv(send_rc, send_cnt, send_displs, MPI_INT, recv_rc, recv_cnt, recv_displs, MPI_INT, csr->mpi_comm);
+
+        int row_s = csr->r_displs[csr->my_rowblk], n_ent = 0;
+        for (int i = 0; i < csr->my_nrows; i++)
+        {
+            for (int j = csr->row_ptr[i]; j < csr->row_ptr[i + 1]; j++)
+            {
+                ents[n_ent].row = i;
+                ents[n_ent].col = csr->col_idx[j];
+                ents[n_ent].val = csr->val[j];
+                n_ent++;
+            }
+        }
+        for (int i = 0; i < n_recv; i++)
+        {
+            ents[n_ent].row = recv_rc[2 * i] - row_s;
+            ents[n_ent].col = recv_rc[2 * i + 1];
+            ents[n_ent].val = recv_val[i];
+            n_ent++;
+        }
+        qsort(ents, n_ent, sizeof(GTM_CSR_Entry), GTM_cmpCSREntry);
+        for (int i = 0; i < n_ent; i++)
+        {
+            if ((nnz > 0) && (ents[nnz - 1].row == ents[i].row) && (ents[nnz - 1].col == ents[i].col))
+                ents[nnz - 1].val += ents[i].val;
+            else
+                ents[nnz++] = ents[i];
+        }
+        new_col_idx = (int*)    malloc(sizeof(int)    * MAX(nnz, 1));
+        new_val     = (double*) malloc(sizeof(double) * MAX(nnz, 1));
+        ret = GTM_agreeCSRAlloc(csr, (new_col_idx != NULL) && (new_val != NULL));
+    }
+
+    // Replace the local CSR block, windows are created again with the new arrays
+    if (ret == GTM_SUCCESS)
+    {
+        GTM_freeCSRWins(csr);
+        free(csr->col_idx);
+        free(csr->val);
+        csr->nnz     = nnz;
+        csr->col_idx = new_col_idx;
+        csr->val     = new_val;
+        new_col_idx  = NULL;
+        new_val      = NULL;
+        memset(csr->row_ptr, 0, sizeof(int) * (csr->my_nrows + 1));
+        for (int i = 0; i < nnz; i++)
+        {
+            csr->row_ptr[ents[i].row + 1]++;
+            csr->col_idx[i] = ents[i].col;
+            csr->val[i]     = ents[i].val;
+        }
+        for (int i = 0; i < csr->my_nrows; i++) csr->row_ptr[i + 1] += csr->row_ptr[i];
+        GTM_createCSRWins(csr);
+
+        // Clear the staging structure
+        csr->n_stage = 0;
+        for (int i = 0; i < csr->hash_cap; i++) csr->hash_tab[i] = -1;
+    }
+
+    free(send_cnt);
+    free(send_displs);
+    free(recv_cnt);
+    free(recv_displs);
+    free(owner);
+    free(send_rc);
+    free(send_val);
+    free(recv_rc);
+    free(recv_val);
+    free(ents);
+    free(new_col_idx);
+    free(new_val);
+    return ret;
+}
+
+int GTM_getCSRRows(
+    GTM_CSR_t csr, int row_start, int row_num, int max_nnz,
+    int *row_ptr, int *col_idx, double *val
+)
+{
+    if ((csr == NULL) || (row_ptr == NULL)) return GTM_NULL_PTR;
+    if ((max_nnz > 0) && ((col_idx == NULL) || (val == NULL))) return GTM_NULL_PTR;
+    if ((row_start < 0) || (row_num < 0) || (row_start + row_num > csr->nrows)) return GTM_INVALID_BLOCK;
+
+    // beg[cb * row_num + i] and cnt[...]: position and number of non-zeros of
+    // row row_start + i in column block cb on its owner
+    int c_blocks = csr->c_blocks;
+    int *beg = (int*) malloc(sizeof(int) * MAX(c_blocks * row_num, 1));
+    int *cnt = (int*) malloc(sizeof(int) * MAX(c_blocks * row_num, 1));
+    int *rp  = (int*) malloc(sizeof(int) * (row_num + 1));
+    if ((beg == NULL) || (cnt == NULL) || (rp == NULL))
+    {
+        free(beg);
+        free(cnt);
+        free(rp);
+        return GTM_ALLOC_FAILED;
+    }
+
+    // Row pointers of each row block segment on each column block
+    int row_end = row_start + row_num;
+    for (int g = row_start; g < row_end; )
+    {
+        int rb  = GTM_findBlockIndex(csr->r_displs, csr->r_blocks, g);
+        int nr  = MIN(row_end, csr->r_displs[rb + 1]) - g;
+        int lr0 = g - csr->r_displs[rb];
+        int i0  = g - row_start;
+        for (int cb = 0; cb < c_blocks; cb++)
+        {
+            int dst_rank = rb * c_blocks + cb;
+            MPI_Win_lock(MPI_LOCK_SHARED, dst_rank, 0, csr->rp_win);
+            MPI_Get(rp, nr + 1, MPI_INT, dst_rank, lr0, nr + 1, MPI_INT, csr->rp_win);
+            MPI_Win_unlock(dst_rank, csr->rp_win);
+            for (int i = 0; i < nr; i++)
+            {
+                beg[cb * row_num + i0 + i] = rp[i];
+                cnt[cb * row_num + i0 + i] = rp[i + 1] - rp[i];
+            }
+        }
+        g += nr;
+    }
+    row_ptr[0] = 0;
+    for (int i = 0; i < row_num; i++)
+    {
+        row_ptr[i + 1] = row_ptr[i];
+        for (int cb = 0; cb < c_blocks; cb++) row_ptr[i + 1] += cnt[cb * row_num + i];
+    }
+    if (row_ptr[row_num] > max_nnz)
+    {
+        free(beg);
+        free(cnt);
+        free(rp);
+        return GTM_SUCCESS;
+    }
+
+    // Get the non-zeros of each segment, column blocks are in ascending order
+    // so the column indices of each row are sorted
+    memcpy(rp, row_ptr, sizeof(int) * row_num);
+    for (int g = row_start; g < row_end; )
+    {
+        int rb = GTM_findBlockIndex(csr->r_displs, csr->r_blocks, g);
+        int nr = MIN(row_end, csr->r_displs[rb + 1]) - g;
+        int i0 = g - row_start;
+        for (int cb = 0; cb < c_blocks; cb++)
+        {
+            int dst_rank = rb * c_blocks + cb;
+            int *seg_beg = beg + cb * row_num + i0;
+            int *seg_cnt = cnt + cb * row_num + i0;
+            int seg_nnz  = seg_beg[nr - 1] + seg_cnt[nr - 1] - seg_beg[0];
+            if (seg_nnz == 0) continue;
+            MPI_Win_lock(MPI_LOCK_SHARED, dst_rank, 0, csr->ci_win);
+            MPI_Win_lock(MPI_LOCK_SHARED, dst_rank, 0, csr->val_win);
+            for (int i = 0; i < nr; i++)
+            {
+                if (seg_cnt[i] == 0) continue;
+                MPI_Get(col_idx + rp[i0 + i], seg_cnt[i], MPI_INT,    dst_rank, seg_beg[i], seg_cnt[i], MPI_INT,    csr->ci_win);
+                MPI_Get(val     + rp[i0 + i], seg_cnt[i], MPI_DOUBLE, dst_rank, seg_beg[i], seg_cnt[i], MPI_DOUBLE, csr->val_win);
+                rp[i0 + i] += seg_cnt[i];
+            }
+            MPI_Win_unlock(dst_rank, csr->ci_win);
+            MPI_Win_unlock(dst_rank, csr->val_win);
+        }
+        g += nr;
+    }
+
+    free(beg);
+    free(cnt);
+    free(rp);
+    return GTM_SUCCESS;
+}
+
+int GTM_CSRSpMM(GTM_CSR_t csr, double alpha, GTMatrix_t B, GTMatrix_t C)
+{
+    if ((csr == NULL) || (B == NULL) || (C == NULL)) return GTM_NULL_PTR;
+    if ((B->datatype != MPI_DOUBLE) || (C->datatype != MPI_DOUBLE)) return GTM_INVALID_FLAGS;
+    if ((B->nrows != csr->ncols) || (C->nrows != csr->nrows) || (B->ncols != C->ncols)) return GTM_INVALID_BLOCK;
+
+    // Rows of B used by the non-zeros of the local block
+    int k = B->ncols, col_min = csr->ncols, col_max = -1;
+    for (int j = 0; j < csr->nnz; j++)
+    {
+        col_min = MIN(col_min, csr->col_idx[j]);
+        col_max = MAX(col_max, csr->col_idx[j]);
+    }
+
+    int ret = GTM_SUCCESS;
+    if (col_max >= col_min)
+    {
+        int nb_rows = col_max - col_min + 1;
+        size_t C_msize = sizeof(double) * (size_t) csr->my_nrows * (size_t) k;
+        double *B_buf  = (double*) GTM_allocBuffer(sizeof(double) * (size_t) nb_rows * (size_t) k);
+        double *C_buf  = (double*) GTM_allocBuffer(C_msize);
+        if ((B_buf == NULL) || (C_buf == NULL))
+        {
+            GTM_freeBuffer(B_buf);
+            GTM_freeBuffer(C_buf);
+            ret = GTM_ALLOC_FAILED;
+        } else {
+            memset(C_buf, 0, C_msize);
+            // Local buffers are row-major
+            int B_col_major_buf = B->col_major_buf;
+            int C_col_major_buf = C->col_major_buf;
+            B->col_major_buf = 0;
+            C->col_major_buf = 0;
+            GTM_getBlock(B, col_min, nb_rows, 0, k, B_buf, k);
+            for (int i = 0; i < csr->my_nrows; i++)
+            {
+                double *C_i = C_buf + (size_t) i * (size_t) k;
+                for (int j = csr->row_ptr[i]; j < csr->row_ptr[i + 1]; j++)
+                {
+                    double a = alpha * csr->val[j];
+                    double *B_j = B_buf + (size_t) (csr->col_idx[j] - col_min) * (size_t) k;
+                    for (int l = 0; l < k; l++) C_i[l] += a * B_j[l];
+                }
+            }
+            GTM_accBlock(C, csr->r_displs[csr->my_rowblk], csr->my_nrows, 0, k, C_buf, k);
+            B->col_major_buf = B_col_major_buf;
+            C->col_major_buf = C_col_major_buf;
+            GTM_freeBuffer(B_buf);
+            GTM_freeBuffer(C_buf);
+        }
+    }
+    GTM_sync(C);
+    return ret;
+}
+
+int GTM_CSRSpMV(GTM_CSR_t csr, double alpha, GTMatrix_t x, GTMatrix_t y)
+{
+    if ((x == NULL) || (y == NULL)) return GTM_NULL_PTR;
+    if ((x->ncols != 1) || (y->ncols != 1)) return GTM_INVALID_BLOCK;
+    return GTM_CSRSpMM(csr, alpha, x, y);
+}
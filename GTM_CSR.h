@@ -0,0 +1,116 @@
+#ifndef __GTM_CSR_H__
+#define __GTM_CSR_H__
+
+#include <mpi.h>
+#include "GTMatrix_Typedef.h"
+
+// Distributed sparse matrix in CSR format, same 2D checkerboard partition as
+// GTMatrix. Each process stores the non-zeros of its local block as a CSR
+// matrix with local row indices and global column indices, column indices of
+// each row are sorted. Data type is double.
+// Accumulations are batched: GTM_addCSRAccEntries() stages entries on the
+// calling process in a hash table that combines duplicate (row, col) entries.
+// GTM_syncCSR() sends staged entries to their owners and compacts them with
+// the existing non-zeros into new CSR arrays, which are exposed in MPI windows
+// for one-sided row range gets.
+struct GTM_CSR
+{
+    // MPI components
+    MPI_Comm mpi_comm;           // Target communicator
+    MPI_Win  rp_win, ci_win, val_win;  // MPI windows for row_ptr, col_idx and val
+
+    // Matrix size and partition, same as GTMatrix
+    int nrows, ncols;            // Matrix size
+    int r_blocks,  c_blocks;     // Number of blocks on row and column directions, r_blocks * c_blocks == comm_size
+    int my_rowblk, my_colblk;    // Which row & column block this process is
+    int my_nrows,  my_ncols;     // How many row & column local block has
+    int *r_displs, *r_blklens;   // Displacements and length of each block on row direction
+    int *c_displs, *c_blklens;   // Displacements and length of each block on column direction
+    int my_rank, comm_size;      // Rank of this process and number of process in the global communicator
+
+    // Local CSR block
+    int nnz;                     // Number of non-zeros in the local block
+    int *row_ptr;                // Size my_nrows + 1, non-zeros of local row i are [row_ptr[i], row_ptr[i + 1])
+    int *col_idx;                // Size nnz, global column indices
+    double *val;                 // Size nnz, non-zero values
+
+    // Hashed staging of batched accumulations
+    int n_stage;                 // Number of staged entries
+    int stage_cap;               // Capacity of staged entry arrays
+    int *stage_rc;               // Size 2 * stage_cap, global (row, col) of staged entries
+    double *stage_val;           // Size stage_cap, values of staged entries
+    int hash_cap;                // Size of the hash table, a power of 2
+    int *hash_tab;               // Index of the staged entry in each hash slot, -1 == empty
+};
+
+typedef struct GTM_CSR* GTM_CSR_t;
+
+#define GTM_CSR_INIT_STAGE  1024  // Initial capacity of the staging structure
+
+// Create and initialize a GTM_CSR structure, the matrix has no non-zeros
+// This call is collective, thread-safe
+// Input parameters:
+//   comm      : MPI communicator used in this distributed matrix
+//   my_rank   : MPI Rank of this process
+//   nrows     : Number of rows in matrix
+//   ncols     : Number of columns in matrix
+//   r_blocks  : Number of blocks on row direction
+//   c_blocks  : Number of blocks on column direction
+//   *r_displs : Row direction displacement array, nrows+1 elements
+//   *c_displs : Column direction displacement array, ncols+1 elements
+// Output parameter:
+//   *_csr : Pointer to the created GTM_CSR structure
+int GTM_createCSR(
+    GTM_CSR_t *_csr, MPI_Comm comm, int my_rank, int nrows, int ncols,
+    int r_blocks, int c_blocks, int *r_displs, int *c_displs
+);
+
+// Free a GTM_CSR structure
+// This call is collective, thread-safe
+int GTM_destroyCSR(GTM_CSR_t csr);
+
+// Stage entries A(rows[i], cols[i]) += vals[i] on this process, the entries
+// can be owned by any process and are applied in the next GTM_syncCSR()
+// This call is not collective, not thread-safe
+// Input parameters:
+//   n    : Number of entries
+//   rows : Size n, global row indices
+//   cols : Size n, global column indices
+//   vals : Size n, values to accumulate
+int GTM_addCSRAccEntries(GTM_CSR_t csr, int n, const int *rows, const int *cols, const double *vals);
+
+// Apply all staged entries: send them to their owners and compact them with
+// the existing non-zeros of each local block, then make the new CSR arrays
+// available for GTM_getCSRRows(). If a process fails to allocate memory, all 
+// processes return GTM_ALLOC_FAILED and keep their non-zeros and staged entries.
+// This call is collective, not thread-safe
+int GTM_syncCSR(GTM_CSR_t csr);
+
+// Get the non-zeros of rows [row_start, row_start + row_num) in CSR format
+// with global column indices, column indices of each row are sorted
+// This call is not collective, not thread-safe
+// Input parameters:
+//   row_start : 1st row to get
+//   row_num   : Number of rows to get
+//   max_nnz   : Capacity of col_idx and val
+// Output parameters:
+//   row_ptr : Size row_num + 1, row_ptr[0] == 0, row_ptr[row_num] is the number of non-zeros
+//   col_idx : Size max_nnz, not filled if row_ptr[row_num] > max_nnz, can be NULL if max_nnz == 0
+//   val     : Size max_nnz, not filled if row_ptr[row_num] > max_nnz, can be NULL if max_nnz == 0
+int GTM_getCSRRows(
+    GTM_CSR_t csr, int row_start, int row_num, int max_nnz,
+    int *row_ptr, int *col_idx, double *val
+);
+
+// C += alpha * A * B, A is the sparse matrix, B and C are double GTMatrix with
+// B->nrows == A->ncols, C->nrows == A->nrows and B->ncols == C->ncols. Each
+// process gets the rows of B its non-zero columns need and accumulates its
+// partial product to C, the result is complete when the function returns.
+// This call is collective, not thread-safe
+int GTM_CSRSpMM(GTM_CSR_t csr, double alpha, GTMatrix_t B, GTMatrix_t C);
+
+// y += alpha * A * x, x and y are double GTMatrix with a single column
+// This call is collective, not thread-safe
+int GTM_CSRSpMV(GTM_CSR_t csr, double alpha, GTMatrix_t x, GTMatrix_t y);
+
+#endif
@@ -0,0 +1,254 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix_Retval.h"
+#include "GTMatrix_Typedef.h"
+#include "GTMatrix_Get.h"
+#include "GTMatrix_Update.h"
+#include "GTMatrix_Other.h"
+#include "GTM_Task_Queue.h"
+#include "GTM_Buffer.h"
+#include "GTM_Tile_Kernels.h"
+#include "GTM_Cholesky.h"
+#include "utils.h"
+
+// State of a GTM_potrf() call on this process
+typedef struct
+{
+    GTMatrix_t gtm;
+    int n, nb, nt;          // Matrix size, tile size, number of tile rows / columns
+    double *L_cache;        // Final tiles of L fetched by this process, slot i holds a tile (i, L_tag[i])
+    int *L_tag;             // Tile column of the L tile in each slot, -1 if empty
+    double *work;           // Task workspace, one tile
+    MPI_Win cnt_win;        // Tile counters, always in a lock_all epoch
+    int *tile_cnt;          // Local tile counters, counter of tile (i, j) is tile_cnt[i * nt + j] on its owner
+    int info;               // 0, or first column with a non-positive pivot + 1
+} GTM_Potrf_Ctx;
+
+static int GTM_tileStart(GTM_Potrf_Ctx *ctx, int t) { return t * ctx->nb; }
+static int GTM_tileLen(GTM_Potrf_Ctx *ctx, int t) { return MIN(ctx->nb, ctx->n - t * ctx->nb); }
+
+// Owner of the first element of tile (i, j)
+static int GTM_tileOwner(GTM_Potrf_Ctx *ctx, int i, int j)
+{
+    GTMatrix_t gtm = ctx->gtm;
+    int rowblk = GTM_findBlockIndex(gtm->r_displs, gtm->r_blocks, GTM_tileStart(ctx, i));
+    int colblk = GTM_findBlockIndex(gtm->c_displs, gtm->c_blocks, GTM_tileStart(ctx, j));
+    return rowblk * gtm->c_blocks + colblk;
+}
+
+// The counter of tile (i, j), j <= i, counts the finished updates of steps 
+// s < j, then is incremented once more when L(i, j) is written. So A(i, j) is
+// ready for POTRF / TRSM when its counter is j, and L(i, j) is final when its 
+// counter is j + 1. Tile data is written with blocking calls before the 
+// counter is incremented.
+static void GTM_signalTile(GTM_Potrf_Ctx *ctx, int i, int j)
+{
+    int one = 1, owner = GTM_tileOwner(ctx, i, j);
+    MPI_Accumulate(&one, 1, MPI_INT, owner, (MPI_Aint) i * ctx->nt + j, 1, MPI_INT, MPI_SUM, ctx->cnt_win);
+    MPI_Win_flush(owner, ctx->cnt_win);
+}
+
+// Wait until the counter of tile (i, j) reaches target
+static void GTM_waitTile(GTM_Potrf_Ctx *ctx, int i, int j, int target)
+{
+    int cnt, owner = GTM_tileOwner(ctx, i, j);
+    do {
+        MPI_Fetch_and_op(NULL, &cnt, MPI_INT, owner, (MPI_Aint) i * ctx->nt + j, MPI_NO_OP, ctx->cnt_win);
+        MPI_Win_flush(owner, ctx->cnt_win);
+    } while (cnt < target);
+}
+
+// Get the final tile L(i, j), a tile stays in its slot until another tile of 
+// row i is needed
+static double *GTM_getLTile(GTM_Potrf_Ctx *ctx, int i, int j)
+{
+    double *tile = ctx->L_cache + (size_t) i * (size_t) ctx->nb * (size_t) ctx->nb;
+    if (ctx->L_tag[i] == j) return tile;
+    GTM_waitTile(ctx, i, j, j + 1);
+    GTM_getBlock(
+        ctx->gtm, GTM_tileStart(ctx, i), GTM_tileLen(ctx, i),
+        GTM_tileStart(ctx, j), GTM_tileLen(ctx, j), tile, ctx->nb
+    );
+    ctx->L_tag[i] = j;
+    return tile;
+}
+
+// POTRF: L(k, k) = chol(A(k, k)) after all updates of A(k, k)
+static void GTM_potrfDiagTask(GTM_Potrf_Ctx *ctx, int k)
+{
+    int nb = ctx->nb, start_k = GTM_tileStart(ctx, k), len_k = GTM_tileLen(ctx, k);
+    GTM_waitTile(ctx, k, k, k);
+    GTM_getBlock(ctx->gtm, start_k, len_k, start_k, len_k, ctx->work, nb);
+    int info = GTM_tilePotrfL(len_k, ctx->work, nb);
+    if ((info > 0) && (ctx->info == 0)) ctx->info = start_k + info;
+    GTM_putBlock(ctx->gtm, start_k, len_k, start_k, len_k, ctx->work, nb);
+    GTM_signalTile(ctx, k, k);
+}
+
+// TRSM: L(i, k) = A(i, k) * L(k, k)^{-T}, i > k, after all updates of A(i, k)
+static void GTM_potrfPanelTask(GTM_Potrf_Ctx *ctx, int i, int k)
+{
+    int nb = ctx->nb;
+    int start_i = GTM_tileStart(ctx, i), len_i = GTM_tileLen(ctx, i);
+    int start_k = GTM_tileStart(ctx, k), len_k = GTM_tileLen(ctx, k);
+    double *L_kk = GTM_getLTile(ctx, k, k);
+    GTM_waitTile(ctx, i, k, k);
+    GTM_getBlock(ctx->gtm, start_i, len_i, start_k, len_k, ctx->work, nb);
+    GTM_tileTrsmRLT(len_i, len_k, L_kk, nb, ctx->work, nb);
+    GTM_putBlock(ctx->gtm, start_i, len_i, start_k, len_k, ctx->work, nb);
+    GTM_signalTile(ctx, i, k);
+}
+
+// SYRK / GEMM: A(i, j) -= L(i, s) * L(j, s)^T, s < j <= i
+static void GTM_potrfUpdateTask(GTM_Potrf_Ctx *ctx, int i, int j, int s)
+{
+    int nb = ctx->nb, len_s = GTM_tileLen(ctx, s);
+    int len_i = GTM_tileLen(ctx, i), len_j = GTM_tileLen(ctx, j);
+    double *L_i = GTM_getLTile(ctx, i, s);
+    double *L_j = GTM_getLTile(ctx, j, s);
+    if (i == j)
+    {
+        // Only the lower triangle of a diagonal tile is updated
+        memset(ctx->work, 0, sizeof(double) * nb * nb);
+        GTM_tileSyrkLN(len_i, len_s, -1.0, L_i, nb, 0.0, ctx->work, nb);
+    } else {
+        GTM_tileGemmNT(len_i, len_j, len_s, -1.0, L_i, nb, L_j, nb, 0.0, ctx->work, nb);
+    }
+    GTM_accBlock(ctx->gtm, GTM_tileStart(ctx, i), len_i, GTM_tileStart(ctx, j), len_j, ctx->work, nb);
+    GTM_signalTile(ctx, i, j);
+}
+
+// Append task (i, j, s) to a task list: POTRF if i == j == s, TRSM if i > j == s,
+// otherwise the update of tile (i, j) in step s
+static void GTM_pushPotrfTask(int *task_ijs, int *n_task, int i, int j, int s)
+{
+    task_ijs[3 * (*n_task)]     = i;
+    task_ijs[3 * (*n_task) + 1] = j;
+    task_ijs[3 * (*n_task) + 2] = s;
+    (*n_task)++;
+}
+
+int GTM_potrf(GTMatrix_t gtm, int tile_size)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    if (gtm->nrows != gtm->ncols) return GTM_NOT_SQUARE_MAT;
+    if ((gtm->datatype != MPI_DOUBLE) || gtm->symm_storage || gtm->versioned) return GTM_INVALID_FLAGS;
+
+    GTM_Potrf_Ctx ctx;
+    ctx.gtm  = gtm;
+    ctx.n    = gtm->nrows;
+    ctx.nb   = (tile_size > 0) ? MIN(tile_size, ctx.n) : MIN(GTM_POTRF_TILE_SIZE, ctx.n);
+    ctx.nt   = (ctx.n + ctx.nb - 1) / ctx.nb;
+    ctx.info = 0;
+    int nt = ctx.nt, nproc = gtm->comm_size;
+    size_t tile_bytes  = sizeof(double) * (size_t) ctx.nb * (size_t) ctx.nb;
+    size_t max_tasks   = (size_t) nt * (size_t) (nt + 1) * (size_t) (nt + 2) / 6 + (size_t) nt;
+    ctx.L_cache        = (double*) GTM_allocBuffer(tile_bytes * nt);
+    ctx.L_tag          = (int*)    malloc(sizeof(int) * nt);
+    ctx.work           = (double*) GTM_allocBuffer(tile_bytes);
+    ctx.tile_cnt       = (int*)    calloc((size_t) nt * (size_t) nt, sizeof(int));
+    int *task_cnt      = (int*)    malloc(sizeof(int) * (nproc + 1));
+    int *task_displs   = (int*)    malloc(sizeof(int) * (nproc + 1));
+    int *task_ijs      = (int*)    malloc(sizeof(int) * 3 * max_tasks);
+    int *task_ijs_own  = (int*)    malloc(sizeof(int) * 3 * max_tasks);
+    int alloc_ok = (ctx.L_cache != NULL) && (ctx.L_tag != NULL) && (ctx.work != NULL) && 
+                   (ctx.tile_cnt != NULL) && (task_cnt != NULL) && (task_displs != NULL) && 
+                   (task_ijs != NULL) && (task_ijs_own != NULL);
+    int all_ok;
+    MPI_Allreduce(&alloc_ok, &all_ok, 1, MPI_INT, MPI_MIN, gtm->mpi_comm);
+    if (all_ok == 0)
+    {
+        GTM_freeBuffer(ctx.L_cache);
+        free(ctx.L_tag);
+        GTM_freeBuffer(ctx.work);
+        free(ctx.tile_cnt);
+        free(task_cnt);
+        free(task_displs);
+        free(task_ijs);
+        free(task_ijs_own);
+        return GTM_ALLOC_FAILED;
+    }
+    for (int i = 0; i < nt; i++) ctx.L_tag[i] = -1;
+
+    // All tasks in a topological order of the task DAG. Step k first updates 
+    // column k + 1 and then factors it (look-ahead), before the rest of the 
+    // trailing update of step k, so the panel of step k + 1 is not delayed by 
+    // the trailing update
+    int n_task = 0;
+    GTM_pushPotrfTask(task_ijs, &n_task, 0, 0, 0);
+    for (int i = 1; i < nt; i++) GTM_pushPotrfTask(task_ijs, &n_task, i, 0, 0);
+    for (int k = 0; k < nt - 1; k++)
+    {
+        for (int i = k + 1; i < nt; i++) GTM_pushPotrfTask(task_ijs, &n_task, i, k + 1, k);
+        GTM_pushPotrfTask(task_ijs, &n_task, k + 1, k + 1, k + 1);
+        for (int i = k + 2; i < nt; i++) GTM_pushPotrfTask(task_ijs, &n_task, i, k + 1, k + 1);
+        for (int j = k + 2; j < nt; j++)
+            for (int i = j; i < nt; i++) GTM_pushPotrfTask(task_ijs, &n_task, i, j, k);
+    }
+
+    // Each process owns the tasks writing its tiles, in the same order
+    memset(task_cnt, 0, sizeof(int) * (nproc + 1));
+    for (int t = 0; t < n_task; t++)
+        task_cnt[GTM_tileOwner(&ctx, task_ijs[3 * t], task_ijs[3 * t + 1])]++;
+    task_displs[0] = 0;
+    for (int r = 0; r < nproc; r++) task_displs[r + 1] = task_displs[r] + task_cnt[r];
+    memcpy(task_cnt, task_displs, sizeof(int) * nproc);
+    for (int t = 0; t < n_task; t++)
+    {
+        int owner = GTM_tileOwner(&ctx, task_ijs[3 * t], task_ijs[3 * t + 1]);
+        memcpy(task_ijs_own + 3 * task_cnt[owner]++, task_ijs + 3 * t, sizeof(int) * 3);
+    }
+
+    GTM_Task_Queue_t tq;
+    GTM_createTaskQueue(&tq, gtm->mpi_comm);
+    MPI_Win_create(
+        ctx.tile_cnt, (MPI_Aint) sizeof(int) * nt * nt, sizeof(int), 
+        MPI_INFO_NULL, gtm->mpi_comm, &ctx.cnt_win
+    );
+    MPI_Win_lock_all(0, ctx.cnt_win);
+
+    // Tile buffers are row-major with leading dimension nb
+    int col_major_buf = gtm->col_major_buf;
+    gtm->col_major_buf = 0;
+
+    // Claim tasks of this process first, then steal from other processes. A task
+    // waits for the counters of its input tiles. Tasks of each process are claimed
+    // in the topological order, so the first unfinished task in the order always 
+    // has finished inputs and is claimed, no process waits forever.
+    for (int d = 0; d < nproc; d++)
+    {
+        int r = (gtm->my_rank + d) % nproc;
+        int r_ntask = task_displs[r + 1] - task_displs[r];
+        if (r_ntask == 0) continue;
+        int t = GTM_getNextTasks(tq, r, 1);
+        while (t < r_ntask)
+        {
+            int *ijs = task_ijs_own + 3 * (task_displs[r] + t);
+            if (ijs[1] != ijs[2])     GTM_potrfUpdateTask(&ctx, ijs[0], ijs[1], ijs[2]);
+            else if (ijs[0] > ijs[1]) GTM_potrfPanelTask(&ctx, ijs[0], ijs[1]);
+            else GTM_potrfDiagTask(&ctx, ijs[0]);
+            t = GTM_getNextTasks(tq, r, 1);
+        }
+    }
+
+    gtm->col_major_buf = col_major_buf;
+    GTM_sync(gtm);
+    MPI_Win_unlock_all(ctx.cnt_win);
+    MPI_Win_free(&ctx.cnt_win);
+    GTM_destroyTaskQueue(tq);
+
+    int info;
+    MPI_Allreduce(&ctx.info, &info, 1, MPI_INT, MPI_MAX, gtm->mpi_comm);
+    GTM_freeBuffer(ctx.L_cache);
+    free(ctx.L_tag);
+    GTM_freeBuffer(ctx.work);
+    free(ctx.tile_cnt);
+    free(task_cnt);
+    free(task_displs);
+    free(task_ijs);
+    free(task_ijs_own);
+    return (info == 0) ? GTM_SUCCESS : GTM_NOT_POS_DEF;
+}
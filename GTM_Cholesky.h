@@ -0,0 +1,37 @@
+#ifndef __GTM_CHOLESKY_H__
+#define __GTM_CHOLESKY_H__
+
+#include <mpi.h>
+#include "GTMatrix_Typedef.h"
+
+// In-place right-looking blocked Cholesky factorization A = L * L^T of a
+// symmetric positive definite GTMatrix. The matrix is split into tile_size *
+// tile_size tiles, nt = ceil(nrows / tile_size). The factorization is a task 
+// DAG: POTRF of tile (k, k), TRSM of tiles (i, k), i > k, and the update of 
+// step s (SYRK / GEMM on tiles (i, j), s < j <= i). Each tile has a counter in
+// an RMA window on its owner, counting the finished updates of the tile and 
+// the write of its L tile. A task waits for the counters of its input tiles 
+// only, there is no synchronization between steps. Tasks are assigned to the 
+// owner of their output tile in a topological order and claimed dynamically 
+// with GTM_Task_Queue, an idle process steals tasks of other processes. In the
+// order, the update of column k + 1 of step k and the panel of step k + 1 come
+// before the rest of the trailing update of step k (look-ahead). Updates are 
+// accumulated with GTM_accBlock(), so trailing tiles are never read back for 
+// an update. Final L tiles are fetched once and cached by row.
+
+#define GTM_POTRF_TILE_SIZE  64  // Default tile size of GTM_potrf()
+
+// Cholesky factorization of the lower triangle, L overwrites the lower triangle
+// of A, the strict upper triangle of A is not changed. Call GTM_sync() before it
+// if the matrix has been updated with RMA operations.
+// This call is collective, not thread-safe
+// Input parameters:
+//   gtm       : GTMatrix handle, the data type must be MPI_DOUBLE, symmetric and
+//               versioned storage are not supported (GTM_INVALID_FLAGS)
+//   tile_size : Tile size, <= 0 means GTM_POTRF_TILE_SIZE
+// Output parameter:
+//   @return : GTM_SUCCESS, or GTM_NOT_POS_DEF if A is not positive definite,
+//             the content of A is undefined in this case
+int GTM_potrf(GTMatrix_t gtm, int tile_size);
+
+#endif
@@ -0,0 +1,163 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix_Retval.h"
+#include "GTMatrix_Typedef.h"
+#include "GTM_Halo.h"
+#include "utils.h"
+
+// Rows (or columns) of a region in the padded buffer in direction d (-1, 0, 1)
+// of the local block, local indices. Halo region: the h_lo elements before
+// the block, the block itself, or the h_hi elements after the block.
+static void GTM_haloRange(int d, int n, int h_lo, int h_hi, int *start, int *num)
+{
+    if (d == -1) { *start = -h_lo; *num = h_lo; }
+    if (d ==  0) { *start = 0;     *num = n;    }
+    if (d ==  1) { *start = n;     *num = h_hi; }
+}
+
+// Rows (or columns) of the local block sent to the neighbor in direction d:
+// the neighbor's halo on the other side of it is next to this block
+static void GTM_haloSendRange(int d, int n, int h_lo, int h_hi, int *start, int *num)
+{
+    if (d == -1) { *start = 0;        *num = h_hi; }
+    if (d ==  0) { *start = 0;        *num = n;    }
+    if (d ==  1) { *start = n - h_lo; *num = h_lo; }
+}
+
+// Create a committed data type of a region in the padded buffer, return the
+// pointer to the first element of the region
+static void *GTM_haloRegionType(
+    GTM_Halo_t halo, int row_start, int row_num, int col_start, int col_num, MPI_Datatype *dt
+)
+{
+    GTMatrix_t gtm = halo->gtm;
+    MPI_Type_vector(row_num, col_num, halo->ld, gtm->datatype, dt);
+    MPI_Type_commit(dt);
+    size_t offset = (size_t) (row_start + halo->h_top) * (size_t) halo->ld + (size_t) (col_start + halo->h_left);
+    return (char*) halo->buf + offset * (size_t) gtm->unit_size;
+}
+
+int GTM_createHalo(
+    GTM_Halo_t *_halo, GTMatrix_t gtm, int h_top, int h_bottom,
+    int h_left, int h_right
+)
+{
+    if ((_halo == NULL) || (gtm == NULL)) return GTM_NULL_PTR;
+    if (gtm->symm_storage) return GTM_INVALID_FLAGS;
+    if ((h_top < 0) || (h_bottom < 0) || (h_left < 0) || (h_right < 0)) return GTM_INVALID_BLOCK;
+    for (int i = 0; i < gtm->r_blocks; i++)
+        if ((h_top > gtm->r_blklens[i]) || (h_bottom > gtm->r_blklens[i])) return GTM_INVALID_BLOCK;
+    for (int i = 0; i < gtm->c_blocks; i++)
+        if ((h_left > gtm->c_blklens[i]) || (h_right > gtm->c_blklens[i])) return GTM_INVALID_BLOCK;
+
+    GTM_Halo_t halo = (GTM_Halo_t) malloc(sizeof(struct GTM_Halo));
+    if (halo == NULL) return GTM_ALLOC_FAILED;
+    halo->gtm      = gtm;
+    halo->h_top    = h_top;
+    halo->h_bottom = h_bottom;
+    halo->h_left   = h_left;
+    halo->h_right  = h_right;
+    halo->ld       = h_left + gtm->my_ncols + h_right;
+    size_t nelem   = (size_t) (h_top + gtm->my_nrows + h_bottom) * (size_t) halo->ld;
+    if (MPI_Alloc_mem((MPI_Aint) (nelem * (size_t) gtm->unit_size), MPI_INFO_NULL, &halo->buf) != MPI_SUCCESS)
+    {
+        free(halo);
+        return GTM_ALLOC_FAILED;
+    }
+    memset(halo->buf, 0, nelem * (size_t) gtm->unit_size);
+    halo->local_ptr = (char*) halo->buf + ((size_t) h_top * (size_t) halo->ld + (size_t) h_left) * (size_t) gtm->unit_size;
+
+    // Persistent requests for each neighbor in the process grid, receives first
+    halo->n_req = 0;
+    for (int send = 0; send <= 1; send++)
+    {
+        for (int dr = -1; dr <= 1; dr++)
+        {
+            for (int dc = -1; dc <= 1; dc++)
+            {
+                int nb_rowblk = gtm->my_rowblk + dr;
+                int nb_colblk = gtm->my_colblk + dc;
+                if ((dr == 0) && (dc == 0)) continue;
+                if ((nb_rowblk < 0) || (nb_rowblk >= gtm->r_blocks) ||
+                    (nb_colblk < 0) || (nb_colblk >= gtm->c_blocks)) continue;
+                int nb_rank = nb_rowblk * gtm->c_blocks + nb_colblk;
+                int row_start, row_num, col_start, col_num;
+                if (send == 0)
+                {
+                    GTM_haloRange(dr, gtm->my_nrows, h_top,  h_bottom, &row_start, &row_num);
+                    GTM_haloRange(dc, gtm->my_ncols, h_left, h_right,  &col_start, &col_num);
+                } else {
+                    GTM_haloSendRange(dr, gtm->my_nrows, h_top,  h_bottom, &row_start, &row_num);
+                    GTM_haloSendRange(dc, gtm->my_ncols, h_left, h_right,  &col_start, &col_num);
+                }
+                if (row_num * col_num == 0) continue;
+
+                // The tag is the direction of the sender seen from the receiver
+                int i = halo->n_req;
+                void *ptr = GTM_haloRegionType(halo, row_start, row_num, col_start, col_num, &halo->dts[i]);
+                if (send == 0)
+                {
+                    int tag = GTM_HALO_TAG + (dr + 1) * 3 + (dc + 1);
+                    MPI_Recv_init(ptr, 1, halo->dts[i], nb_rank, tag, gtm->mpi_comm, &halo->reqs[i]);
+                } else {
+                    int tag = GTM_HALO_TAG + (1 - dr) * 3 + (1 - dc);
+                    MPI_Send_init(ptr, 1, halo->dts[i], nb_rank, tag, gtm->mpi_comm, &halo->reqs[i]);
+                }
+                halo->n_req++;
+            }
+        }
+    }
+
+    *_halo = halo;
+    return GTM_SUCCESS;
+}
+
+// Copy the published version of the local block into the padded buffer
+static void GTM_copyLocalToHalo(GTM_Halo_t halo)
+{
+    GTMatrix_t gtm = halo->gtm;
+    size_t unit_size = (size_t) gtm->unit_size;
+    char *src = (char*) gtm->mat_block + (size_t) gtm->rd_offset * unit_size;
+    char *dst = (char*) halo->local_ptr;
+    for (int i = 0; i < gtm->my_nrows; i++)
+    {
+        char *dst_row = dst + (size_t) i * (size_t) halo->ld * unit_size;
+        if (gtm->col_major)
+        {
+            for (int j = 0; j < gtm->my_ncols; j++)
+                memcpy(dst_row + j * unit_size, src + GTM_LOCAL_OFFSET(gtm, i, j) * unit_size, unit_size);
+            continue;
+        }
+        // Row-major or tile-major layout, each run inside a tile is contiguous
+        for (int j0 = 0, nj; j0 < gtm->my_ncols; j0 += nj)
+        {
+            nj = GTM_TILE_SPAN(gtm, j0, gtm->my_ncols - j0);
+            memcpy(dst_row + j0 * unit_size, src + GTM_LOCAL_OFFSET(gtm, i, j0) * unit_size, nj * unit_size);
+        }
+    }
+}
+
+int GTM_updateHalo(GTM_Halo_t halo)
+{
+    if (halo == NULL) return GTM_NULL_PTR;
+    GTM_copyLocalToHalo(halo);
+    MPI_Startall(halo->n_req, halo->reqs);
+    MPI_Waitall(halo->n_req, halo->reqs, MPI_STATUSES_IGNORE);
+    return GTM_SUCCESS;
+}
+
+int GTM_destroyHalo(GTM_Halo_t halo)
+{
+    if (halo == NULL) return GTM_NULL_PTR;
+    for (int i = 0; i < halo->n_req; i++)
+    {
+        MPI_Request_free(&halo->reqs[i]);
+        MPI_Type_free(&halo->dts[i]);
+    }
+    MPI_Free_mem(halo->buf);
+    free(halo);
+    return GTM_SUCCESS;
+}
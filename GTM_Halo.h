@@ -0,0 +1,60 @@
+#ifndef __GTM_HALO_H__
+#define __GTM_HALO_H__
+
+#include <mpi.h>
+#include "GTMatrix_Typedef.h"
+
+// Halo (ghost region) of each local block for stencil-style neighbor access.
+// Each process holds a padded copy of its local block: h_top rows above,
+// h_bottom rows below, h_left columns on the left and h_right columns on the
+// right of the block. GTM_updateHalo() copies the local block into the padded
+// buffer and fills the halo from the 8 neighbors in the r_blocks * c_blocks
+// process grid (row, column and corner neighbors) with persistent point-to-point
+// requests created once. Halo elements outside the global matrix are 0.
+struct GTM_Halo
+{
+    GTMatrix_t gtm;              // GTMatrix of the halo
+    int h_top, h_bottom;         // Number of halo rows above and below the local block
+    int h_left, h_right;         // Number of halo columns on the left and right of the local block
+    int ld;                      // Leading dimension of the padded buffer
+    void *buf;                   // Padded buffer, (h_top + my_nrows + h_bottom) * ld, row-major
+    void *local_ptr;             // Pointer to local element (0, 0) in buf, element (i, j) of the
+                                 // local block is local_ptr[i * ld + j], -h_top <= i < my_nrows + h_bottom,
+                                 // -h_left <= j < my_ncols + h_right
+    int n_req;                   // Number of persistent requests
+    MPI_Request reqs[16];        // Persistent receive and send requests, 8 neighbors at most
+    MPI_Datatype dts[16];        // Data types of the requests
+};
+
+typedef struct GTM_Halo* GTM_Halo_t;
+
+#define GTM_HALO_TAG  0x4855  // Base MPI tag of halo exchange messages
+
+// Create a halo for a GTMatrix, halo widths are the same on all processes
+// This call is collective, not thread-safe
+// Input parameters:
+//   gtm      : GTMatrix handle, symmetric storage is not supported
+//   h_top    : Number of halo rows above each local block
+//   h_bottom : Number of halo rows below each local block
+//   h_left   : Number of halo columns on the left of each local block
+//   h_right  : Number of halo columns on the right of each local block
+//   Each halo width should not be larger than the size of any block in
+//   the same direction, otherwise GTM_INVALID_BLOCK is returned
+// Output parameter:
+//   *_halo : Pointer to the created GTM_Halo structure
+int GTM_createHalo(
+    GTM_Halo_t *_halo, GTMatrix_t gtm, int h_top, int h_bottom,
+    int h_left, int h_right
+);
+
+// Copy the local block (the published version) into the padded buffer and
+// exchange the halo with neighbor processes. Call GTM_sync() before it if
+// the matrix has been updated with RMA operations.
+// This call is collective, not thread-safe
+int GTM_updateHalo(GTM_Halo_t halo);
+
+// Free a GTM_Halo structure, no halo exchange should be in progress
+// This call is not collective, thread-safe
+int GTM_destroyHalo(GTM_Halo_t halo);
+
+#endif
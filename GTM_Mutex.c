@@ -0,0 +1,63 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <mpi.h>
+
+#include "GTMatrix_Retval.h"
+#include "GTM_Region_Lock.h"
+#include "GTM_Mutex.h"
+
+int GTM_createMutex(GTM_Mutex_t *_mutex, MPI_Comm comm, int nmutex)
+{
+    if (nmutex < 1) return GTM_INVALID_BLOCK;
+    GTM_Mutex_t mutex = (GTM_Mutex_t) malloc(sizeof(struct GTM_Mutex));
+    if (mutex == NULL) return GTM_ALLOC_FAILED;
+    
+    MPI_Comm_size(comm, &mutex->comm_size);
+    mutex->nmutex = nmutex;
+    // Lock i of a GTM_Region_Lock uses queue node i of the waiting process, so a 
+    // process can hold locks with different lock_id on different hosts at the same
+    // time. Mutex i is lock i on its host, each mutex has its own queue node.
+    int ret = GTM_createRegionLock(&mutex->gtrl, comm, nmutex);
+    if (ret != GTM_SUCCESS)
+    {
+        free(mutex);
+        return ret;
+    }
+    
+    *_mutex = mutex;
+    return GTM_SUCCESS;
+}
+
+int GTM_destroyMutex(GTM_Mutex_t mutex)
+{
+    if (mutex == NULL) return GTM_NULL_PTR;
+    GTM_destroyRegionLock(mutex->gtrl);
+    free(mutex);
+    return GTM_SUCCESS;
+}
+
+int GTM_lockMutex(GTM_Mutex_t mutex, int mutex_id)
+{
+    if (mutex == NULL) return GTM_NULL_PTR;
+    if ((mutex_id < 0) || (mutex_id >= mutex->nmutex)) return GTM_INVALID_BLOCK;
+    int dst_rank = mutex_id % mutex->comm_size;
+    return GTM_acquireRegionLock(mutex->gtrl, dst_rank, mutex_id);
+}
+
+int GTM_unlockMutex(GTM_Mutex_t mutex, int mutex_id)
+{
+    if (mutex == NULL) return GTM_NULL_PTR;
+    if ((mutex_id < 0) || (mutex_id >= mutex->nmutex)) return GTM_INVALID_BLOCK;
+    int dst_rank = mutex_id % mutex->comm_size;
+    return GTM_releaseRegionLock(mutex->gtrl, dst_rank, mutex_id);
+}
+
+int GTM_trylockMutex(GTM_Mutex_t mutex, int mutex_id, int *locked)
+{
+    if (mutex == NULL) return GTM_NULL_PTR;
+    if ((mutex_id < 0) || (mutex_id >= mutex->nmutex)) return GTM_INVALID_BLOCK;
+    int dst_rank = mutex_id % mutex->comm_size;
+    return GTM_tryAcquireRegionLock(mutex->gtrl, dst_rank, mutex_id, locked);
+}
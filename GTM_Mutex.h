@@ -0,0 +1,48 @@
+#ifndef __GTM_MUTEX_H__
+#define __GTM_MUTEX_H__
+
+#include <mpi.h>
+#include "GTM_Region_Lock.h"
+
+// Distributed mutexes for user critical sections, e.g. short read-modify-write
+// sequences on a GTMatrix. Mutexes are MCS queue locks (see GTM_Region_Lock.h)
+// and are spread over processes in round-robin order: mutex i is hosted by 
+// process (i % comm_size) and has its own queue node on each process, so a process
+// can hold several mutexes at the same time. A waiting process only spins on its 
+// local queue node.
+struct GTM_Mutex
+{
+    GTM_Region_Lock_t gtrl;  // MCS locks backing the mutexes
+    int nmutex;              // Number of mutexes
+    int comm_size;           // Number of process in the communicator
+};
+
+typedef struct GTM_Mutex* GTM_Mutex_t;
+
+// Create nmutex distributed mutexes, all mutexes are unlocked
+// This call is collective, thread-safe
+// Input parameters:
+//   comm   : MPI communicator used in these mutexes
+//   nmutex : Number of mutexes, should be the same on all processes
+// Output parameter:
+//   *_mutex : Pointer to the created GTM_Mutex structure
+int GTM_createMutex(GTM_Mutex_t *_mutex, MPI_Comm comm, int nmutex);
+
+// Free a GTM_Mutex structure, all mutexes should be unlocked
+// This call is collective, thread-safe
+int GTM_destroyMutex(GTM_Mutex_t mutex);
+
+// Lock / unlock mutex mutex_id, mutexes are not recursive
+// A process holding several mutexes should lock them in ascending order of
+// mutex_id to avoid deadlock.
+// This call is not collective, not thread-safe
+int GTM_lockMutex  (GTM_Mutex_t mutex, int mutex_id);
+int GTM_unlockMutex(GTM_Mutex_t mutex, int mutex_id);
+
+// Try to lock mutex mutex_id without waiting
+// This call is not collective, not thread-safe
+// Output parameter:
+//   *locked : 1 if the mutex is locked by this call, 0 if it is held by others
+int GTM_trylockMutex(GTM_Mutex_t mutex, int mutex_id, int *locked);
+
+#endif
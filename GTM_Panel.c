@@ -0,0 +1,342 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix_Retval.h"
+#include "GTMatrix_Typedef.h"
+#include "GTMatrix_Other.h"
+#include "GTMatrix_Track.h"
+#include "GTM_Panel.h"
+#include "GTM_Buffer.h"
+#include "utils.h"
+
+// Create the process row and column communicators if they are not created yet
+static void GTM_initGridComms(GTMatrix_t gtm)
+{
+    if (gtm->row_comm != MPI_COMM_NULL) return;
+    MPI_Comm_split(gtm->mpi_comm, gtm->my_rowblk, gtm->my_colblk, &gtm->row_comm);
+    MPI_Comm_split(gtm->mpi_comm, gtm->my_colblk, gtm->my_rowblk, &gtm->col_comm);
+}
+
+int GTM_getGridComms(GTMatrix_t gtm, MPI_Comm *row_comm, MPI_Comm *col_comm)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    GTM_initGridComms(gtm);
+    if (row_comm != NULL) *row_comm = gtm->row_comm;
+    if (col_comm != NULL) *col_comm = gtm->col_comm;
+    return GTM_SUCCESS;
+}
+
+// Find the block that contains [start, start + num), return -1 if there is no such block
+static int GTM_findPanelBlock(const int *displs, int nblocks, int start, int num)
+{
+    if ((num <= 0) || (start < 0)) return -1;
+    int blk = GTM_findBlockIndex(displs, nblocks, start);
+    return (start + num <= displs[blk + 1]) ? blk : -1;
+}
+
+// Part of a panel on this process, a prows * pcols block. The root of the
+// process row / column holds it in local rows [lrow_s, lrow_s + prows) and
+// local columns [lcol_s, lcol_s + pcols). A column panel is split into
+// segments of rows, a row panel into segments of columns.
+typedef struct
+{
+    MPI_Comm comm;
+    int root;
+    int prows, pcols;
+    int lrow_s, lcol_s;
+    int seg_rows;              // 1: segments of rows, 0: segments of columns
+    int seg_len, n_seg;        // Rows (columns) of a segment and number of segments
+} GTM_Panel_Part;
+
+static int GTM_initPanelPart(
+    GTMatrix_t gtm, int is_col_panel, int start, int num, GTM_Panel_Part *part
+)
+{
+    if (gtm->symm_storage) return GTM_INVALID_FLAGS;
+    int blk;
+    if (is_col_panel)
+    {
+        blk = GTM_findPanelBlock(gtm->c_displs, gtm->c_blocks, start, num);
+        if (blk == -1) return GTM_INVALID_BLOCK;
+        part->root   = blk;
+        part->prows  = gtm->my_nrows;
+        part->pcols  = num;
+        part->lrow_s = 0;
+        part->lcol_s = start - gtm->c_displs[blk];
+    } else {
+        blk = GTM_findPanelBlock(gtm->r_displs, gtm->r_blocks, start, num);
+        if (blk == -1) return GTM_INVALID_BLOCK;
+        part->root   = blk;
+        part->prows  = num;
+        part->pcols  = gtm->my_ncols;
+        part->lrow_s = start - gtm->r_displs[blk];
+        part->lcol_s = 0;
+    }
+    GTM_initGridComms(gtm);
+    part->comm     = is_col_panel ? gtm->row_comm : gtm->col_comm;
+    part->seg_rows = is_col_panel;
+    int len   = is_col_panel ? part->prows : part->pcols;
+    int width = is_col_panel ? part->pcols : part->prows;
+    part->seg_len = gtm->panel_seg_size / (width * gtm->unit_size);
+    if (part->seg_len < 1)   part->seg_len = 1;
+    if (part->seg_len > len) part->seg_len = len;
+    part->n_seg = (len + part->seg_len - 1) / part->seg_len;
+    return GTM_SUCCESS;
+}
+
+// Rows and columns of segment k in the part, relative to the part
+static void GTM_getPanelSegment(GTM_Panel_Part *part, int k, int *r0, int *nr, int *c0, int *nc)
+{
+    int s   = k * part->seg_len;
+    int len = part->seg_rows ? part->prows : part->pcols;
+    int n   = (s + part->seg_len <= len) ? part->seg_len : (len - s);
+    *r0 = part->seg_rows ? s : 0;
+    *nr = part->seg_rows ? n : part->prows;
+    *c0 = part->seg_rows ? 0 : s;
+    *nc = part->seg_rows ? part->pcols : n;
+}
+
+// Create a committed data type of block [r0 : r0 + nr - 1, c0 : c0 + nc - 1]
+// in a user buffer, return the pointer to the first element of the block
+static void *GTM_panelBufType(
+    GTMatrix_t gtm, void *buf, int buf_ld, int r0, int nr, int c0, int nc, MPI_Datatype *dt
+)
+{
+    if (gtm->col_major_buf) MPI_Type_vector(nc, nr, buf_ld, gtm->datatype, dt);
+    else MPI_Type_vector(nr, nc, buf_ld, gtm->datatype, dt);
+    MPI_Type_commit(dt);
+    return (char*) buf + GTM_BUF_OFFSET(gtm, buf_ld, r0, c0) * (size_t) gtm->unit_size;
+}
+
+// Copy the published version of the part into a user buffer
+static void GTM_copyPanelFromLocal(GTMatrix_t gtm, GTM_Panel_Part *part, void *buf, int buf_ld)
+{
+    size_t unit_size = (size_t) gtm->unit_size;
+    char *src = (char*) gtm->mat_block + (size_t) gtm->rd_offset * unit_size;
+    char *dst = (char*) buf;
+    for (int i = 0; i < part->prows; i++)
+    {
+        int li = part->lrow_s + i;
+        if (gtm->col_major || gtm->col_major_buf)
+        {
+            for (int j = 0; j < part->pcols; j++)
+            {
+                size_t src_offset = GTM_LOCAL_OFFSET(gtm, li, part->lcol_s + j);
+                memcpy(dst + GTM_BUF_OFFSET(gtm, buf_ld, i, j) * unit_size, src + src_offset * unit_size, unit_size);
+            }
+            continue;
+        }
+        // Row-major or tile-major layout, each run inside a tile is contiguous
+        for (int j0 = 0, nj; j0 < part->pcols; j0 += nj)
+        {
+            int lj0 = part->lcol_s + j0;
+            nj = GTM_TILE_SPAN(gtm, lj0, part->pcols - j0);
+            memcpy(dst + GTM_BUF_OFFSET(gtm, buf_ld, i, j0) * unit_size, src + GTM_LOCAL_OFFSET(gtm, li, lj0) * unit_size, nj * unit_size);
+        }
+    }
+}
+
+// Pack block [r0 : r0 + nr - 1, c0 : c0 + nc - 1] of a user buffer into a
+// contiguous row-major buffer
+static void GTM_packPanelSegment(
+    GTMatrix_t gtm, void *buf, int buf_ld, int r0, int nr, int c0, int nc, void *seg
+)
+{
+    size_t unit_size = (size_t) gtm->unit_size;
+    char *src = (char*) buf;
+    char *dst = (char*) seg;
+    for (int i = 0; i < nr; i++)
+    {
+        char *dst_row = dst + (size_t) i * (size_t) nc * unit_size;
+        if (gtm->col_major_buf)
+        {
+            for (int j = 0; j < nc; j++)
+                memcpy(dst_row + j * unit_size, src + GTM_BUF_OFFSET(gtm, buf_ld, r0 + i, c0 + j) * unit_size, unit_size);
+        } else {
+            memcpy(dst_row, src + GTM_BUF_OFFSET(gtm, buf_ld, r0 + i, c0) * unit_size, nc * unit_size);
+        }
+    }
+}
+
+// Apply a reduced contiguous row-major segment to the write version of the
+// local block, A = op(A, seg)
+static void GTM_applyPanelSegment(
+    GTMatrix_t gtm, GTM_Panel_Part *part, MPI_Op op, int r0, int nr, int c0, int nc, void *seg
+)
+{
+    size_t unit_size = (size_t) gtm->unit_size;
+    char *dst = (char*) GTM_getLocalWriteBlock(gtm);
+    char *src = (char*) seg;
+    for (int i = 0; i < nr; i++)
+    {
+        int li = part->lrow_s + r0 + i;
+        char *src_row = src + (size_t) i * (size_t) nc * unit_size;
+        for (int j0 = 0, nj; j0 < nc; j0 += nj)
+        {
+            int lj0 = part->lcol_s + c0 + j0;
+            nj = gtm->col_major ? 1 : GTM_TILE_SPAN(gtm, lj0, nc - j0);
+            MPI_Reduce_local(src_row + j0 * unit_size, dst + GTM_LOCAL_OFFSET(gtm, li, lj0) * unit_size, nj, gtm->datatype, op);
+        }
+    }
+}
+
+// Pipelined broadcast along the ring root -> root + 1 -> ... -> root - 1
+static int GTM_bcastPanel(GTMatrix_t gtm, int is_col_panel, int start, int num, void *buf, int buf_ld)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    GTM_Panel_Part part;
+    int ret = GTM_initPanelPart(gtm, is_col_panel, start, num, &part);
+    if (ret != GTM_SUCCESS) return ret;
+    if (buf == NULL) return GTM_NULL_PTR;
+
+    int rank, nproc;
+    MPI_Comm_rank(part.comm, &rank);
+    MPI_Comm_size(part.comm, &nproc);
+    if (rank == part.root) GTM_copyPanelFromLocal(gtm, &part, buf, buf_ld);
+    if (nproc == 1) return GTM_SUCCESS;
+
+    int rel  = (rank - part.root + nproc) % nproc;
+    int prev = (rank - 1 + nproc) % nproc;
+    int next = (rank + 1) % nproc;
+    MPI_Request *reqs = (MPI_Request*) malloc(sizeof(MPI_Request) * part.n_seg);
+    if (reqs == NULL) return GTM_ALLOC_FAILED;
+    int n_req = 0;
+    for (int k = 0; k < part.n_seg; k++)
+    {
+        int r0, nr, c0, nc;
+        MPI_Datatype dt;
+        GTM_getPanelSegment(&part, k, &r0, &nr, &c0, &nc);
+        void *ptr = GTM_panelBufType(gtm, buf, buf_ld, r0, nr, c0, nc, &dt);
+        // Receive segment k from the previous process, then forward it while
+        // receiving the next segment
+        if (rel > 0) MPI_Recv(ptr, 1, dt, prev, GTM_PANEL_TAG, part.comm, MPI_STATUS_IGNORE);
+        if (rel < nproc - 1) MPI_Isend(ptr, 1, dt, next, GTM_PANEL_TAG, part.comm, &reqs[n_req++]);
+        MPI_Type_free(&dt);
+    }
+    MPI_Waitall(n_req, reqs, MPI_STATUSES_IGNORE);
+    free(reqs);
+    return GTM_SUCCESS;
+}
+
+void GTM_ringBcast(
+    void *buf, int count, MPI_Datatype datatype, int unit_size,
+    int seg_size, int root, int ring_size, MPI_Comm comm
+)
+{
+    int rank, nproc;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &nproc);
+    if ((ring_size <= 0) || (ring_size > nproc)) ring_size = nproc;
+    int rel = (rank - root + nproc) % nproc;
+    if ((ring_size == 1) || (count == 0) || (rel >= ring_size)) return;
+
+    int prev = (rank - 1 + nproc) % nproc;
+    int next = (rank + 1) % nproc;
+    int seg_cnt = seg_size / unit_size;
+    if (seg_cnt < 1) seg_cnt = 1;
+    int n_seg = (count + seg_cnt - 1) / seg_cnt;
+    MPI_Request *reqs = (MPI_Request*) malloc(sizeof(MPI_Request) * n_seg);
+    int n_req = 0;
+    for (int k = 0; k < n_seg; k++)
+    {
+        int cnt = (k == n_seg - 1) ? (count - k * seg_cnt) : seg_cnt;
+        char *ptr = (char*) buf + (size_t) k * (size_t) seg_cnt * (size_t) unit_size;
+        if (rel > 0) MPI_Recv(ptr, cnt, datatype, prev, GTM_PANEL_TAG, comm, MPI_STATUS_IGNORE);
+        if (reqs == NULL)
+        {
+            // No request array, forward each segment with a blocking send
+            if (rel < ring_size - 1) MPI_Send(ptr, cnt, datatype, next, GTM_PANEL_TAG, comm);
+            continue;
+        }
+        if (rel < ring_size - 1) MPI_Isend(ptr, cnt, datatype, next, GTM_PANEL_TAG, comm, &reqs[n_req++]);
+    }
+    MPI_Waitall(n_req, reqs, MPI_STATUSES_IGNORE);
+    free(reqs);
+}
+
+// Pipelined reduction along the ring root + 1 -> root + 2 -> ... -> root - 1 -> root
+static int GTM_reducePanel(
+    GTMatrix_t gtm, int is_col_panel, int start, int num, void *buf, int buf_ld, MPI_Op op
+)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    if ((op == MPI_REPLACE) || (GTM_checkUpdateOp(gtm, op) != GTM_SUCCESS)) return GTM_INVALID_OP;
+    GTM_Panel_Part part;
+    int ret = GTM_initPanelPart(gtm, is_col_panel, start, num, &part);
+    if (ret != GTM_SUCCESS) return ret;
+    if (buf == NULL) return GTM_NULL_PTR;
+
+    int rank, nproc;
+    MPI_Comm_rank(part.comm, &rank);
+    MPI_Comm_size(part.comm, &nproc);
+    int rel  = (rank - part.root + nproc) % nproc;
+    int prev = (rank - 1 + nproc) % nproc;
+    int next = (rank + 1) % nproc;
+
+    // Segments are packed one after another in work, segments in flight are not overwritten
+    size_t unit_size = (size_t) gtm->unit_size;
+    size_t seg_size  = (size_t) part.seg_len * (size_t) (part.seg_rows ? part.pcols : part.prows);
+    void *work = GTM_allocBuffer((size_t) part.prows * (size_t) part.pcols * unit_size);
+    void *recv = GTM_allocBuffer(seg_size * unit_size);
+    MPI_Request *reqs = (MPI_Request*) malloc(sizeof(MPI_Request) * part.n_seg);
+    if ((work == NULL) || (recv == NULL) || (reqs == NULL))
+    {
+        GTM_freeBuffer(work);
+        GTM_freeBuffer(recv);
+        free(reqs);
+        return GTM_ALLOC_FAILED;
+    }
+
+    int n_req = 0;
+    char *seg = (char*) work;
+    for (int k = 0; k < part.n_seg; k++)
+    {
+        int r0, nr, c0, nc;
+        GTM_getPanelSegment(&part, k, &r0, &nr, &c0, &nc);
+        int cnt = nr * nc;
+        GTM_packPanelSegment(gtm, buf, buf_ld, r0, nr, c0, nc, seg);
+        if (rel < nproc - 1)
+        {
+            MPI_Recv(recv, cnt, gtm->datatype, next, GTM_PANEL_TAG, part.comm, MPI_STATUS_IGNORE);
+            MPI_Reduce_local(recv, seg, cnt, gtm->datatype, op);
+        }
+        if (rel > 0) MPI_Isend(seg, cnt, gtm->datatype, prev, GTM_PANEL_TAG, part.comm, &reqs[n_req++]);
+        else GTM_applyPanelSegment(gtm, &part, op, r0, nr, c0, nc, seg);
+        seg += (size_t) cnt * unit_size;
+    }
+    MPI_Waitall(n_req, reqs, MPI_STATUSES_IGNORE);
+    if (rel == 0)
+    {
+        GTM_stampTiles(
+            gtm, gtm->my_rank, gtm->r_displs[gtm->my_rowblk] + part.lrow_s, part.prows,
+            gtm->c_displs[gtm->my_colblk] + part.lcol_s, part.pcols
+        );
+    }
+
+    GTM_freeBuffer(work);
+    GTM_freeBuffer(recv);
+    free(reqs);
+    return GTM_SUCCESS;
+}
+
+int GTM_bcastColPanel(GTMatrix_t gtm, int col_start, int col_num, void *buf, int buf_ld)
+{
+    return GTM_bcastPanel(gtm, 1, col_start, col_num, buf, buf_ld);
+}
+
+int GTM_bcastRowPanel(GTMatrix_t gtm, int row_start, int row_num, void *buf, int buf_ld)
+{
+    return GTM_bcastPanel(gtm, 0, row_start, row_num, buf, buf_ld);
+}
+
+int GTM_reduceColPanel(GTMatrix_t gtm, int col_start, int col_num, void *buf, int buf_ld, MPI_Op op)
+{
+    return GTM_reducePanel(gtm, 1, col_start, col_num, buf, buf_ld, op);
+}
+
+int GTM_reduceRowPanel(GTMatrix_t gtm, int row_start, int row_num, void *buf, int buf_ld, MPI_Op op)
+{
+    return GTM_reducePanel(gtm, 0, row_start, row_num, buf, buf_ld, op);
+}
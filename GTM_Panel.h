@@ -0,0 +1,81 @@
+#ifndef __GTM_PANEL_H__
+#define __GTM_PANEL_H__
+
+#include <mpi.h>
+#include "GTMatrix_Typedef.h"
+
+// Panel collectives on the r_blocks * c_blocks process grid for SUMMA-like and
+// Cholesky-like algorithms. A column panel is columns [col_start, col_start + col_num)
+// inside one column block, a row panel is rows [row_start, row_start + row_num)
+// inside one row block. A column panel is broadcast / reduced in each process row
+// (gtm->row_comm), a row panel in each process column (gtm->col_comm): each process
+// sends or receives only the part of the panel in its own row / column block.
+// The data is sent along a ring of the process row / column in segments of
+// gtm->panel_seg_size bytes (env GTM_PANEL_SEG_SIZE, default GTM_PANEL_SEG_SIZE),
+// so the segments are pipelined. User buffers use the buffer layout set by
+// GTM_setBufferLayout(). Symmetric storage is not supported.
+
+#define GTM_PANEL_TAG  0x5041  // MPI tag of panel messages
+
+// Get the process row and column communicators of a GTMatrix. Rank i in row_comm
+// is the process in column block i, rank i in col_comm is the process in row block i.
+// The communicators are created at the first call of this function or a panel
+// collective, and freed by GTM_destroy().
+// This call is collective on the first call, not thread-safe
+// Output parameters:
+//   *row_comm : Processes in the same process row, can be NULL
+//   *col_comm : Processes in the same process column, can be NULL
+int GTM_getGridComms(GTMatrix_t gtm, MPI_Comm *row_comm, MPI_Comm *col_comm);
+
+// Broadcast a column panel in each process row: the process in the column block
+// of the panel sends A(its rows, col_start : col_start + col_num - 1), i.e. the
+// published version of its part of the panel
+// This call is collective, not thread-safe
+// Input parameters:
+//   gtm       : GTMatrix handle
+//   col_start : 1st column of the panel
+//   col_num   : Number of columns of the panel
+//   buf_ld    : Leading dimension of buf
+// Output parameter:
+//   buf : Size >= my_nrows * col_num, the part of the panel in my row block
+int GTM_bcastColPanel(GTMatrix_t gtm, int col_start, int col_num, void *buf, int buf_ld);
+
+// Broadcast a row panel in each process column, the same as GTM_bcastColPanel()
+// Output parameter:
+//   buf : Size >= row_num * my_ncols, the part of the panel in my column block
+int GTM_bcastRowPanel(GTMatrix_t gtm, int row_start, int row_num, void *buf, int buf_ld);
+
+// Reduce a column panel in each process row: each process contributes a
+// my_nrows * col_num block, the contributions are combined with op and the
+// result R is applied to the process in the column block of the panel as
+// A(its rows, col_start : col_start + col_num - 1) = op(A, R), the write
+// version is updated. Call GTM_sync() before it if the matrix has been updated
+// with RMA operations, the update is visible to other processes after the next
+// synchronization.
+// This call is collective, not thread-safe
+// Input parameters:
+//   gtm       : GTMatrix handle
+//   col_start : 1st column of the panel
+//   col_num   : Number of columns of the panel
+//   buf       : Size >= my_nrows * col_num, contribution of this process
+//   buf_ld    : Leading dimension of buf
+//   op        : Predefined MPI operation that GTM_updateBlockOp() accepts
+//               except MPI_REPLACE, otherwise GTM_INVALID_OP is returned
+int GTM_reduceColPanel(GTMatrix_t gtm, int col_start, int col_num, void *buf, int buf_ld, MPI_Op op);
+
+// Reduce a row panel in each process column, the same as GTM_reduceColPanel(),
+// buf is a row_num * my_ncols block
+int GTM_reduceRowPanel(GTMatrix_t gtm, int row_start, int row_num, void *buf, int buf_ld, MPI_Op op);
+
+// ========== Below are internal helper functions ========== //
+
+// Pipelined broadcast of a contiguous buffer along the first ring_size processes
+// of the ring root -> root + 1 -> ... -> root - 1 of comm in segments of at most 
+// seg_size bytes, ring_size <= 0 means all processes in comm. Processes not on 
+// the ring return at once.
+void GTM_ringBcast(
+    void *buf, int count, MPI_Datatype datatype, int unit_size,
+    int seg_size, int root, int ring_size, MPI_Comm comm
+);
+
+#endif
@@ -0,0 +1,350 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix_Retval.h"
+#include "GTMatrix_Typedef.h"
+#include "GTMatrix_Other.h"
+#include "GTMatrix_Update.h"
+#include "GTMatrix_Track.h"
+#include "GTM_Plan.h"
+#include "utils.h"
+
+// Pieces of a coalesced transfer being built
+struct GTM_Plan_Run
+{
+    int n_piece, max_piece;      // Number of pieces and capacity
+    MPI_Aint *src_addrs;         // Absolute address of each piece in the user buffer
+    MPI_Aint *dst_displs;        // Byte displacement of each piece in the local block version
+    MPI_Datatype *src_dts;       // Origin data type of each piece
+    MPI_Datatype *dst_dts;       // Target data type of each piece
+    int *blklens;                // All 1
+    int n_req;                   // Number of requests in this run
+    int *req_ids;                // Requests in this run, for the overlap check
+};
+
+static int GTM_pushPlanRunPiece(struct GTM_Plan_Run *run)
+{
+    if (run->n_piece < run->max_piece) return GTM_SUCCESS;
+    int new_max = (run->max_piece == 0) ? 16 : run->max_piece * 2;
+    MPI_Aint *src_addrs      = (MPI_Aint*)     realloc(run->src_addrs,  sizeof(MPI_Aint)     * new_max);
+    if (src_addrs  != NULL) run->src_addrs  = src_addrs;
+    MPI_Aint *dst_displs     = (MPI_Aint*)     realloc(run->dst_displs, sizeof(MPI_Aint)     * new_max);
+    if (dst_displs != NULL) run->dst_displs = dst_displs;
+    MPI_Datatype *src_dts    = (MPI_Datatype*) realloc(run->src_dts,    sizeof(MPI_Datatype) * new_max);
+    if (src_dts    != NULL) run->src_dts    = src_dts;
+    MPI_Datatype *dst_dts    = (MPI_Datatype*) realloc(run->dst_dts,    sizeof(MPI_Datatype) * new_max);
+    if (dst_dts    != NULL) run->dst_dts    = dst_dts;
+    int *blklens             = (int*)          realloc(run->blklens,    sizeof(int)          * new_max);
+    if (blklens    != NULL) run->blklens    = blklens;
+    if ((src_addrs == NULL) || (dst_displs == NULL) || (src_dts == NULL) ||
+        (dst_dts == NULL) || (blklens == NULL)) return GTM_ALLOC_FAILED;
+    run->max_piece = new_max;
+    return GTM_SUCCESS;
+}
+
+// Add the pieces of a request inside each tile of the target to a run. The
+// data types of a piece traverse the piece row by row in the storage frame.
+static int GTM_addPlanRunReq(GTM_Plan_t plan, struct GTM_Plan_Run *run, int req_id)
+{
+    GTMatrix_t gtm = plan->gtm;
+    struct GTM_Plan_Req *req = &plan->reqs[req_id];
+    int dst_rowblk = req->dst_rank / gtm->c_blocks;
+    int dst_colblk = req->dst_rank % gtm->c_blocks;
+    int dst_lrow   = req->row_start - gtm->r_displs[dst_rowblk];
+    int dst_lcol   = req->col_start - gtm->c_displs[dst_colblk];
+    int dst_blk_ld = GTM_LOCAL_LD(gtm);
+    int src_buf_ld = req->src_buf_ld;
+    for (int r0 = 0, nr; r0 < req->row_num; r0 += nr)
+    {
+        nr = GTM_TILE_SPAN(gtm, dst_lrow + r0, req->row_num - r0);
+        for (int c0 = 0, nc; c0 < req->col_num; c0 += nc)
+        {
+            nc = GTM_TILE_SPAN(gtm, dst_lcol + c0, req->col_num - c0);
+            int ret = GTM_pushPlanRunPiece(run);
+            if (ret != GTM_SUCCESS) return ret;
+
+            size_t src_offset = req->trans ? ((size_t) c0 * (size_t) src_buf_ld + (size_t) r0) :
+                                             ((size_t) r0 * (size_t) src_buf_ld + (size_t) c0);
+            size_t dst_pos    = GTM_LOCAL_OFFSET(gtm, dst_lrow + r0, dst_lcol + c0);
+            char *src_ptr     = (char*) req->src_buf + src_offset * gtm->unit_size;
+
+            // Column-major storage: access the transposed piece of the storage frame
+            int s_trans = gtm->col_major ? (1 - req->trans) : req->trans;
+            int s_nr    = gtm->col_major ? nc : nr;
+            int s_nc    = gtm->col_major ? nr : nc;
+
+            int i = run->n_piece;
+            MPI_Get_address(src_ptr, &run->src_addrs[i]);
+            run->dst_displs[i] = (MPI_Aint) dst_pos * (MPI_Aint) gtm->unit_size;
+            run->blklens[i]    = 1;
+            if (s_trans == 0)
+            {
+                MPI_Type_vector(s_nr, s_nc, dst_blk_ld, gtm->datatype, &run->dst_dts[i]);
+                MPI_Type_vector(s_nr, s_nc, src_buf_ld, gtm->datatype, &run->src_dts[i]);
+                MPI_Type_commit(&run->dst_dts[i]);
+            } else {
+                // The user buffer holds the transpose, the target data type
+                // traverses the target piece column by column
+                GTM_createTransBlockType(gtm, s_nr, s_nc, dst_blk_ld, &run->dst_dts[i]);
+                MPI_Type_vector(s_nc, s_nr, src_buf_ld, gtm->datatype, &run->src_dts[i]);
+            }
+            MPI_Type_commit(&run->src_dts[i]);
+            run->n_piece++;
+        }
+    }
+    run->req_ids[run->n_req++] = req_id;
+    return GTM_SUCCESS;
+}
+
+// Check if the target block of a request overlaps with a request in a run
+static int GTM_overlapPlanRun(GTM_Plan_t plan, struct GTM_Plan_Run *run, int req_id)
+{
+    struct GTM_Plan_Req *req = &plan->reqs[req_id];
+    for (int k = 0; k < run->n_req; k++)
+    {
+        struct GTM_Plan_Req *rk = &plan->reqs[run->req_ids[k]];
+        int overlap, r_s, r_e, c_s, c_e;
+        getRectIntersection(
+            rk->row_start,  rk->row_start  + rk->row_num  - 1,
+            rk->col_start,  rk->col_start  + rk->col_num  - 1,
+            req->row_start, req->row_start + req->row_num - 1,
+            req->col_start, req->col_start + req->col_num - 1,
+            &overlap, &r_s, &r_e, &c_s, &c_e
+        );
+        if (overlap) return 1;
+    }
+    return 0;
+}
+
+// Coalesce all pieces of a run into one transfer
+static void GTM_flushPlanRun(GTM_Plan_t plan, struct GTM_Plan_Run *run, MPI_Op op)
+{
+    if (run->n_piece == 0) return;
+    struct GTM_Plan_Xfer *xfer = &plan->xfers[plan->n_xfer++];
+    xfer->op     = op;
+    xfer->req_id = -1;
+    MPI_Type_create_struct(run->n_piece, run->blklens, run->src_addrs,  run->src_dts, &xfer->src_dt);
+    MPI_Type_create_struct(run->n_piece, run->blklens, run->dst_displs, run->dst_dts, &xfer->dst_dt);
+    MPI_Type_commit(&xfer->src_dt);
+    MPI_Type_commit(&xfer->dst_dt);
+    for (int i = 0; i < run->n_piece; i++)
+    {
+        MPI_Type_free(&run->src_dts[i]);
+        MPI_Type_free(&run->dst_dts[i]);
+    }
+    run->n_piece = 0;
+    run->n_req   = 0;
+}
+
+// Build the transfers of target i, requests are already grouped by operation
+static int GTM_buildPlanTarget(GTM_Plan_t plan, int i, struct GTM_Plan_Run *run)
+{
+    plan->xfer_displs[i] = plan->n_xfer;
+    MPI_Op run_op = MPI_NO_OP;
+    for (int req_id = plan->req_displs[i]; req_id < plan->req_displs[i + 1]; req_id++)
+    {
+        struct GTM_Plan_Req *req = &plan->reqs[req_id];
+        if ((req->op != run_op) || req->scaled || GTM_overlapPlanRun(plan, run, req_id))
+            GTM_flushPlanRun(plan, run, run_op);
+        run_op = req->op;
+        if (req->scaled)
+        {
+            // Scaled accumulation is staged at execution, see GTM_updateBlockToProcess()
+            struct GTM_Plan_Xfer *xfer = &plan->xfers[plan->n_xfer++];
+            xfer->op     = req->op;
+            xfer->req_id = req_id;
+            xfer->src_dt = MPI_DATATYPE_NULL;
+            xfer->dst_dt = MPI_DATATYPE_NULL;
+            continue;
+        }
+        int ret = GTM_addPlanRunReq(plan, run, req_id);
+        if (ret != GTM_SUCCESS) return ret;
+    }
+    GTM_flushPlanRun(plan, run, run_op);
+    plan->xfer_displs[i + 1] = plan->n_xfer;
+    return GTM_SUCCESS;
+}
+
+int GTM_createPlan(GTM_Plan_t *_plan, GTMatrix_t gtm)
+{
+    if ((_plan == NULL) || (gtm == NULL)) return GTM_NULL_PTR;
+    int is_get;
+    if (gtm->in_batch_get) is_get = 1;
+    else if (gtm->in_batch_acc) is_get = 0;
+    else return GTM_NO_BATCHED_GET;
+    if (gtm->symm_storage && (MPI_C_DOUBLE_COMPLEX == gtm->datatype)) return GTM_INVALID_FLAGS;
+    // Requests on temporary source buffers would not follow later changes of the user buffers
+    if ((is_get == 0) && (gtm->n_tmp_buf > 0)) return GTM_INVALID_FLAGS;
+
+    GTM_Plan_t plan = (GTM_Plan_t) malloc(sizeof(struct GTM_Plan));
+    if (plan == NULL) return GTM_ALLOC_FAILED;
+    int n_req = 0;
+    for (int i = 0; i < gtm->comm_size; i++) n_req += gtm->req_vec[i]->curr_size;
+    plan->gtm          = gtm;
+    plan->is_get       = is_get;
+    plan->n_req        = n_req;
+    plan->n_xfer       = 0;
+    plan->n_target     = 0;
+    plan->target_ranks = (int*) malloc(sizeof(int) * gtm->comm_size);
+    plan->req_displs   = (int*) malloc(sizeof(int) * (gtm->comm_size + 1));
+    plan->xfer_displs  = (int*) malloc(sizeof(int) * (gtm->comm_size + 1));
+    plan->reqs  = (struct GTM_Plan_Req*)  malloc(sizeof(struct GTM_Plan_Req)  * MAX(n_req, 1));
+    plan->xfers = (struct GTM_Plan_Xfer*) malloc(sizeof(struct GTM_Plan_Xfer) * MAX(n_req, 1));
+    if ((plan->target_ranks == NULL) || (plan->req_displs == NULL) ||
+        (plan->xfer_displs == NULL) || (plan->reqs == NULL) || (plan->xfers == NULL))
+    {
+        plan->n_req = 0;
+        GTM_destroyPlan(plan);
+        return GTM_ALLOC_FAILED;
+    }
+
+    // Copy the queued requests in batch execution order: targets starting
+    // from this process, requests grouped by operation (see GTM_execBatchUpdate())
+    int cnt = 0;
+    plan->req_displs[0] = 0;
+    for (int _dst_rank = gtm->my_rank; _dst_rank < gtm->comm_size + gtm->my_rank; _dst_rank++)
+    {
+        int dst_rank = _dst_rank % gtm->comm_size;
+        GTM_Req_Vector_t req_vec = gtm->req_vec[dst_rank];
+        if (req_vec->curr_size == 0) continue;
+        for (int g = 0; g < req_vec->curr_size; g++)
+        {
+            // Request g starts a new group if its op has not been copied
+            MPI_Op op = req_vec->ops[g];
+            int new_group = 1;
+            for (int k = 0; k < g; k++)
+                if (req_vec->ops[k] == op) new_group = 0;
+            if (new_group == 0) continue;
+            for (int i = g; i < req_vec->curr_size; i++)
+            {
+                if (req_vec->ops[i] != op) continue;
+                struct GTM_Plan_Req *req = &plan->reqs[cnt++];
+                req->dst_rank   = dst_rank;
+                req->op         = op;
+                req->row_start  = req_vec->row_starts[i];
+                req->row_num    = req_vec->row_nums[i];
+                req->col_start  = req_vec->col_starts[i];
+                req->col_num    = req_vec->col_nums[i];
+                req->src_buf    = req_vec->src_bufs[i];
+                req->src_buf_ld = req_vec->src_buf_lds[i];
+                req->trans      = req_vec->trans[i];
+                req->scaled     = req_vec->scaled[i];
+                memcpy(req->alpha, req_vec->alphas + i * GTM_RV_ALPHA_SIZE, GTM_RV_ALPHA_SIZE);
+            }
+        }
+        plan->target_ranks[plan->n_target] = dst_rank;
+        plan->req_displs[++plan->n_target] = cnt;
+        GTM_resetReqVector(req_vec);
+    }
+
+    // Build the coalesced transfers of each target
+    struct GTM_Plan_Run run;
+    memset(&run, 0, sizeof(struct GTM_Plan_Run));
+    run.req_ids = (int*) malloc(sizeof(int) * MAX(n_req, 1));
+    int ret = (run.req_ids == NULL) ? GTM_ALLOC_FAILED : GTM_SUCCESS;
+    plan->xfer_displs[0] = 0;
+    for (int i = 0; i < plan->n_target; i++)
+    {
+        if (ret == GTM_SUCCESS) ret = GTM_buildPlanTarget(plan, i, &run);
+    }
+    free(run.src_addrs);
+    free(run.dst_displs);
+    free(run.src_dts);
+    free(run.dst_dts);
+    free(run.blklens);
+    free(run.req_ids);
+    if (ret != GTM_SUCCESS)
+    {
+        GTM_destroyPlan(plan);
+        return ret;
+    }
+
+    *_plan = plan;
+    return GTM_SUCCESS;
+}
+
+int GTM_executePlan(GTM_Plan_t plan)
+{
+    if (plan == NULL) return GTM_NULL_PTR;
+    GTMatrix_t gtm = plan->gtm;
+    for (int i = 0; i < plan->n_target; i++)
+    {
+        int dst_rank  = plan->target_ranks[i];
+        int use_rlock = (plan->is_get == 0) && (gtm->region_lock != NULL);
+        if (use_rlock)
+        {
+            for (int k = plan->req_displs[i]; k < plan->req_displs[i + 1]; k++)
+            {
+                struct GTM_Plan_Req *req = &plan->reqs[k];
+                GTM_markLockTiles(gtm, dst_rank, req->row_start, req->row_num, req->col_start, req->col_num);
+            }
+            GTM_acquireLockTiles(gtm, dst_rank);
+        }
+
+        int ret = GTM_SUCCESS;
+        int lock_type = plan->is_get ? MPI_LOCK_SHARED : gtm->acc_lock_type;
+        MPI_Win_lock(lock_type, dst_rank, 0, gtm->mpi_win);
+        for (int k = plan->xfer_displs[i]; k < plan->xfer_displs[i + 1]; k++)
+        {
+            struct GTM_Plan_Xfer *xfer = &plan->xfers[k];
+            if (xfer->req_id >= 0)
+            {
+                struct GTM_Plan_Req *req = &plan->reqs[xfer->req_id];
+                ret = GTM_updateBlockToProcess(
+                    gtm, dst_rank, req->op, req->row_start, req->row_num, req->col_start,
+                    req->col_num, req->src_buf, req->src_buf_ld, req->trans, req->alpha
+                );
+                if (ret != GTM_SUCCESS) break;
+                continue;
+            }
+            if (plan->is_get)
+            {
+                MPI_Get(
+                    MPI_BOTTOM, 1, xfer->src_dt, dst_rank,
+                    (MPI_Aint) gtm->rd_offset, 1, xfer->dst_dt, gtm->mpi_win
+                );
+            } else {
+                MPI_Accumulate(
+                    MPI_BOTTOM, 1, xfer->src_dt, dst_rank,
+                    (MPI_Aint) gtm->wr_offset, 1, xfer->dst_dt, xfer->op, gtm->mpi_win
+                );
+            }
+        }
+        MPI_Win_unlock(dst_rank, gtm->mpi_win);
+        if (use_rlock) GTM_releaseLockTiles(gtm, dst_rank);
+        if (ret != GTM_SUCCESS) return ret;
+
+        if (plan->is_get) continue;
+        for (int k = plan->req_displs[i]; k < plan->req_displs[i + 1]; k++)
+        {
+            struct GTM_Plan_Req *req = &plan->reqs[k];
+            if (req->scaled) continue;  // Counted and stamped by GTM_updateBlockToProcess()
+            GTM_ADD_TOUCHED(gtm, dst_rank, 1);
+            GTM_stampTiles(gtm, dst_rank, req->row_start, req->row_num, req->col_start, req->col_num);
+        }
+    }
+    return GTM_SUCCESS;
+}
+
+int GTM_destroyPlan(GTM_Plan_t plan)
+{
+    if (plan == NULL) return GTM_NULL_PTR;
+    if (plan->xfers != NULL)
+    {
+        for (int k = 0; k < plan->n_xfer; k++)
+        {
+            if (plan->xfers[k].req_id >= 0) continue;
+            MPI_Type_free(&plan->xfers[k].src_dt);
+            MPI_Type_free(&plan->xfers[k].dst_dt);
+        }
+    }
+    free(plan->target_ranks);
+    free(plan->req_displs);
+    free(plan->xfer_displs);
+    free(plan->reqs);
+    free(plan->xfers);
+    free(plan);
+    return GTM_SUCCESS;
+}
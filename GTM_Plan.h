@@ -0,0 +1,78 @@
+#ifndef __GTM_PLAN_H__
+#define __GTM_PLAN_H__
+
+#include <mpi.h>
+#include "GTMatrix_Typedef.h"
+#include "GTM_Req_Vector.h"
+
+// Persistent access plan: a batch of get or update requests recorded once
+// and replayed many times. When a plan is created, the requests are already
+// split by target process, each request piece is split by tiles, and the
+// pieces to the same target with the same operation are coalesced into one
+// MPI_Get / MPI_Accumulate with committed struct data types, as long as their
+// target blocks do not overlap. Replaying a plan only posts these RMA operations.
+struct GTM_Plan_Req
+{
+    int dst_rank;                // Target process
+    MPI_Op op;                   // Update operation, MPI_NO_OP for get
+    int row_start, row_num;      // Rows of the request piece in the global matrix
+    int col_start, col_num;      // Columns of the request piece in the global matrix
+    void *src_buf;               // User buffer of the piece
+    int src_buf_ld, trans;       // Leading dimension of src_buf, if src_buf holds the transpose
+    int scaled;                  // If the piece has a scaling factor in alpha
+    char alpha[GTM_RV_ALPHA_SIZE]; // Scaling factor
+};
+
+struct GTM_Plan_Xfer
+{
+    MPI_Op op;                   // Update operation, MPI_NO_OP for get
+    int req_id;                  // Scaled request executed with staging, -1 for a coalesced transfer
+    MPI_Datatype src_dt;         // Origin data type, absolute addresses (used with MPI_BOTTOM)
+    MPI_Datatype dst_dt;         // Target data type, relative to the current version of the local block
+};
+
+struct GTM_Plan
+{
+    GTMatrix_t gtm;              // GTMatrix of the plan
+    int is_get;                  // If the plan contains get requests, otherwise update requests
+    int n_req, n_xfer;           // Number of request pieces and transfers
+    int n_target;                // Number of target processes
+    int *target_ranks;           // Target processes, in the same order as batch execution
+    int *req_displs;             // Request pieces of target i are reqs[req_displs[i] : req_displs[i+1]-1]
+    int *xfer_displs;            // Transfers of target i are xfers[xfer_displs[i] : xfer_displs[i+1]-1]
+    struct GTM_Plan_Req  *reqs;  // Request pieces
+    struct GTM_Plan_Xfer *xfers; // Transfers
+};
+
+typedef struct GTM_Plan* GTM_Plan_t;
+
+// Create a persistent plan from the requests queued in the current batch get
+// (GTM_startBatchGet()) or batch put / accumulate epoch of a GTMatrix, instead
+// of executing them. The request queues are emptied, the batch epoch should
+// still be stopped with GTM_stopBatchGet() / GTM_stopBatchPut() / GTM_stopBatchAcc().
+// Buffer addresses are recorded: all buffers of the requests must stay valid
+// at the same addresses while the plan is used, their contents can change.
+// Not supported for double _Complex with symmetric storage (returns
+// GTM_INVALID_FLAGS), since these requests are not queued in batch mode.
+// Real symmetric storage requests are queued like any other request, 
+// pieces on the diagonal of a diagonal process block are queued row by row.
+// Requests queued from temporary source buffers (GTM_addAccBlockSymRequest() on 
+// diagonal blocks, with symmetric storage or double _Complex) are not 
+// supported either (returns GTM_INVALID_FLAGS).
+// This call is not collective, not thread-safe
+// Output parameter:
+//   *_plan : Pointer to the created GTM_Plan structure
+int GTM_createPlan(GTM_Plan_t *_plan, GTMatrix_t gtm);
+
+// Execute all requests of a plan, the same as GTM_execBatchGet() /
+// GTM_execBatchPut() / GTM_execBatchAcc() on the recorded requests. Get
+// plans read the published version, update plans write the write version.
+// Blocking call, all accesses are finished when function returns
+// This call is not collective, not thread-safe
+int GTM_executePlan(GTM_Plan_t plan);
+
+// Free a GTM_Plan structure and its data types
+// This call is not collective, thread-safe
+int GTM_destroyPlan(GTM_Plan_t plan);
+
+#endif
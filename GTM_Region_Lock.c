@@ -0,0 +1,143 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <mpi.h>
+
+#include "GTMatrix_Retval.h"
+#include "GTM_Region_Lock.h"
+#include "utils.h"
+
+#define GTM_RL_NIL  -1
+
+// Window displacements of lock tail, queue node next pointer and blocked flag
+#define GTM_RL_TAIL(gtrl, id)     (id)
+#define GTM_RL_NEXT(gtrl, id)     ((gtrl)->nlocks + (id))
+#define GTM_RL_BLOCKED(gtrl, id)  (2 * (gtrl)->nlocks + (id))
+
+int GTM_createRegionLock(GTM_Region_Lock_t *_gtrl, MPI_Comm comm, int nlocks)
+{
+    GTM_Region_Lock_t gtrl = (GTM_Region_Lock_t) malloc(sizeof(struct GTM_Region_Lock));
+    if (gtrl == NULL) return GTM_ALLOC_FAILED;
+
+    MPI_Comm_size(comm, &gtrl->comm_size);
+    MPI_Comm_rank(comm, &gtrl->my_rank);
+    MPI_Comm_dup (comm, &gtrl->mpi_comm);
+    if (nlocks < 1) nlocks = 1;
+    MPI_Allreduce(&nlocks, &gtrl->nlocks, 1, MPI_INT, MPI_MAX, gtrl->mpi_comm);
+
+    MPI_Aint win_msize = (MPI_Aint) INT_SIZE * (MPI_Aint) gtrl->nlocks * 3;
+    MPI_Win_allocate(
+        win_msize, INT_SIZE, MPI_INFO_NULL, gtrl->mpi_comm,
+        &gtrl->win_buf, &gtrl->mpi_win
+    );
+    for (int i = 0; i < gtrl->nlocks; i++)
+    {
+        gtrl->win_buf[GTM_RL_TAIL(gtrl, i)]    = GTM_RL_NIL;
+        gtrl->win_buf[GTM_RL_NEXT(gtrl, i)]    = GTM_RL_NIL;
+        gtrl->win_buf[GTM_RL_BLOCKED(gtrl, i)] = 0;
+    }
+    // All lock operations are done in a single passive target epoch
+    MPI_Win_lock_all(0, gtrl->mpi_win);
+    MPI_Barrier(gtrl->mpi_comm);
+
+    *_gtrl = gtrl;
+    return GTM_SUCCESS;
+}
+
+int GTM_destroyRegionLock(GTM_Region_Lock_t gtrl)
+{
+    if (gtrl == NULL) return GTM_NULL_PTR;
+    MPI_Win_unlock_all(gtrl->mpi_win);
+    MPI_Win_free(&gtrl->mpi_win);
+    MPI_Comm_free(&gtrl->mpi_comm);
+    free(gtrl);
+    return GTM_SUCCESS;
+}
+
+// Atomically read an int in the lock window
+static int GTM_readLockWin(GTM_Region_Lock_t gtrl, int rank, int disp)
+{
+    int val, dummy = 0;
+    MPI_Fetch_and_op(&dummy, &val, MPI_INT, rank, disp, MPI_NO_OP, gtrl->mpi_win);
+    MPI_Win_flush(rank, gtrl->mpi_win);
+    return val;
+}
+
+// Atomically write an int in the lock window
+static void GTM_writeLockWin(GTM_Region_Lock_t gtrl, int rank, int disp, int val)
+{
+    MPI_Accumulate(&val, 1, MPI_INT, rank, disp, 1, MPI_INT, MPI_REPLACE, gtrl->mpi_win);
+    MPI_Win_flush(rank, gtrl->mpi_win);
+}
+
+int GTM_acquireRegionLock(GTM_Region_Lock_t gtrl, int dst_rank, int lock_id)
+{
+    if (gtrl == NULL) return GTM_NULL_PTR;
+    if ((dst_rank < 0) || (dst_rank >= gtrl->comm_size) ||
+        (lock_id  < 0) || (lock_id  >= gtrl->nlocks)) return GTM_INVALID_BLOCK;
+
+    int my_rank = gtrl->my_rank;
+    int me = my_rank * gtrl->nlocks + lock_id;
+
+    // Initialize my queue node, then append it to the lock's queue
+    GTM_writeLockWin(gtrl, my_rank, GTM_RL_NEXT(gtrl, lock_id), GTM_RL_NIL);
+    GTM_writeLockWin(gtrl, my_rank, GTM_RL_BLOCKED(gtrl, lock_id), 1);
+    int pred;
+    MPI_Fetch_and_op(&me, &pred, MPI_INT, dst_rank, GTM_RL_TAIL(gtrl, lock_id), MPI_REPLACE, gtrl->mpi_win);
+    MPI_Win_flush(dst_rank, gtrl->mpi_win);
+    if (pred == GTM_RL_NIL) return GTM_SUCCESS;
+
+    // Lock is held, link to the predecessor and wait for its hand-over
+    int pred_rank = pred / gtrl->nlocks;
+    int pred_id   = pred % gtrl->nlocks;
+    GTM_writeLockWin(gtrl, pred_rank, GTM_RL_NEXT(gtrl, pred_id), me);
+    while (GTM_readLockWin(gtrl, my_rank, GTM_RL_BLOCKED(gtrl, lock_id)) == 1);
+    return GTM_SUCCESS;
+}
+
+int GTM_tryAcquireRegionLock(GTM_Region_Lock_t gtrl, int dst_rank, int lock_id, int *acquired)
+{
+    if ((gtrl == NULL) || (acquired == NULL)) return GTM_NULL_PTR;
+    if ((dst_rank < 0) || (dst_rank >= gtrl->comm_size) ||
+        (lock_id  < 0) || (lock_id  >= gtrl->nlocks)) return GTM_INVALID_BLOCK;
+
+    int my_rank = gtrl->my_rank;
+    int me = my_rank * gtrl->nlocks + lock_id;
+
+    // Only enqueue if the queue is empty, no one will link to my node otherwise
+    GTM_writeLockWin(gtrl, my_rank, GTM_RL_NEXT(gtrl, lock_id), GTM_RL_NIL);
+    int nil = GTM_RL_NIL, curr;
+    MPI_Compare_and_swap(&me, &nil, &curr, MPI_INT, dst_rank, GTM_RL_TAIL(gtrl, lock_id), gtrl->mpi_win);
+    MPI_Win_flush(dst_rank, gtrl->mpi_win);
+    *acquired = (curr == GTM_RL_NIL) ? 1 : 0;
+    return GTM_SUCCESS;
+}
+
+int GTM_releaseRegionLock(GTM_Region_Lock_t gtrl, int dst_rank, int lock_id)
+{
+    if (gtrl == NULL) return GTM_NULL_PTR;
+    if ((dst_rank < 0) || (dst_rank >= gtrl->comm_size) ||
+        (lock_id  < 0) || (lock_id  >= gtrl->nlocks)) return GTM_INVALID_BLOCK;
+
+    int my_rank = gtrl->my_rank;
+    int me = my_rank * gtrl->nlocks + lock_id;
+
+    int next = GTM_readLockWin(gtrl, my_rank, GTM_RL_NEXT(gtrl, lock_id));
+    if (next == GTM_RL_NIL)
+    {
+        // No known successor, try to reset the tail to nil
+        int nil = GTM_RL_NIL, curr;
+        MPI_Compare_and_swap(&nil, &me, &curr, MPI_INT, dst_rank, GTM_RL_TAIL(gtrl, lock_id), gtrl->mpi_win);
+        MPI_Win_flush(dst_rank, gtrl->mpi_win);
+        if (curr == me) return GTM_SUCCESS;
+        // A successor is linking itself to my node, wait for it
+        do {
+            next = GTM_readLockWin(gtrl, my_rank, GTM_RL_NEXT(gtrl, lock_id));
+        } while (next == GTM_RL_NIL);
+    }
+
+    // Hand the lock over to the successor
+    GTM_writeLockWin(gtrl, next / gtrl->nlocks, GTM_RL_BLOCKED(gtrl, next % gtrl->nlocks), 0);
+    return GTM_SUCCESS;
+}
@@ -0,0 +1,49 @@
+#ifndef __GTM_REGION_LOCK_H__
+#define __GTM_REGION_LOCK_H__
+
+#include <mpi.h>
+
+// Distributed MCS queue locks. Each process hosts nlocks locks (for example, one
+// lock for each tile of its local matrix block). A lock is a tail pointer on the
+// host process, each waiting process spins on a flag in its own queue node, so
+// waiting processes do not generate remote traffic and the lock is handed over
+// in FIFO order. A process can hold several locks on the same host process at
+// the same time, queue node i of a process is used for the i-th lock of the host.
+struct GTM_Region_Lock
+{
+    MPI_Comm mpi_comm;      // Target communicator
+    MPI_Win  mpi_win;       // MPI window for lock tails and queue nodes
+    int *win_buf;           // Window buffer: tails[nlocks], next[nlocks], blocked[nlocks]
+    int nlocks;             // Number of locks on each process
+    int my_rank, comm_size; // Rank of this process and number of process in the global communicator
+};
+
+typedef struct GTM_Region_Lock* GTM_Region_Lock_t;
+
+// Create and initialize a GTM_Region_Lock structure, all locks are free
+// This call is collective, thread-safe
+// Input parameters:
+//   comm   : MPI communicator used in this distributed lock array
+//   nlocks : Number of locks on each process, the maximum of all processes is used
+// Output parameter:
+//   *_gtrl : Pointer to the created GTM_Region_Lock structure
+int GTM_createRegionLock(GTM_Region_Lock_t *_gtrl, MPI_Comm comm, int nlocks);
+
+// Free a GTM_Region_Lock structure, all locks should be released
+// This call is collective, thread-safe
+int GTM_destroyRegionLock(GTM_Region_Lock_t gtrl);
+
+// Acquire / release lock lock_id on process dst_rank
+// To avoid deadlock, a process holding several locks should acquire them in
+// ascending order of (dst_rank, lock_id).
+// This call is not collective, not thread-safe
+int GTM_acquireRegionLock(GTM_Region_Lock_t gtrl, int dst_rank, int lock_id);
+int GTM_releaseRegionLock(GTM_Region_Lock_t gtrl, int dst_rank, int lock_id);
+
+// Try to acquire lock lock_id on process dst_rank without waiting
+// This call is not collective, not thread-safe
+// Output parameter:
+//   *acquired : 1 if the lock is acquired, 0 if the lock is held by others
+int GTM_tryAcquireRegionLock(GTM_Region_Lock_t gtrl, int dst_rank, int lock_id, int *acquired);
+
+#endif
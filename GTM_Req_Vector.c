@@ -21,9 +21,14 @@ int GTM_createReqVector(GTM_Req_Vector_t *gtm_rv_)
     gtm_rv->src_bufs    = (void**)  malloc(gtm_rv->max_size * sizeof(void*));
     gtm_rv->src_buf_lds = (int*)    malloc(gtm_rv->max_size * sizeof(int));
     gtm_rv->ops         = (MPI_Op*) malloc(gtm_rv->max_size * sizeof(MPI_Op));
+    gtm_rv->trans       = (int*)    malloc(gtm_rv->max_size * sizeof(int));
+    gtm_rv->scaled      = (int*)    malloc(gtm_rv->max_size * sizeof(int));
+    gtm_rv->alphas      = (char*)   malloc(gtm_rv->max_size * GTM_RV_ALPHA_SIZE);
     if ((gtm_rv->row_starts == NULL) || (gtm_rv->row_nums == NULL) || 
         (gtm_rv->col_starts == NULL) || (gtm_rv->col_nums == NULL) || 
-        (gtm_rv->src_bufs   == NULL) || (gtm_rv->src_buf_lds == NULL) || (gtm_rv->ops == NULL))
+        (gtm_rv->src_bufs   == NULL) || (gtm_rv->src_buf_lds == NULL) || 
+        (gtm_rv->ops        == NULL) || (gtm_rv->trans == NULL) ||
+        (gtm_rv->scaled     == NULL) || (gtm_rv->alphas == NULL))
     {
         return GTM_RV_ALLOC_FAILED;
     }
@@ -36,7 +41,7 @@ int GTM_pushToReqVector(
     GTM_Req_Vector_t gtm_rv, MPI_Op op, 
     int row_start, int row_num,
     int col_start, int col_num,
-    void *src_buf, int src_buf_ld
+    void *src_buf, int src_buf_ld, int trans
 )
 {
     if (gtm_rv == NULL) return GTM_RV_NULL_PTR;
@@ -51,8 +56,12 @@ int GTM_pushToReqVector(
         void **src_bufs  = (void**)  malloc(gtm_rv->max_size * 2 * sizeof(void*));
         int *src_buf_lds = (int*)    malloc(gtm_rv->max_size * 2 * sizeof(int));
         MPI_Op *ops      = (MPI_Op*) malloc(gtm_rv->max_size * 2 * sizeof(MPI_Op));
+        int *trans_      = (int*)    malloc(gtm_rv->max_size * 2 * sizeof(int));
+        int *scaled      = (int*)    malloc(gtm_rv->max_size * 2 * sizeof(int));
+        char *alphas     = (char*)   malloc(gtm_rv->max_size * 2 * GTM_RV_ALPHA_SIZE);
         if ((row_starts == NULL) || (row_nums == NULL) || (col_starts == NULL) ||
-            (col_nums == NULL) || (src_bufs == NULL) || (src_buf_lds == NULL) || (ops == NULL))
+            (col_nums == NULL) || (src_bufs == NULL) || (src_buf_lds == NULL) || 
+            (ops == NULL) || (trans_ == NULL) || (scaled == NULL) || (alphas == NULL))
         {
             return GTM_RV_RESIZE_FAILED;
         }
@@ -64,6 +73,9 @@ int GTM_pushToReqVector(
         memcpy(src_bufs,    gtm_rv->src_bufs,    gtm_rv->max_size * sizeof(void*));
         memcpy(src_buf_lds, gtm_rv->src_buf_lds, gtm_rv->max_size * sizeof(int));
         memcpy(ops,         gtm_rv->ops,         gtm_rv->max_size * sizeof(MPI_Op));
+        memcpy(trans_,      gtm_rv->trans,       gtm_rv->max_size * sizeof(int));
+        memcpy(scaled,      gtm_rv->scaled,      gtm_rv->max_size * sizeof(int));
+        memcpy(alphas,      gtm_rv->alphas,      gtm_rv->max_size * GTM_RV_ALPHA_SIZE);
         
         gtm_rv->max_size *= 2;
         
@@ -74,6 +86,9 @@ int GTM_pushToReqVector(
         free(gtm_rv->src_bufs);
         free(gtm_rv->src_buf_lds);
         free(gtm_rv->ops);
+        free(gtm_rv->trans);
+        free(gtm_rv->scaled);
+        free(gtm_rv->alphas);
         
         gtm_rv->row_starts  = row_starts;
         gtm_rv->row_nums    = row_nums;
@@ -82,6 +97,9 @@ int GTM_pushToReqVector(
         gtm_rv->src_bufs    = src_bufs;
         gtm_rv->src_buf_lds = src_buf_lds;
         gtm_rv->ops         = ops;
+        gtm_rv->trans       = trans_;
+        gtm_rv->scaled      = scaled;
+        gtm_rv->alphas      = alphas;
     }
     
     int idx = gtm_rv->curr_size;
@@ -92,10 +110,22 @@ int GTM_pushToReqVector(
     gtm_rv->src_bufs[idx]    = src_buf;
     gtm_rv->src_buf_lds[idx] = src_buf_ld;
     gtm_rv->ops[idx]         = op;
+    gtm_rv->trans[idx]       = trans;
+    gtm_rv->scaled[idx]      = 0;
     gtm_rv->curr_size++;
     return GTM_RV_SUCCESS;
 }
 
+int GTM_setReqVectorAlpha(GTM_Req_Vector_t gtm_rv, void *alpha, int alpha_size)
+{
+    if (gtm_rv == NULL) return GTM_RV_NULL_PTR;
+    if ((gtm_rv->curr_size == 0) || (alpha_size > GTM_RV_ALPHA_SIZE)) return GTM_RV_INVALID_REQ;
+    int idx = gtm_rv->curr_size - 1;
+    memcpy(gtm_rv->alphas + idx * GTM_RV_ALPHA_SIZE, alpha, alpha_size);
+    gtm_rv->scaled[idx] = 1;
+    return GTM_RV_SUCCESS;
+}
+
 int GTM_resetReqVector(GTM_Req_Vector_t gtm_rv)
 {
     if (gtm_rv == NULL) return GTM_RV_NULL_PTR;
@@ -113,6 +143,9 @@ int GTM_destroyReqVector(GTM_Req_Vector_t gtm_rv)
     free(gtm_rv->src_bufs);
     free(gtm_rv->src_buf_lds);
     free(gtm_rv->ops);
+    free(gtm_rv->trans);
+    free(gtm_rv->scaled);
+    free(gtm_rv->alphas);
     free(gtm_rv);
     return GTM_RV_SUCCESS;
 }
\ No newline at end of file
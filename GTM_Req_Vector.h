@@ -10,12 +10,16 @@ struct GTM_Req_Vector
     void **src_bufs;
     int *src_buf_lds;
     MPI_Op *ops;
+    int *trans;
+    int *scaled;      // If the request has a scaling factor in alphas
+    char *alphas;     // Scaling factor of each request, GTM_RV_ALPHA_SIZE bytes each
     int curr_size, max_size;
 };
 
 typedef struct GTM_Req_Vector* GTM_Req_Vector_t;
 
 #define DEFAULT_REQ_VEC_LEN 128
+#define GTM_RV_ALPHA_SIZE   16  // Large enough for double _Complex
 
 int GTM_createReqVector(GTM_Req_Vector_t *gtm_rv_);
 
@@ -23,9 +27,12 @@ int GTM_pushToReqVector(
     GTM_Req_Vector_t gtm_rv, MPI_Op op, 
     int row_start, int row_num,
     int col_start, int col_num,
-    void *src_buf, int src_buf_ld
+    void *src_buf, int src_buf_ld, int trans
 );
 
+// Set the scaling factor of the last pushed request, alpha_size <= GTM_RV_ALPHA_SIZE
+int GTM_setReqVectorAlpha(GTM_Req_Vector_t gtm_rv, void *alpha, int alpha_size);
+
 int GTM_resetReqVector(GTM_Req_Vector_t gtm_rv);
 
 int GTM_destroyReqVector(GTM_Req_Vector_t gtm_rv);
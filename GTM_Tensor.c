@@ -0,0 +1,218 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix_Retval.h"
+#include "GTMatrix_Typedef.h"
+#include "GTMatrix_Other.h"
+#include "GTM_Tensor.h"
+#include "utils.h"
+
+int GTM_createTensor(
+    GTM_Tensor_t *_gtt, MPI_Comm comm, MPI_Datatype datatype,
+    int unit_size, int my_rank, int ndim0, int nrows, int ncols,
+    int r_blocks, int c_blocks, int *r_displs, int *c_displs
+)
+{
+    // Validate process info before allocating anything
+    int comm_size;
+    MPI_Comm_size(comm, &comm_size);
+    if ((my_rank < 0) || (my_rank >= comm_size)) return GTM_INVALID_RANK;
+    if (r_blocks * c_blocks != comm_size) return GTM_INVALID_RCBLOCK;
+    if (ndim0 <= 0) return GTM_INVALID_BLOCK;
+
+    GTM_Tensor_t gtt = (GTM_Tensor_t) malloc(sizeof(struct GTM_Tensor));
+    if (gtt == NULL) return GTM_ALLOC_FAILED;
+
+    // Copy tensor and process info
+    MPI_Comm_dup(comm, &gtt->mpi_comm);
+    gtt->datatype  = datatype;
+    gtt->unit_size = unit_size;
+    gtt->my_rank   = my_rank;
+    gtt->comm_size = comm_size;
+    gtt->ndim0     = ndim0;
+    gtt->nrows     = nrows;
+    gtt->ncols     = ncols;
+    gtt->r_blocks  = r_blocks;
+    gtt->c_blocks  = c_blocks;
+    gtt->my_rowblk = my_rank / c_blocks;
+    gtt->my_colblk = my_rank % c_blocks;
+
+    // Copy and validate the partition, generate r_blklens and c_blklens
+    int ret = GTM_copyPartition(
+        nrows, ncols, r_blocks, c_blocks, r_displs, c_displs,
+        &gtt->r_displs, &gtt->r_blklens, &gtt->c_displs, &gtt->c_blklens
+    );
+    if (ret != GTM_SUCCESS)
+    {
+        MPI_Comm_free(&gtt->mpi_comm);
+        free(gtt);
+        return ret;
+    }
+    gtt->my_nrows = gtt->r_blklens[gtt->my_rowblk];
+    gtt->my_ncols = gtt->c_blklens[gtt->my_colblk];
+
+    // Allocate local blocks of all k and bind them to one MPI window
+    MPI_Aint ten_msize = (MPI_Aint) ndim0 * (MPI_Aint) gtt->my_nrows * (MPI_Aint) gtt->my_ncols * (MPI_Aint) unit_size;
+    gtt->ten_block = malloc(ten_msize);
+    if (gtt->ten_block == NULL) return GTM_ALLOC_FAILED;
+    memset(gtt->ten_block, 0, ten_msize);
+
+    MPI_Info mpi_info;
+    MPI_Info_create(&mpi_info);
+    MPI_Win_create(gtt->ten_block, ten_msize, unit_size, mpi_info, gtt->mpi_comm, &gtt->mpi_win);
+    MPI_Info_free(&mpi_info);
+
+    *_gtt = gtt;
+    return GTM_SUCCESS;
+}
+
+int GTM_destroyTensor(GTM_Tensor_t gtt)
+{
+    if (gtt == NULL) return GTM_NULL_PTR;
+
+    MPI_Win_free(&gtt->mpi_win);
+    MPI_Comm_free(&gtt->mpi_comm);
+
+    free(gtt->r_displs);
+    free(gtt->r_blklens);
+    free(gtt->c_displs);
+    free(gtt->c_blklens);
+    free(gtt->ten_block);
+    free(gtt);
+
+    return GTM_SUCCESS;
+}
+
+int GTM_fillTensor(GTM_Tensor_t gtt, void *value)
+{
+    if (gtt == NULL) return GTM_NULL_PTR;
+    if (value == NULL) return GTM_NULL_PTR;
+    size_t nelem = (size_t) gtt->ndim0 * (size_t) gtt->my_nrows * (size_t) gtt->my_ncols;
+    char *ptr = (char*) gtt->ten_block;
+    for (size_t i = 0; i < nelem; i++)
+        memcpy(ptr + i * gtt->unit_size, value, gtt->unit_size);
+    return GTM_SUCCESS;
+}
+
+int GTM_syncTensor(GTM_Tensor_t gtt)
+{
+    if (gtt == NULL) return GTM_NULL_PTR;
+    // Each access completes at target when it returns, only need to wait others
+    MPI_Barrier(gtt->mpi_comm);
+    return GTM_SUCCESS;
+}
+
+// Build a datatype for k_num slices of a row_num * col_num rectangle, rows of
+// a slice are ld elements apart and slices are kstride elements apart
+static void GTM_createBoxType(
+    GTM_Tensor_t gtt, int k_num, int row_num, int col_num,
+    int ld, size_t kstride, MPI_Datatype *box_dt
+)
+{
+    MPI_Datatype slice_dt;
+    MPI_Type_vector(row_num, col_num, ld, gtt->datatype, &slice_dt);
+    MPI_Aint kstride_bytes = (MPI_Aint) kstride * (MPI_Aint) gtt->unit_size;
+    MPI_Type_create_hvector(k_num, 1, kstride_bytes, slice_dt, box_dt);
+    MPI_Type_commit(box_dt);
+    MPI_Type_free(&slice_dt);
+}
+
+// Get or update (put, accumulate) a 3D box in the tensor, each process
+// that owns a part of the box is accessed by a single RMA operation
+// Input parameters:
+//   gtt  : GTM_Tensor handle
+//   op   : MPI_NO_OP (get), MPI_REPLACE (put) or MPI_SUM (accumulate)
+//   Others are the same as GTM_getTensorBox()
+static int GTM_accessTensorBox(
+    GTM_Tensor_t gtt, MPI_Op op, int k0, int k_num, int row_start, int row_num,
+    int col_start, int col_num, void *src_buf, int src_buf_ld, int src_buf_kstride
+)
+{
+    if (gtt == NULL) return GTM_NULL_PTR;
+    if (src_buf == NULL) return GTM_NULL_PTR;
+    if (src_buf_ld < col_num) return GTM_INVALID_SRC_LD;
+    if ((size_t) src_buf_kstride < (size_t) row_num * (size_t) src_buf_ld) return GTM_INVALID_SRC_LD;
+    if ((k0 < 0) || (row_start < 0) || (col_start < 0) ||
+        (k0 + k_num > gtt->ndim0) ||
+        (row_start + row_num > gtt->nrows) ||
+        (col_start + col_num > gtt->ncols) ||
+        (k_num <= 0) || (row_num <= 0) || (col_num <= 0)) return GTM_INVALID_BLOCK;
+
+    int row_end = row_start + row_num - 1;
+    int col_end = col_start + col_num - 1;
+    int unit_size = gtt->unit_size;
+    for (int blk_r = 0; blk_r < gtt->r_blocks; blk_r++)
+    {
+        int dst_r_s = gtt->r_displs[blk_r];
+        int dst_r_e = gtt->r_displs[blk_r + 1] - 1;
+        if ((dst_r_e < row_start) || (dst_r_s > row_end)) continue;
+        for (int blk_c = 0; blk_c < gtt->c_blocks; blk_c++)
+        {
+            int dst_c_s = gtt->c_displs[blk_c];
+            int dst_c_e = gtt->c_displs[blk_c + 1] - 1;
+            if ((dst_c_e < col_start) || (dst_c_s > col_end)) continue;
+
+            // Intersection of the box and the process block
+            int dst_rank  = blk_r * gtt->c_blocks + blk_c;
+            int dst_nrows = gtt->r_blklens[blk_r];
+            int dst_ncols = gtt->c_blklens[blk_c];
+            int r_s = MAX(row_start, dst_r_s), r_e = MIN(row_end, dst_r_e);
+            int c_s = MAX(col_start, dst_c_s), c_e = MIN(col_end, dst_c_e);
+            int nrow = r_e - r_s + 1, ncol = c_e - c_s + 1;
+
+            size_t dst_kstride = (size_t) dst_nrows * (size_t) dst_ncols;
+            MPI_Aint dst_pos = (MPI_Aint) k0 * (MPI_Aint) dst_kstride;
+            dst_pos += (MPI_Aint) (r_s - dst_r_s) * (MPI_Aint) dst_ncols + (MPI_Aint) (c_s - dst_c_s);
+            size_t buf_offset = (size_t) (r_s - row_start) * (size_t) src_buf_ld + (size_t) (c_s - col_start);
+            char *buf_ptr = (char*) src_buf + buf_offset * unit_size;
+
+            MPI_Datatype dst_dt, buf_dt;
+            GTM_createBoxType(gtt, k_num, nrow, ncol, dst_ncols,  dst_kstride,     &dst_dt);
+            GTM_createBoxType(gtt, k_num, nrow, ncol, src_buf_ld, src_buf_kstride, &buf_dt);
+            MPI_Win_lock(MPI_LOCK_SHARED, dst_rank, 0, gtt->mpi_win);
+            if (op == MPI_NO_OP)
+                MPI_Get(buf_ptr, 1, buf_dt, dst_rank, dst_pos, 1, dst_dt, gtt->mpi_win);
+            else
+                MPI_Accumulate(buf_ptr, 1, buf_dt, dst_rank, dst_pos, 1, dst_dt, op, gtt->mpi_win);
+            MPI_Win_unlock(dst_rank, gtt->mpi_win);
+            MPI_Type_free(&dst_dt);
+            MPI_Type_free(&buf_dt);
+        }
+    }
+    return GTM_SUCCESS;
+}
+
+int GTM_getTensorBox(
+    GTM_Tensor_t gtt, int k0, int k_num, int row_start, int row_num,
+    int col_start, int col_num, void *src_buf, int src_buf_ld, int src_buf_kstride
+)
+{
+    return GTM_accessTensorBox(
+        gtt, MPI_NO_OP, k0, k_num, row_start, row_num,
+        col_start, col_num, src_buf, src_buf_ld, src_buf_kstride
+    );
+}
+
+int GTM_putTensorBox(
+    GTM_Tensor_t gtt, int k0, int k_num, int row_start, int row_num,
+    int col_start, int col_num, void *src_buf, int src_buf_ld, int src_buf_kstride
+)
+{
+    return GTM_accessTensorBox(
+        gtt, MPI_REPLACE, k0, k_num, row_start, row_num,
+        col_start, col_num, src_buf, src_buf_ld, src_buf_kstride
+    );
+}
+
+int GTM_accTensorBox(
+    GTM_Tensor_t gtt, int k0, int k_num, int row_start, int row_num,
+    int col_start, int col_num, void *src_buf, int src_buf_ld, int src_buf_kstride
+)
+{
+    return GTM_accessTensorBox(
+        gtt, MPI_SUM, k0, k_num, row_start, row_num,
+        col_start, col_num, src_buf, src_buf_ld, src_buf_kstride
+    );
+}
@@ -0,0 +1,102 @@
+#ifndef __GTM_TENSOR_H__
+#define __GTM_TENSOR_H__
+
+#include <mpi.h>
+
+// Distributed 3D tensor T(k, i, j), 0 <= k < ndim0, a batch of ndim0 matrices
+// with the same size. The two trailing dimensions (i, j) use the same 2D
+// checkerboard partition as GTMatrix, the leading dimension k is not
+// partitioned. Each process stores its ndim0 local blocks contiguously in one
+// MPI window: local block k is a row-major my_nrows * my_ncols matrix starting
+// at element k * my_nrows * my_ncols. A 3D box access transfers all slices of
+// the box on a process with a single RMA operation.
+struct GTM_Tensor
+{
+    // MPI components
+    MPI_Comm mpi_comm;           // Target communicator
+    MPI_Win  mpi_win;            // MPI window for local blocks
+    MPI_Datatype datatype;       // Tensor data type
+
+    // Tensor size and partition, trailing dimensions are the same as GTMatrix
+    int ndim0;                   // Size of the leading dimension
+    int nrows, ncols;            // Size of the two trailing dimensions
+    int r_blocks,  c_blocks;     // Number of blocks on row and column directions, r_blocks * c_blocks == comm_size
+    int my_rowblk, my_colblk;    // Which row & column block this process is
+    int my_nrows,  my_ncols;     // How many row & column local block has
+    int *r_displs, *r_blklens;   // Displacements and length of each block on row direction
+    int *c_displs, *c_blklens;   // Displacements and length of each block on column direction
+    int unit_size;               // Size of tensor data type, unit is byte
+    int my_rank, comm_size;      // Rank of this process and number of process in the global communicator
+
+    // Local storage
+    void *ten_block;             // Size ndim0 * my_nrows * my_ncols, local blocks of all k
+};
+
+typedef struct GTM_Tensor* GTM_Tensor_t;
+
+// Create and initialize a GTM_Tensor structure
+// This call is collective, thread-safe
+// Input parameters:
+//   comm      : MPI communicator used in this distributed tensor
+//   datatype  : Tensor data type
+//   unit_size : Size of tensor data type, unit is byte
+//   my_rank   : MPI Rank of this process
+//   ndim0     : Size of the leading dimension
+//   nrows     : Number of rows in each matrix
+//   ncols     : Number of columns in each matrix
+//   r_blocks  : Number of blocks on row direction
+//   c_blocks  : Number of blocks on column direction
+//   *r_displs : Row direction displacement array, nrows+1 elements
+//   *c_displs : Column direction displacement array, ncols+1 elements
+// Output parameter:
+//   *_gtt : Pointer to the created GTM_Tensor structure
+int GTM_createTensor(
+    GTM_Tensor_t *_gtt, MPI_Comm comm, MPI_Datatype datatype,
+    int unit_size, int my_rank, int ndim0, int nrows, int ncols,
+    int r_blocks, int c_blocks, int *r_displs, int *c_displs
+);
+
+// Free a GTM_Tensor structure
+// This call is collective, thread-safe
+int GTM_destroyTensor(GTM_Tensor_t gtt);
+
+// Set all elements of the local blocks to the same value
+// This call is not collective, not thread-safe
+int GTM_fillTensor(GTM_Tensor_t gtt, void *value);
+
+// Synchronize: wait all processes to finish their get / put / accumulate
+// This call is collective, not thread-safe
+int GTM_syncTensor(GTM_Tensor_t gtt);
+
+// Get a 3D box T(k0:k0+k_num-1, row_start:row_start+row_num-1,
+// col_start:col_start+col_num-1). src_buf is row-major: element (k, i, j) of
+// the box is src_buf[k * src_buf_kstride + i * src_buf_ld + j].
+// Blocking call, not collective, not thread-safe
+// Input parameters:
+//   k0, k_num        : 1st index and number of indices on the leading dimension
+//   row_start        : 1st row of the box
+//   row_num          : Number of rows the box has
+//   col_start        : 1st column of the box
+//   col_num          : Number of columns the box has
+//   src_buf_ld       : Leading dimension of each slice in src_buf, >= col_num
+//   src_buf_kstride  : Distance between slices in src_buf, >= row_num * src_buf_ld
+// Output parameter:
+//   *src_buf : Receive buffer
+int GTM_getTensorBox(
+    GTM_Tensor_t gtt, int k0, int k_num, int row_start, int row_num,
+    int col_start, int col_num, void *src_buf, int src_buf_ld, int src_buf_kstride
+);
+
+// Put / accumulate a 3D box to the tensor, parameters are the same as
+// GTM_getTensorBox(), src_buf is the source buffer
+// Blocking call, not collective, not thread-safe
+int GTM_putTensorBox(
+    GTM_Tensor_t gtt, int k0, int k_num, int row_start, int row_num,
+    int col_start, int col_num, void *src_buf, int src_buf_ld, int src_buf_kstride
+);
+int GTM_accTensorBox(
+    GTM_Tensor_t gtt, int k0, int k_num, int row_start, int row_num,
+    int col_start, int col_num, void *src_buf, int src_buf_ld, int src_buf_kstride
+);
+
+#endif
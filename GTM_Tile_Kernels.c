@@ -0,0 +1,139 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "GTM_Tile_Kernels.h"
+
+// Dot product of two contiguous vectors
+static inline double GTM_tileDot(int n, const double *restrict x, const double *restrict y)
+{
+    double res = 0.0;
+    for (int p = 0; p < n; p++) res += x[p] * y[p];
+    return res;
+}
+
+// y += alpha * x, x and y are contiguous
+static inline void GTM_tileAxpy(int n, double alpha, const double *restrict x, double *restrict y)
+{
+    for (int p = 0; p < n; p++) y[p] += alpha * x[p];
+}
+
+int GTM_tilePotrfL(int n, double *A, int lda)
+{
+    for (int j = 0; j < n; j++)
+    {
+        double *A_j = A + j * lda;
+        double d = A_j[j] - GTM_tileDot(j, A_j, A_j);
+        if (d <= 0.0) return j + 1;
+        d = sqrt(d);
+        A_j[j] = d;
+        double inv_d = 1.0 / d;
+        for (int i = j + 1; i < n; i++)
+        {
+            double *A_i = A + i * lda;
+            A_i[j] = (A_i[j] - GTM_tileDot(j, A_i, A_j)) * inv_d;
+        }
+    }
+    return 0;
+}
+
+void GTM_tileTrsmRLT(int m, int n, const double *L, int ldl, double *B, int ldb)
+{
+    // Each row of X is solved independently by forward substitution
+    for (int i = 0; i < m; i++)
+    {
+        double *B_i = B + i * ldb;
+        for (int j = 0; j < n; j++)
+        {
+            const double *L_j = L + j * ldl;
+            B_i[j] = (B_i[j] - GTM_tileDot(j, B_i, L_j)) / L_j[j];
+        }
+    }
+}
+
+void GTM_tileTrsmLLN(int m, int n, const double *L, int ldl, double *B, int ldb)
+{
+    // Forward substitution on rows of B
+    for (int i = 0; i < m; i++)
+    {
+        const double *L_i = L + i * ldl;
+        double *B_i = B + i * ldb;
+        for (int p = 0; p < i; p++) GTM_tileAxpy(n, -L_i[p], B + p * ldb, B_i);
+        double inv_d = 1.0 / L_i[i];
+        for (int j = 0; j < n; j++) B_i[j] *= inv_d;
+    }
+}
+
+void GTM_tileTrsmLLT(int m, int n, const double *L, int ldl, double *B, int ldb)
+{
+    // Backward substitution on rows of B, row i of L is column i of L^T
+    for (int i = m - 1; i >= 0; i--)
+    {
+        const double *L_i = L + i * ldl;
+        double *B_i = B + i * ldb;
+        double inv_d = 1.0 / L_i[i];
+        for (int j = 0; j < n; j++) B_i[j] *= inv_d;
+        for (int p = 0; p < i; p++) GTM_tileAxpy(n, -L_i[p], B_i, B + p * ldb);
+    }
+}
+
+void GTM_tileGemmNT(
+    int m, int n, int k, double alpha, const double *A, int lda,
+    const double *B, int ldb, double beta, double *C, int ldc
+)
+{
+    for (int i = 0; i < m; i++)
+    {
+        const double *A_i = A + i * lda;
+        double *C_i = C + i * ldc;
+        for (int j = 0; j < n; j++)
+        {
+            double c = (beta == 0.0) ? 0.0 : beta * C_i[j];
+            C_i[j] = c + alpha * GTM_tileDot(k, A_i, B + j * ldb);
+        }
+    }
+}
+
+void GTM_tileGemmNN(
+    int m, int n, int k, double alpha, const double *A, int lda,
+    const double *B, int ldb, double *C, int ldc
+)
+{
+    for (int i = 0; i < m; i++)
+    {
+        const double *A_i = A + i * lda;
+        double *C_i = C + i * ldc;
+        for (int p = 0; p < k; p++) GTM_tileAxpy(n, alpha * A_i[p], B + p * ldb, C_i);
+    }
+}
+
+void GTM_tileGemmTN(
+    int m, int n, int k, double alpha, const double *A, int lda,
+    const double *B, int ldb, double *C, int ldc
+)
+{
+    for (int p = 0; p < k; p++)
+    {
+        const double *A_p = A + p * lda;
+        const double *B_p = B + p * ldb;
+        for (int i = 0; i < m; i++) GTM_tileAxpy(n, alpha * A_p[i], B_p, C + i * ldc);
+    }
+}
+
+void GTM_tileSyrkLN(
+    int n, int k, double alpha, const double *A, int lda,
+    double beta, double *C, int ldc
+)
+{
+    for (int i = 0; i < n; i++)
+    {
+        const double *A_i = A + i * lda;
+        double *C_i = C + i * ldc;
+        for (int j = 0; j <= i; j++)
+        {
+            double c = (beta == 0.0) ? 0.0 : beta * C_i[j];
+            C_i[j] = c + alpha * GTM_tileDot(k, A_i, A + j * lda);
+        }
+    }
+}
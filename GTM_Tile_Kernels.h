@@ -0,0 +1,61 @@
+#ifndef __GTM_TILE_KERNELS_H__
+#define __GTM_TILE_KERNELS_H__
+
+// Local dense kernels on row-major double tiles used by the distributed
+// factorization and solve routines. Only the operations the routines need are
+// provided, each inner loop runs over contiguous elements so it can be vectorized.
+// These are internal helper functions.
+
+// Cholesky factorization of the lower triangle, A = L * L^T, L overwrites the
+// lower triangle of A, the strict upper triangle is not referenced
+// Input parameters:
+//   n   : Size of A
+//   A   : Size >= n * lda
+//   lda : Leading dimension of A
+// Output parameter:
+//   @return : 0 if A is positive definite, otherwise j + 1 where j is the first
+//             column with a non-positive pivot
+int GTM_tilePotrfL(int n, double *A, int lda);
+
+// Solve X * L^T = B, X overwrites B, L is a n * n lower triangular tile
+// Input parameters:
+//   m, n : Size of B
+//   L    : Size >= n * ldl, only the lower triangle is referenced
+//   ldl  : Leading dimension of L
+//   ldb  : Leading dimension of B
+// Output parameter:
+//   B : Size >= m * ldb
+void GTM_tileTrsmRLT(int m, int n, const double *L, int ldl, double *B, int ldb);
+
+// Solve L * X = B, X overwrites B, L is a m * m lower triangular tile, B is m * n
+void GTM_tileTrsmLLN(int m, int n, const double *L, int ldl, double *B, int ldb);
+
+// Solve L^T * X = B, X overwrites B, L is a m * m lower triangular tile, B is m * n
+void GTM_tileTrsmLLT(int m, int n, const double *L, int ldl, double *B, int ldb);
+
+// C = alpha * A * B^T + beta * C, A is m * k, B is n * k, C is m * n
+void GTM_tileGemmNT(
+    int m, int n, int k, double alpha, const double *A, int lda,
+    const double *B, int ldb, double beta, double *C, int ldc
+);
+
+// C += alpha * A * B, A is m * k, B is k * n, C is m * n
+void GTM_tileGemmNN(
+    int m, int n, int k, double alpha, const double *A, int lda,
+    const double *B, int ldb, double *C, int ldc
+);
+
+// C += alpha * A^T * B, A is k * m, B is k * n, C is m * n
+void GTM_tileGemmTN(
+    int m, int n, int k, double alpha, const double *A, int lda,
+    const double *B, int ldb, double *C, int ldc
+);
+
+// Lower triangle of C = alpha * A * A^T + beta * C, A is n * k, the strict upper
+// triangle of C is not referenced
+void GTM_tileSyrkLN(
+    int n, int k, double alpha, const double *A, int lda,
+    double beta, double *C, int ldc
+);
+
+#endif
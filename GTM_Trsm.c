@@ -0,0 +1,218 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix_Retval.h"
+#include "GTMatrix_Typedef.h"
+#include "GTMatrix_Get.h"
+#include "GTMatrix_Other.h"
+#include "GTMatrix_Track.h"
+#include "GTM_Panel.h"
+#include "GTM_Buffer.h"
+#include "GTM_Tile_Kernels.h"
+#include "GTM_Trsm.h"
+#include "utils.h"
+
+// Split [0, n) into panels of at most nb columns that do not cross row or column
+// block boundaries of L, return the number of panels, panel p is
+// [displs[p], displs[p + 1])
+static int GTM_trsmPanels(GTMatrix_t L, int nb, int *displs)
+{
+    int n = L->nrows, n_panel = 0;
+    displs[0] = 0;
+    for (int s = 0; s < n; )
+    {
+        int e  = MIN(s + nb, n);
+        int rb = GTM_findBlockIndex(L->r_displs, L->r_blocks, s);
+        int cb = GTM_findBlockIndex(L->c_displs, L->c_blocks, s);
+        e = MIN(e, L->r_displs[rb + 1]);
+        e = MIN(e, L->c_displs[cb + 1]);
+        displs[++n_panel] = e;
+        s = e;
+    }
+    return n_panel;
+}
+
+// Solve on the rows of this process: W holds rows [r_displs[my_rowblk],
+// r_displs[my_rowblk] + my_nrows) of the right-hand sides of this process
+// column, row-major with leading dimension ncols_w
+static int GTM_trsmLocal(GTMatrix_t L, int trans, double *W, int ncols_w, int nb)
+{
+    int n = L->nrows, m = L->my_nrows;
+    int row_s = L->r_displs[L->my_rowblk];
+    int *displs  = (int*)    malloc(sizeof(int) * (n / nb + L->r_blocks + L->c_blocks + 2));
+    double *Lbuf = (double*) GTM_allocBuffer(sizeof(double) * (size_t) m * (size_t) nb);
+    double *xbuf = (double*) GTM_allocBuffer(sizeof(double) * (size_t) nb * (size_t) MAX(ncols_w, 1));
+    if ((displs == NULL) || (Lbuf == NULL) || (xbuf == NULL))
+    {
+        free(displs);
+        GTM_freeBuffer(Lbuf);
+        GTM_freeBuffer(xbuf);
+        return GTM_ALLOC_FAILED;
+    }
+    int n_panel = GTM_trsmPanels(L, nb, displs);
+    GTM_getGridComms(L, NULL, NULL);
+
+    // Panel buffers are row-major
+    int col_major_buf = L->col_major_buf;
+    L->col_major_buf = 0;
+
+    for (int step = 0; step < n_panel; step++)
+    {
+        // Forward substitution for L * X = B, backward substitution for L^T * X = B
+        int p  = trans ? (n_panel - 1 - step) : step;
+        int s  = displs[p];
+        int w  = displs[p + 1] - s;
+        int rb = GTM_findBlockIndex(L->r_displs, L->r_blocks, s);
+        int lr = s - row_s;
+        double *X = xbuf;
+        if (trans == 0)
+        {
+            // Process rows above the panel hold zeros of L and rows of X solved 
+            // already, they do not take part in this step
+            if (L->my_rowblk < rb) continue;
+            // Lbuf = L(my rows, panel), m * w
+            GTM_bcastColPanel(L, s, w, Lbuf, w);
+            if (L->my_rowblk == rb)
+            {
+                X = W + (size_t) lr * (size_t) ncols_w;
+                GTM_tileTrsmLLN(w, ncols_w, Lbuf + (size_t) lr * (size_t) w, w, X, ncols_w);
+            }
+            // X only goes down to process rows rb, ..., r_blocks - 1
+            GTM_ringBcast(
+                X, w * ncols_w, MPI_DOUBLE, sizeof(double), L->panel_seg_size, 
+                rb, L->r_blocks - rb, L->col_comm
+            );
+            // Rows below the panel: B -= L(rows, panel) * X
+            int lb = (L->my_rowblk == rb) ? (lr + w) : 0;
+            GTM_tileGemmNN(
+                m - lb, ncols_w, w, -1.0, Lbuf + (size_t) lb * (size_t) w, w,
+                X, ncols_w, W + (size_t) lb * (size_t) ncols_w, ncols_w
+            );
+        } else {
+            // Lbuf = L(panel, my rows up to the panel), w * nl with leading dimension m,
+            // the same for all processes in a process row: one process of the row 
+            // fetches it and broadcasts it in the process row
+            int nl = MIN(m, s + w - row_s);
+            if (nl > 0)
+            {
+                int fetch_colblk = p % L->c_blocks;
+                if (L->my_colblk == fetch_colblk) GTM_getBlock(L, s, w, row_s, nl, Lbuf, m);
+                GTM_ringBcast(
+                    Lbuf, (w - 1) * m + nl, MPI_DOUBLE, sizeof(double), 
+                    L->panel_seg_size, fetch_colblk, 0, L->row_comm
+                );
+            }
+            if (L->my_rowblk == rb)
+            {
+                X = W + (size_t) lr * (size_t) ncols_w;
+                GTM_tileTrsmLLT(w, ncols_w, Lbuf + lr, m, X, ncols_w);
+            }
+            GTM_ringBcast(X, w * ncols_w, MPI_DOUBLE, sizeof(double), L->panel_seg_size, rb, 0, L->col_comm);
+            // Rows above the panel: B -= L(panel, rows)^T * X
+            int nu = (L->my_rowblk == rb) ? lr : ((L->my_rowblk < rb) ? m : 0);
+            GTM_tileGemmTN(nu, ncols_w, w, -1.0, Lbuf, m, X, ncols_w, W, ncols_w);
+        }
+    }
+
+    L->col_major_buf = col_major_buf;
+    free(displs);
+    GTM_freeBuffer(Lbuf);
+    GTM_freeBuffer(xbuf);
+    return GTM_SUCCESS;
+}
+
+static int GTM_checkTrsmMatrix(GTMatrix_t L, int trans)
+{
+    if (L == NULL) return GTM_NULL_PTR;
+    if (L->nrows != L->ncols) return GTM_NOT_SQUARE_MAT;
+    if ((L->datatype != MPI_DOUBLE) || L->symm_storage) return GTM_INVALID_FLAGS;
+    if ((trans != 0) && (trans != 1)) return GTM_INVALID_FLAGS;
+    return GTM_SUCCESS;
+}
+
+// Copy the published version of the local block to a row-major buffer, or copy
+// a row-major buffer to the write version of the local block
+static void GTM_copyLocalBlock(GTMatrix_t gtm, double *W, int to_local)
+{
+    double *local = to_local ? (double*) GTM_getLocalWriteBlock(gtm) : (double*) gtm->mat_block + gtm->rd_offset;
+    int ncols = gtm->my_ncols;
+    for (int i = 0; i < gtm->my_nrows; i++)
+    {
+        double *W_i = W + (size_t) i * (size_t) ncols;
+        for (int j0 = 0, nj; j0 < ncols; j0 += nj)
+        {
+            nj = gtm->col_major ? 1 : GTM_TILE_SPAN(gtm, j0, ncols - j0);
+            double *ptr = local + GTM_LOCAL_OFFSET(gtm, i, j0);
+            if (to_local) memcpy(ptr, W_i + j0, sizeof(double) * nj);
+            else memcpy(W_i + j0, ptr, sizeof(double) * nj);
+        }
+    }
+}
+
+int GTM_trsm(GTMatrix_t L, int trans, GTMatrix_t B, int panel_size)
+{
+    int ret = GTM_checkTrsmMatrix(L, trans);
+    if (ret != GTM_SUCCESS) return ret;
+    if (B == NULL) return GTM_NULL_PTR;
+    if ((B->datatype != MPI_DOUBLE) || B->symm_storage || B->versioned) return GTM_INVALID_FLAGS;
+    if ((B->nrows != L->nrows) || (B->r_blocks != L->r_blocks) || (B->c_blocks != L->c_blocks)) return GTM_INVALID_R_DISPLS;
+    for (int i = 0; i <= L->r_blocks; i++)
+        if (B->r_displs[i] != L->r_displs[i]) return GTM_INVALID_R_DISPLS;
+
+    double *W = (double*) malloc(sizeof(double) * (size_t) B->my_nrows * (size_t) B->my_ncols);
+    if (W == NULL) return GTM_ALLOC_FAILED;
+    int nb = (panel_size > 0) ? panel_size : GTM_TRSM_PANEL_SIZE;
+    GTM_copyLocalBlock(B, W, 0);
+    ret = GTM_trsmLocal(L, trans, W, B->my_ncols, nb);
+    if (ret == GTM_SUCCESS)
+    {
+        GTM_copyLocalBlock(B, W, 1);
+        GTM_stampTiles(
+            B, B->my_rank, B->r_displs[B->my_rowblk], B->my_nrows,
+            B->c_displs[B->my_colblk], B->my_ncols
+        );
+    }
+    free(W);
+    GTM_sync(B);
+    return ret;
+}
+
+int GTM_trsmReplicated(GTMatrix_t L, int trans, int nrhs, double *B, int ldb, int panel_size)
+{
+    int ret = GTM_checkTrsmMatrix(L, trans);
+    if (ret != GTM_SUCCESS) return ret;
+    if (B == NULL) return GTM_NULL_PTR;
+
+    // Column chunk [c_s, c_s + nw) of this process column
+    int n     = L->nrows, m = L->my_nrows;
+    int row_s = L->r_displs[L->my_rowblk];
+    int c_s   = (int) ((long) nrhs * L->my_colblk / L->c_blocks);
+    int nw    = (int) ((long) nrhs * (L->my_colblk + 1) / L->c_blocks) - c_s;
+    double *W    = (double*) malloc(sizeof(double) * (size_t) m * (size_t) MAX(nw, 1));
+    double *full = (double*) calloc((size_t) n * (size_t) nrhs, sizeof(double));
+    if ((W == NULL) || (full == NULL))
+    {
+        free(W);
+        free(full);
+        return GTM_ALLOC_FAILED;
+    }
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < nw; j++)
+            W[i * nw + j] = B[GTM_BUF_OFFSET(L, ldb, row_s + i, c_s + j)];
+
+    int nb = (panel_size > 0) ? panel_size : GTM_TRSM_PANEL_SIZE;
+    ret = GTM_trsmLocal(L, trans, W, nw, nb);
+
+    // Each element of X is computed by exactly one process
+    for (int i = 0; i < m; i++)
+        memcpy(full + (size_t) (row_s + i) * (size_t) nrhs + c_s, W + i * nw, sizeof(double) * nw);
+    MPI_Allreduce(MPI_IN_PLACE, full, n * nrhs, MPI_DOUBLE, MPI_SUM, L->mpi_comm);
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < nrhs; j++)
+            B[GTM_BUF_OFFSET(L, ldb, i, j)] = full[(size_t) i * (size_t) nrhs + j];
+    free(W);
+    free(full);
+    return ret;
+}
@@ -0,0 +1,47 @@
+#ifndef __GTM_TRSM_H__
+#define __GTM_TRSM_H__
+
+#include <mpi.h>
+#include "GTMatrix_Typedef.h"
+
+// Triangular solves L * X = B or L^T * X = B with a distributed lower triangular
+// GTMatrix L (e.g. the factor of GTM_potrf()) and multiple right-hand sides.
+// L is traversed in panels of at most panel_size columns that do not cross block
+// boundaries. For each panel, each process row at or below the panel gets its
+// rows of the panel with the pipelined GTM_bcastColPanel() (L * X = B), or one
+// process of each process row gets the part of the panel rows the row needs 
+// with one GTM_getBlock() and broadcasts it in the process row (L^T * X = B). 
+// The process row holding the panel rows of B solves them with the diagonal 
+// tile, the solution is broadcast with a pipelined ring in each process column 
+// to the process rows that need it and they update their rows of B with local 
+// kernels. The strict upper triangle of L is not referenced.
+
+#define GTM_TRSM_PANEL_SIZE  64  // Default panel size of GTM_trsm()
+
+// Solve with a distributed right-hand side GTMatrix B, X overwrites B
+// This call is collective, not thread-safe
+// Input parameters:
+//   L          : Square GTMatrix, data type must be MPI_DOUBLE, symmetric storage
+//                is not supported (GTM_INVALID_FLAGS)
+//   trans      : 0 solves L * X = B, 1 solves L^T * X = B
+//   B          : GTMatrix with the same process grid and the same r_displs as L,
+//                data type must be MPI_DOUBLE, symmetric and versioned storage are
+//                not supported. Call GTM_sync() before it if B has been updated
+//                with RMA operations.
+//   panel_size : Panel size, <= 0 means GTM_TRSM_PANEL_SIZE
+int GTM_trsm(GTMatrix_t L, int trans, GTMatrix_t B, int panel_size);
+
+// Solve with a replicated right-hand side buffer, each process holds the same
+// B and gets the same X. Process column c solves the c-th of c_blocks column
+// chunks of B, the chunks are gathered on all processes at the end.
+// This call is collective, not thread-safe
+// Input parameters:
+//   L, trans, panel_size : Same as GTM_trsm()
+//   nrhs : Number of right-hand sides (columns of B)
+//   B    : Size >= nrows * ldb (nrhs * ldb for the column-major buffer layout of L)
+//   ldb  : Leading dimension of B
+// Output parameter:
+//   B : Solution X
+int GTM_trsmReplicated(GTMatrix_t L, int trans, int nrhs, double *B, int ldb, int panel_size);
+
+#endif
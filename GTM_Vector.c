@@ -0,0 +1,411 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <mpi.h>
+
+#include "GTMatrix_Retval.h"
+#include "GTMatrix_Typedef.h"
+#include "GTM_Vector.h"
+#include "GTM_Buffer.h"
+#include "utils.h"
+
+// Set up partition arrays and local storage, displs and seg_rank are filled
+static int GTM_initVector(GTM_Vector_t gtv)
+{
+    int valid = 1;
+    if (gtv->displs[0] != 0) valid = 0;
+    if (gtv->displs[gtv->nseg] != gtv->n) valid = 0;
+    for (int s = 0; s < gtv->nseg; s++)
+    {
+        if (gtv->displs[s + 1] < gtv->displs[s]) valid = 0;
+        if (gtv->seg_rank[s] == gtv->my_rank) gtv->my_seg = s;
+    }
+    if (valid == 0) return GTM_INVALID_R_DISPLS;
+    gtv->my_start = gtv->displs[gtv->my_seg];
+    gtv->my_len   = gtv->displs[gtv->my_seg + 1] - gtv->my_start;
+
+    MPI_Aint vec_msize = (MPI_Aint) gtv->my_len * (MPI_Aint) gtv->unit_size;
+    gtv->vec_block = malloc(MAX(vec_msize, gtv->unit_size));
+    if (gtv->vec_block == NULL) return GTM_ALLOC_FAILED;
+    memset(gtv->vec_block, 0, vec_msize);
+
+    MPI_Info mpi_info;
+    MPI_Info_create(&mpi_info);
+    MPI_Win_create(gtv->vec_block, vec_msize, gtv->unit_size, mpi_info, gtv->mpi_comm, &gtv->mpi_win);
+    MPI_Info_free(&mpi_info);
+    return GTM_SUCCESS;
+}
+
+// Free a GTM_Vector structure whose MPI window is not created
+static void GTM_freeVectorNoWin(GTM_Vector_t gtv)
+{
+    MPI_Comm_free(&gtv->mpi_comm);
+    free(gtv->displs);
+    free(gtv->seg_rank);
+    free(gtv);
+}
+
+// Allocate a GTM_Vector structure and copy process info
+static int GTM_allocVector(
+    GTM_Vector_t *_gtv, MPI_Comm comm, MPI_Datatype datatype,
+    int unit_size, int my_rank, int n
+)
+{
+    int comm_size;
+    MPI_Comm_size(comm, &comm_size);
+    if ((my_rank < 0) || (my_rank >= comm_size)) return GTM_INVALID_RANK;
+
+    GTM_Vector_t gtv = (GTM_Vector_t) malloc(sizeof(struct GTM_Vector));
+    if (gtv == NULL) return GTM_ALLOC_FAILED;
+    MPI_Comm_dup(comm, &gtv->mpi_comm);
+    gtv->datatype  = datatype;
+    gtv->unit_size = unit_size;
+    gtv->my_rank   = my_rank;
+    gtv->comm_size = comm_size;
+    gtv->n         = n;
+    gtv->nseg      = comm_size;
+    gtv->my_seg    = 0;
+    gtv->displs    = (int*) malloc(sizeof(int) * (comm_size + 1));
+    gtv->seg_rank  = (int*) malloc(sizeof(int) * comm_size);
+    if ((gtv->displs == NULL) || (gtv->seg_rank == NULL))
+    {
+        GTM_freeVectorNoWin(gtv);
+        return GTM_ALLOC_FAILED;
+    }
+
+    *_gtv = gtv;
+    return GTM_SUCCESS;
+}
+
+int GTM_createVector(
+    GTM_Vector_t *_gtv, MPI_Comm comm, MPI_Datatype datatype,
+    int unit_size, int my_rank, int n, int *displs
+)
+{
+    GTM_Vector_t gtv;
+    int ret = GTM_allocVector(&gtv, comm, datatype, unit_size, my_rank, n);
+    if (ret != GTM_SUCCESS) return ret;
+    memcpy(gtv->displs, displs, sizeof(int) * (gtv->nseg + 1));
+    for (int s = 0; s < gtv->nseg; s++) gtv->seg_rank[s] = s;
+    ret = GTM_initVector(gtv);
+    if (ret != GTM_SUCCESS)
+    {
+        GTM_freeVectorNoWin(gtv);
+        return ret;
+    }
+
+    *_gtv = gtv;
+    return GTM_SUCCESS;
+}
+
+int GTM_createAlignedVector(GTM_Vector_t *_gtv, GTMatrix_t gtm, int align)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    if ((align != GTM_VEC_ALIGN_ROW) && (align != GTM_VEC_ALIGN_COL)) return GTM_INVALID_FLAGS;
+
+    // Row alignment: block b is split among ranks b * c_blocks + t, t < c_blocks
+    // Column alignment: block b is split among ranks t * c_blocks + b, t < r_blocks
+    int n        = (align == GTM_VEC_ALIGN_ROW) ? gtm->nrows    : gtm->ncols;
+    int nblocks  = (align == GTM_VEC_ALIGN_ROW) ? gtm->r_blocks : gtm->c_blocks;
+    int nsplit   = (align == GTM_VEC_ALIGN_ROW) ? gtm->c_blocks : gtm->r_blocks;
+    int *mdispls = (align == GTM_VEC_ALIGN_ROW) ? gtm->r_displs : gtm->c_displs;
+
+    GTM_Vector_t gtv;
+    int ret = GTM_allocVector(&gtv, gtm->mpi_comm, gtm->datatype, gtm->unit_size, gtm->my_rank, n);
+    if (ret != GTM_SUCCESS) return ret;
+    for (int b = 0; b < nblocks; b++)
+    {
+        int blk_s = mdispls[b], blk_len = mdispls[b + 1] - mdispls[b];
+        for (int t = 0; t < nsplit; t++)
+        {
+            int s = b * nsplit + t;
+            gtv->displs[s] = blk_s + (int) ((long) blk_len * t / nsplit);
+            gtv->seg_rank[s] = (align == GTM_VEC_ALIGN_ROW) ? s : (t * gtm->c_blocks + b);
+        }
+    }
+    gtv->displs[gtv->nseg] = n;
+    ret = GTM_initVector(gtv);
+    if (ret != GTM_SUCCESS)
+    {
+        GTM_freeVectorNoWin(gtv);
+        return ret;
+    }
+
+    *_gtv = gtv;
+    return GTM_SUCCESS;
+}
+
+int GTM_destroyVector(GTM_Vector_t gtv)
+{
+    if (gtv == NULL) return GTM_NULL_PTR;
+
+    MPI_Win_free(&gtv->mpi_win);
+    MPI_Comm_free(&gtv->mpi_comm);
+
+    free(gtv->displs);
+    free(gtv->seg_rank);
+    free(gtv->vec_block);
+    free(gtv);
+
+    return GTM_SUCCESS;
+}
+
+int GTM_syncVector(GTM_Vector_t gtv)
+{
+    if (gtv == NULL) return GTM_NULL_PTR;
+    // Each access completes at target when it returns, only need to wait others
+    MPI_Barrier(gtv->mpi_comm);
+    return GTM_SUCCESS;
+}
+
+// Find the non-empty segment that contains index x, 0 <= x < n
+static int GTM_findVectorSeg(GTM_Vector_t gtv, int x)
+{
+    int lo = 0, hi = gtv->nseg - 1;
+    while (lo < hi)
+    {
+        int mid = (lo + hi + 1) / 2;
+        if (gtv->displs[mid] <= x) lo = mid;
+        else hi = mid - 1;
+    }
+    return lo;
+}
+
+// Get or update (put, accumulate) entries [start, start + num)
+static int GTM_accessVectorRange(GTM_Vector_t gtv, MPI_Op op, int start, int num, void *buf)
+{
+    if (gtv == NULL) return GTM_NULL_PTR;
+    if (buf == NULL) return GTM_NULL_PTR;
+    if ((start < 0) || (num <= 0) || (start + num > gtv->n)) return GTM_INVALID_BLOCK;
+
+    int end = start + num - 1;
+    int s_seg = GTM_findVectorSeg(gtv, start);
+    int e_seg = GTM_findVectorSeg(gtv, end);
+    for (int s = s_seg; s <= e_seg; s++)  // Notice: <=
+    {
+        int seg_s = MAX(start, gtv->displs[s]);
+        int seg_e = MIN(end,   gtv->displs[s + 1] - 1);
+        int cnt   = seg_e - seg_s + 1;
+        if (cnt <= 0) continue;
+        int dst_rank = gtv->seg_rank[s];
+        MPI_Aint dst_pos = (MPI_Aint) (seg_s - gtv->displs[s]);
+        char *buf_ptr = (char*) buf + (size_t) (seg_s - start) * (size_t) gtv->unit_size;
+        MPI_Win_lock(MPI_LOCK_SHARED, dst_rank, 0, gtv->mpi_win);
+        if (op == MPI_NO_OP)
+            MPI_Get(buf_ptr, cnt, gtv->datatype, dst_rank, dst_pos, cnt, gtv->datatype, gtv->mpi_win);
+        else
+            MPI_Accumulate(buf_ptr, cnt, gtv->datatype, dst_rank, dst_pos, cnt, gtv->datatype, op, gtv->mpi_win);
+        MPI_Win_unlock(dst_rank, gtv->mpi_win);
+    }
+    return GTM_SUCCESS;
+}
+
+int GTM_getVectorRange(GTM_Vector_t gtv, int start, int num, void *buf)
+{
+    return GTM_accessVectorRange(gtv, MPI_NO_OP, start, num, buf);
+}
+
+int GTM_putVectorRange(GTM_Vector_t gtv, int start, int num, void *buf)
+{
+    return GTM_accessVectorRange(gtv, MPI_REPLACE, start, num, buf);
+}
+
+int GTM_accVectorRange(GTM_Vector_t gtv, int start, int num, void *buf)
+{
+    return GTM_accessVectorRange(gtv, MPI_SUM, start, num, buf);
+}
+
+// Indexed get or update: entries are grouped by segment with a counting sort,
+// then each segment is accessed with an indexed target datatype and a packed
+// contiguous origin buffer
+static int GTM_accessVectorIndexed(GTM_Vector_t gtv, MPI_Op op, int num, const int *idx, void *buf)
+{
+    if (gtv == NULL) return GTM_NULL_PTR;
+    if ((idx == NULL) || (buf == NULL)) return GTM_NULL_PTR;
+    if (num <= 0) return GTM_SUCCESS;
+    for (int i = 0; i < num; i++)
+        if ((idx[i] < 0) || (idx[i] >= gtv->n)) return GTM_INVALID_BLOCK;
+
+    int nseg = gtv->nseg, unit_size = gtv->unit_size;
+    int *seg_ptr = (int*) calloc(nseg + 1, sizeof(int));
+    int *seg_idx = (int*) malloc(sizeof(int) * num);
+    int *perm    = (int*) malloc(sizeof(int) * num);
+    int *tdispls = (int*) malloc(sizeof(int) * num);
+    char *pack   = (char*) GTM_allocBuffer((size_t) num * (size_t) unit_size);
+    if ((seg_ptr == NULL) || (seg_idx == NULL) || (perm == NULL) || (tdispls == NULL) || (pack == NULL))
+    {
+        free(seg_ptr);
+        free(seg_idx);
+        free(perm);
+        free(tdispls);
+        GTM_freeBuffer(pack);
+        return GTM_ALLOC_FAILED;
+    }
+
+    // Counting sort of entries by segment
+    for (int i = 0; i < num; i++)
+    {
+        seg_idx[i] = GTM_findVectorSeg(gtv, idx[i]);
+        seg_ptr[seg_idx[i] + 1]++;
+    }
+    for (int s = 0; s < nseg; s++) seg_ptr[s + 1] += seg_ptr[s];
+    for (int i = 0; i < num; i++)
+    {
+        int s = seg_idx[i];
+        int p = seg_ptr[s]++;
+        perm[p]    = i;
+        tdispls[p] = idx[i] - gtv->displs[s];
+    }
+    for (int s = nseg; s > 0; s--) seg_ptr[s] = seg_ptr[s - 1];
+    seg_ptr[0] = 0;
+
+    if (op != MPI_NO_OP)
+    {
+        for (int p = 0; p < num; p++)
+            memcpy(pack + (size_t) p * unit_size, (char*) buf + (size_t) perm[p] * unit_size, unit_size);
+    }
+
+    for (int s = 0; s < nseg; s++)
+    {
+        int cnt = seg_ptr[s + 1] - seg_ptr[s];
+        if (cnt == 0) continue;
+        int dst_rank = gtv->seg_rank[s];
+        char *pack_ptr = pack + (size_t) seg_ptr[s] * unit_size;
+        MPI_Datatype dst_dt;
+        MPI_Type_create_indexed_block(cnt, 1, tdispls + seg_ptr[s], gtv->datatype, &dst_dt);
+        MPI_Type_commit(&dst_dt);
+        MPI_Win_lock(MPI_LOCK_SHARED, dst_rank, 0, gtv->mpi_win);
+        if (op == MPI_NO_OP)
+            MPI_Get(pack_ptr, cnt, gtv->datatype, dst_rank, 0, 1, dst_dt, gtv->mpi_win);
+        else
+            MPI_Accumulate(pack_ptr, cnt, gtv->datatype, dst_rank, 0, 1, dst_dt, op, gtv->mpi_win);
+        MPI_Win_unlock(dst_rank, gtv->mpi_win);
+        MPI_Type_free(&dst_dt);
+    }
+
+    if (op == MPI_NO_OP)
+    {
+        for (int p = 0; p < num; p++)
+            memcpy((char*) buf + (size_t) perm[p] * unit_size, pack + (size_t) p * unit_size, unit_size);
+    }
+
+    free(seg_ptr);
+    free(seg_idx);
+    free(perm);
+    free(tdispls);
+    GTM_freeBuffer(pack);
+    return GTM_SUCCESS;
+}
+
+int GTM_gatherVector(GTM_Vector_t gtv, int num, const int *idx, void *buf)
+{
+    return GTM_accessVectorIndexed(gtv, MPI_NO_OP, num, idx, buf);
+}
+
+int GTM_scatterVector(GTM_Vector_t gtv, int num, const int *idx, void *buf)
+{
+    return GTM_accessVectorIndexed(gtv, MPI_REPLACE, num, idx, buf);
+}
+
+int GTM_scatterAccVector(GTM_Vector_t gtv, int num, const int *idx, void *buf)
+{
+    return GTM_accessVectorIndexed(gtv, MPI_SUM, num, idx, buf);
+}
+
+// Local operations use unit-stride loops on restrict pointers, so that the
+// compiler can vectorize them
+
+static int GTM_checkDoubleVector(GTM_Vector_t x)
+{
+    if (x == NULL) return GTM_NULL_PTR;
+    if (x->datatype != MPI_DOUBLE) return GTM_INVALID_FLAGS;
+    return GTM_SUCCESS;
+}
+
+static int GTM_checkSameVectorPartition(GTM_Vector_t x, GTM_Vector_t y)
+{
+    int ret = GTM_checkDoubleVector(x);
+    if (ret == GTM_SUCCESS) ret = GTM_checkDoubleVector(y);
+    if (ret != GTM_SUCCESS) return ret;
+    if ((x->n != y->n) || (x->my_start != y->my_start) || (x->my_len != y->my_len)) return GTM_INVALID_R_DISPLS;
+    return GTM_SUCCESS;
+}
+
+int GTM_fillVector(GTM_Vector_t x, double value)
+{
+    int ret = GTM_checkDoubleVector(x);
+    if (ret != GTM_SUCCESS) return ret;
+    double *restrict x_ = (double*) x->vec_block;
+    for (int i = 0; i < x->my_len; i++) x_[i] = value;
+    return GTM_SUCCESS;
+}
+
+int GTM_scaleVector(GTM_Vector_t x, double alpha)
+{
+    int ret = GTM_checkDoubleVector(x);
+    if (ret != GTM_SUCCESS) return ret;
+    double *restrict x_ = (double*) x->vec_block;
+    for (int i = 0; i < x->my_len; i++) x_[i] *= alpha;
+    return GTM_SUCCESS;
+}
+
+int GTM_axpbyVector(double alpha, GTM_Vector_t x, double beta, GTM_Vector_t y)
+{
+    int ret = GTM_checkSameVectorPartition(x, y);
+    if (ret != GTM_SUCCESS) return ret;
+    const double *restrict x_ = (const double*) x->vec_block;
+    double *restrict y_ = (double*) y->vec_block;
+    if (x == y)
+    {
+        for (int i = 0; i < y->my_len; i++) y_[i] *= (alpha + beta);
+        return GTM_SUCCESS;
+    }
+    for (int i = 0; i < y->my_len; i++) y_[i] = alpha * x_[i] + beta * y_[i];
+    return GTM_SUCCESS;
+}
+
+int GTM_dotVector(GTM_Vector_t x, GTM_Vector_t y, double *result)
+{
+    int ret = GTM_checkSameVectorPartition(x, y);
+    if (ret != GTM_SUCCESS) return ret;
+    if (result == NULL) return GTM_NULL_PTR;
+    const double *x_ = (const double*) x->vec_block;
+    const double *y_ = (const double*) y->vec_block;
+    double res = 0.0;
+    for (int i = 0; i < x->my_len; i++) res += x_[i] * y_[i];
+    MPI_Allreduce(&res, result, 1, MPI_DOUBLE, MPI_SUM, x->mpi_comm);
+    return GTM_SUCCESS;
+}
+
+int GTM_nrm2Vector(GTM_Vector_t x, double *result)
+{
+    int ret = GTM_dotVector(x, x, result);
+    if (ret != GTM_SUCCESS) return ret;
+    *result = sqrt(*result);
+    return GTM_SUCCESS;
+}
+
+int GTM_asumVector(GTM_Vector_t x, double *result)
+{
+    int ret = GTM_checkDoubleVector(x);
+    if (ret != GTM_SUCCESS) return ret;
+    if (result == NULL) return GTM_NULL_PTR;
+    const double *restrict x_ = (const double*) x->vec_block;
+    double res = 0.0;
+    for (int i = 0; i < x->my_len; i++) res += fabs(x_[i]);
+    MPI_Allreduce(&res, result, 1, MPI_DOUBLE, MPI_SUM, x->mpi_comm);
+    return GTM_SUCCESS;
+}
+
+int GTM_amaxVector(GTM_Vector_t x, double *result)
+{
+    int ret = GTM_checkDoubleVector(x);
+    if (ret != GTM_SUCCESS) return ret;
+    if (result == NULL) return GTM_NULL_PTR;
+    const double *restrict x_ = (const double*) x->vec_block;
+    double res = 0.0;
+    for (int i = 0; i < x->my_len; i++) res = MAX(res, fabs(x_[i]));
+    MPI_Allreduce(&res, result, 1, MPI_DOUBLE, MPI_MAX, x->mpi_comm);
+    return GTM_SUCCESS;
+}
@@ -0,0 +1,110 @@
+#ifndef __GTM_VECTOR_H__
+#define __GTM_VECTOR_H__
+
+#include <mpi.h>
+#include "GTMatrix_Typedef.h"
+
+// Distributed 1D vector. The vector is split into nseg contiguous segments,
+// segment s is [displs[s], displs[s + 1]) and is stored on process
+// seg_rank[s]. Each process owns exactly one segment, which can be empty.
+// A vector aligned with a GTMatrix splits each row (column) block of the
+// matrix among the processes of that process row (column), so the vector
+// entries a process needs for y = A * x are owned inside its process row
+// or column.
+struct GTM_Vector
+{
+    // MPI components
+    MPI_Comm mpi_comm;           // Target communicator
+    MPI_Win  mpi_win;            // MPI window for local segment
+    MPI_Datatype datatype;       // Vector data type
+
+    // Vector size and partition
+    int n;                       // Vector length
+    int nseg;                    // Number of segments, == comm_size
+    int *displs;                 // Size nseg + 1, segment s is [displs[s], displs[s + 1])
+    int *seg_rank;               // Size nseg, process that stores segment s
+    int my_seg;                  // Segment stored on this process
+    int my_start, my_len;        // 1st index and length of local segment
+    int unit_size;               // Size of vector data type, unit is byte
+    int my_rank, comm_size;      // Rank of this process and number of process in the global communicator
+
+    // Local storage
+    void *vec_block;             // Size my_len, local segment
+};
+
+typedef struct GTM_Vector* GTM_Vector_t;
+
+#define GTM_VEC_ALIGN_ROW  0  // Align with GTMatrix r_displs
+#define GTM_VEC_ALIGN_COL  1  // Align with GTMatrix c_displs
+
+// Create and initialize a GTM_Vector structure, segment i is stored on process i
+// This call is collective, thread-safe
+// Input parameters:
+//   comm      : MPI communicator used in this distributed vector
+//   datatype  : Vector data type
+//   unit_size : Size of vector data type, unit is byte
+//   my_rank   : MPI Rank of this process
+//   n         : Vector length
+//   *displs   : Displacement array, comm_size+1 non-decreasing elements,
+//               displs[0] == 0, displs[comm_size] == n
+// Output parameter:
+//   *_gtv : Pointer to the created GTM_Vector structure
+int GTM_createVector(
+    GTM_Vector_t *_gtv, MPI_Comm comm, MPI_Datatype datatype,
+    int unit_size, int my_rank, int n, int *displs
+);
+
+// Create a GTM_Vector aligned with a GTMatrix. The vector has length gtm->nrows
+// (align == GTM_VEC_ALIGN_ROW) or gtm->ncols (align == GTM_VEC_ALIGN_COL), the same
+// data type as gtm, and each matrix row (column) block is evenly split among
+// the processes of the corresponding process row (column).
+// This call is collective, thread-safe
+int GTM_createAlignedVector(GTM_Vector_t *_gtv, GTMatrix_t gtm, int align);
+
+// Free a GTM_Vector structure
+// This call is collective, thread-safe
+int GTM_destroyVector(GTM_Vector_t gtv);
+
+// Synchronize: wait all processes to finish their get / put / accumulate
+// This call is collective, not thread-safe
+int GTM_syncVector(GTM_Vector_t gtv);
+
+// Get / put / accumulate entries [start, start + num), each owner is
+// accessed by a single RMA operation
+// Blocking call, not collective, not thread-safe
+// Input parameters:
+//   start : 1st index
+//   num   : Number of entries
+//   *buf  : Receive buffer (get) or source buffer (put, accumulate), size num
+int GTM_getVectorRange(GTM_Vector_t gtv, int start, int num, void *buf);
+int GTM_putVectorRange(GTM_Vector_t gtv, int start, int num, void *buf);
+int GTM_accVectorRange(GTM_Vector_t gtv, int start, int num, void *buf);
+
+// Indexed gather: buf[i] = v[idx[i]]. Indexed scatter: v[idx[i]] = buf[i]
+// or v[idx[i]] += buf[i]. Indices are grouped by owner, each owner is
+// accessed by a single RMA operation. Indices can be in any order; duplicate
+// indices are allowed for gather and accumulate.
+// Blocking call, not collective, not thread-safe
+// Input parameters:
+//   num  : Number of indices
+//   *idx : Size num, global indices
+//   *buf : Size num, receive buffer (gather) or source buffer (scatter)
+int GTM_gatherVector    (GTM_Vector_t gtv, int num, const int *idx, void *buf);
+int GTM_scatterVector   (GTM_Vector_t gtv, int num, const int *idx, void *buf);
+int GTM_scatterAccVector(GTM_Vector_t gtv, int num, const int *idx, void *buf);
+
+// Local operations, data type must be double. Vectors in the same
+// operation must have the same partition.
+// This call is not collective, not thread-safe
+int GTM_fillVector (GTM_Vector_t x, double value);                     // x = value
+int GTM_scaleVector(GTM_Vector_t x, double alpha);                     // x = alpha * x
+int GTM_axpbyVector(double alpha, GTM_Vector_t x, double beta, GTM_Vector_t y);  // y = alpha * x + beta * y
+
+// Reductions, data type must be double. The result is returned on all processes.
+// This call is collective, not thread-safe
+int GTM_dotVector (GTM_Vector_t x, GTM_Vector_t y, double *result);  // result = x^T * y
+int GTM_nrm2Vector(GTM_Vector_t x, double *result);                  // result = ||x||_2
+int GTM_asumVector(GTM_Vector_t x, double *result);                  // result = sum(|x|)
+int GTM_amaxVector(GTM_Vector_t x, double *result);                  // result = max(|x|)
+
+#endif
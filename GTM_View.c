@@ -0,0 +1,265 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix_Retval.h"
+#include "GTMatrix_Typedef.h"
+#include "GTMatrix_Other.h"
+#include "GTMatrix_Get.h"
+#include "GTMatrix_Update.h"
+#include "GTM_View.h"
+#include "utils.h"
+
+int GTM_createView(
+    GTM_View_t *_view, GTMatrix_t gtm, int row_start, int row_num,
+    int col_start, int col_num
+)
+{
+    if ((_view == NULL) || (gtm == NULL)) return GTM_NULL_PTR;
+    if ((row_start < 0) || (col_start < 0) ||
+        (row_start + row_num > gtm->nrows)  ||
+        (col_start + col_num > gtm->ncols)  ||
+        (row_num <= 0) || (col_num <= 0)) return GTM_INVALID_BLOCK;
+
+    GTM_View_t view = (GTM_View_t) malloc(sizeof(struct GTM_View));
+    if (view == NULL) return GTM_ALLOC_FAILED;
+    view->gtm       = gtm;
+    view->row_start = row_start;
+    view->row_num   = row_num;
+    view->col_start = col_start;
+    view->col_num   = col_num;
+    GTM_findOwnerBlocks(gtm, row_start, row_num, col_start, col_num, NULL, &view->owner_range[0]);
+
+    *_view = view;
+    return GTM_SUCCESS;
+}
+
+int GTM_createSubView(
+    GTM_View_t *_view, GTM_View_t parent, int row_start, int row_num,
+    int col_start, int col_num
+)
+{
+    if ((_view == NULL) || (parent == NULL)) return GTM_NULL_PTR;
+    if ((row_start < 0) || (col_start < 0) ||
+        (row_start + row_num > parent->row_num) ||
+        (col_start + col_num > parent->col_num) ||
+        (row_num <= 0) || (col_num <= 0)) return GTM_INVALID_BLOCK;
+
+    GTM_View_t view = (GTM_View_t) malloc(sizeof(struct GTM_View));
+    if (view == NULL) return GTM_ALLOC_FAILED;
+    view->gtm       = parent->gtm;
+    view->row_start = parent->row_start + row_start;
+    view->row_num   = row_num;
+    view->col_start = parent->col_start + col_start;
+    view->col_num   = col_num;
+    GTM_findOwnerBlocks(
+        view->gtm, view->row_start, row_num, view->col_start, col_num,
+        &parent->owner_range[0], &view->owner_range[0]
+    );
+
+    *_view = view;
+    return GTM_SUCCESS;
+}
+
+int GTM_destroyView(GTM_View_t view)
+{
+    if (view == NULL) return GTM_NULL_PTR;
+    free(view);
+    return GTM_SUCCESS;
+}
+
+// Check if a block is inside a view
+static int GTM_checkViewBlock(GTM_View_t view, int row_start, int row_num, int col_start, int col_num)
+{
+    if ((row_start < 0) || (col_start < 0) ||
+        (row_start + row_num > view->row_num) ||
+        (col_start + col_num > view->col_num) ||
+        (row_num * col_num == 0)) return GTM_INVALID_BLOCK;
+    return GTM_SUCCESS;
+}
+
+// Get a block of a view, the owners are searched in the view's owner range
+static int GTM_viewGetBlock_(GTM_VIEW_PARAM, int access_mode)
+{
+    if (view == NULL) return GTM_NULL_PTR;
+    int ret = GTM_checkViewBlock(view, row_start, row_num, col_start, col_num);
+    if (ret != GTM_SUCCESS) return ret;
+    return GTM_getBlockInRange_(
+        view->gtm, view->row_start + row_start, row_num,
+        view->col_start + col_start, col_num, src_buf, src_buf_ld,
+        access_mode, &view->owner_range[0]
+    );
+}
+
+// Update a block of a view, the owners are searched in the view's owner range
+static int GTM_viewUpdateBlock_(GTM_VIEW_PARAM, MPI_Op op, void *alpha, int access_mode)
+{
+    if (view == NULL) return GTM_NULL_PTR;
+    int ret = GTM_checkViewBlock(view, row_start, row_num, col_start, col_num);
+    if (ret != GTM_SUCCESS) return ret;
+    GTMatrix_t gtm = view->gtm;
+    return GTM_updateBlockInRange(
+        gtm, op, view->row_start + row_start, row_num,
+        view->col_start + col_start, col_num, src_buf, src_buf_ld,
+        gtm->col_major_buf, alpha, access_mode, &view->owner_range[0]
+    );
+}
+
+// Get a block of a view
+int GTM_viewGetBlock(GTM_VIEW_PARAM)
+{
+    return GTM_viewGetBlock_(
+        view, row_start, row_num, col_start, col_num,
+        src_buf, src_buf_ld, BLOCKING_ACCESS
+    );
+}
+int GTM_viewGetBlockNB(GTM_VIEW_PARAM)
+{
+    return GTM_viewGetBlock_(
+        view, row_start, row_num, col_start, col_num,
+        src_buf, src_buf_ld, NONBLOCKING_ACCESS
+    );
+}
+int GTM_viewAddGetBlockRequest(GTM_VIEW_PARAM)
+{
+    return GTM_viewGetBlock_(
+        view, row_start, row_num, col_start, col_num,
+        src_buf, src_buf_ld, BATCH_ACCESS
+    );
+}
+
+// Put a block to a view
+int GTM_viewPutBlock(GTM_VIEW_PARAM)
+{
+    return GTM_viewUpdateBlock_(
+        view, row_start, row_num, col_start, col_num,
+        src_buf, src_buf_ld, MPI_REPLACE, NULL, BLOCKING_ACCESS
+    );
+}
+int GTM_viewPutBlockNB(GTM_VIEW_PARAM)
+{
+    return GTM_viewUpdateBlock_(
+        view, row_start, row_num, col_start, col_num,
+        src_buf, src_buf_ld, MPI_REPLACE, NULL, NONBLOCKING_ACCESS
+    );
+}
+int GTM_viewAddPutBlockRequest(GTM_VIEW_PARAM)
+{
+    return GTM_viewUpdateBlock_(
+        view, row_start, row_num, col_start, col_num,
+        src_buf, src_buf_ld, MPI_REPLACE, NULL, BATCH_ACCESS
+    );
+}
+
+// Accumulate a block to a view
+int GTM_viewAccBlock(GTM_VIEW_PARAM)
+{
+    return GTM_viewUpdateBlock_(
+        view, row_start, row_num, col_start, col_num,
+        src_buf, src_buf_ld, MPI_SUM, NULL, BLOCKING_ACCESS
+    );
+}
+int GTM_viewAccBlockNB(GTM_VIEW_PARAM)
+{
+    return GTM_viewUpdateBlock_(
+        view, row_start, row_num, col_start, col_num,
+        src_buf, src_buf_ld, MPI_SUM, NULL, NONBLOCKING_ACCESS
+    );
+}
+int GTM_viewAddAccBlockRequest(GTM_VIEW_PARAM)
+{
+    return GTM_viewUpdateBlock_(
+        view, row_start, row_num, col_start, col_num,
+        src_buf, src_buf_ld, MPI_SUM, NULL, BATCH_ACCESS
+    );
+}
+
+// Accumulate alpha * (a block) to a view
+int GTM_viewAccBlockScaled(GTM_VIEW_PARAM, void *alpha)
+{
+    if (alpha == NULL) return GTM_NULL_PTR;
+    return GTM_viewUpdateBlock_(
+        view, row_start, row_num, col_start, col_num,
+        src_buf, src_buf_ld, MPI_SUM, alpha, BLOCKING_ACCESS
+    );
+}
+int GTM_viewAccBlockScaledNB(GTM_VIEW_PARAM, void *alpha)
+{
+    if (alpha == NULL) return GTM_NULL_PTR;
+    return GTM_viewUpdateBlock_(
+        view, row_start, row_num, col_start, col_num,
+        src_buf, src_buf_ld, MPI_SUM, alpha, NONBLOCKING_ACCESS
+    );
+}
+int GTM_viewAddAccBlockScaledRequest(GTM_VIEW_PARAM, void *alpha)
+{
+    if (alpha == NULL) return GTM_NULL_PTR;
+    return GTM_viewUpdateBlock_(
+        view, row_start, row_num, col_start, col_num,
+        src_buf, src_buf_ld, MPI_SUM, alpha, BATCH_ACCESS
+    );
+}
+
+// Update a block of a view with a predefined MPI operation
+int GTM_viewUpdateBlockOp(GTM_VIEW_PARAM, MPI_Op op)
+{
+    if (view == NULL) return GTM_NULL_PTR;
+    int ret = GTM_checkUpdateOp(view->gtm, op);
+    if (ret != GTM_SUCCESS) return ret;
+    return GTM_viewUpdateBlock_(
+        view, row_start, row_num, col_start, col_num,
+        src_buf, src_buf_ld, op, NULL, BLOCKING_ACCESS
+    );
+}
+int GTM_viewUpdateBlockOpNB(GTM_VIEW_PARAM, MPI_Op op)
+{
+    if (view == NULL) return GTM_NULL_PTR;
+    int ret = GTM_checkUpdateOp(view->gtm, op);
+    if (ret != GTM_SUCCESS) return ret;
+    return GTM_viewUpdateBlock_(
+        view, row_start, row_num, col_start, col_num,
+        src_buf, src_buf_ld, op, NULL, NONBLOCKING_ACCESS
+    );
+}
+int GTM_viewAddUpdateBlockOpRequest(GTM_VIEW_PARAM, MPI_Op op)
+{
+    if (view == NULL) return GTM_NULL_PTR;
+    int ret = GTM_checkUpdateOp(view->gtm, op);
+    if (ret != GTM_SUCCESS) return ret;
+    return GTM_viewUpdateBlock_(
+        view, row_start, row_num, col_start, col_num,
+        src_buf, src_buf_ld, op, NULL, BATCH_ACCESS
+    );
+}
+
+// Fill the intersection of the local block and rows [row_start, row_start + row_num),
+// columns [col_start, col_start + col_num) of the matrix
+static void GTM_fillLocalIntersection(
+    GTMatrix_t gtm, void *value, int row_start, int row_num, int col_start, int col_num
+)
+{
+    int my_r_s = gtm->r_displs[gtm->my_rowblk];
+    int my_c_s = gtm->c_displs[gtm->my_colblk];
+    int need_to_fill, r_s, r_e, c_s, c_e;
+    getRectIntersection(
+        my_r_s,    my_r_s + gtm->my_nrows - 1,   my_c_s,    my_c_s + gtm->my_ncols - 1,
+        row_start, row_start + row_num - 1,      col_start, col_start + col_num - 1,
+        &need_to_fill, &r_s, &r_e, &c_s, &c_e
+    );
+    if (need_to_fill == 0) return;
+    GTM_fillLocalRect(gtm, value, r_s - my_r_s, r_e - r_s + 1, c_s - my_c_s, c_e - c_s + 1);
+}
+
+int GTM_viewFill(GTM_View_t view, void *value)
+{
+    if ((view == NULL) || (value == NULL)) return GTM_NULL_PTR;
+    GTMatrix_t gtm = view->gtm;
+    // With symmetric storage, processes in the lower triangle store nothing
+    if (gtm->symm_storage && (gtm->my_rowblk > gtm->my_colblk)) return GTM_SUCCESS;
+    GTM_fillLocalIntersection(gtm, value, view->row_start, view->row_num, view->col_start, view->col_num);
+    // Elements in the mirror of the view share storage with the view's elements
+    if (gtm->symm_storage)
+        GTM_fillLocalIntersection(gtm, value, view->col_start, view->col_num, view->row_start, view->row_num);
+    return GTM_SUCCESS;
+}
@@ -0,0 +1,85 @@
+#ifndef __GTM_VIEW_H__
+#define __GTM_VIEW_H__
+
+#include <mpi.h>
+#include "GTMatrix_Typedef.h"
+
+// Submatrix view: a handle that references a rectangular sub-region of a
+// GTMatrix without copying. Block indices passed to view operations are
+// relative to the view, i.e. row 0 of a view is row row_start of the matrix.
+// The process grid blocks that intersect the view are found once when the
+// view is created, each access only searches the owners of its block in them.
+struct GTM_View
+{
+    GTMatrix_t gtm;              // Referenced GTMatrix
+    int row_start, row_num;      // Rows of the view in the matrix
+    int col_start, col_num;      // Columns of the view in the matrix
+    int owner_range[4];          // Process grid blocks intersecting the view: {first row block,
+                                 // last row block, first column block, last column block}
+};
+
+typedef struct GTM_View* GTM_View_t;
+
+#define GTM_VIEW_PARAM \
+    GTM_View_t view, int row_start, int row_num, \
+    int col_start, int col_num, void *src_buf, int src_buf_ld
+// view       : GTM_View handle
+// Other parameters are the same as GTM_PARAM, row_start and col_start are
+// relative to the view
+
+// Create a view of rows [row_start, row_start + row_num) and columns
+// [col_start, col_start + col_num) of a GTMatrix
+// This call is not collective, thread-safe
+// Output parameter:
+//   *_view : Pointer to the created GTM_View structure
+int GTM_createView(
+    GTM_View_t *_view, GTMatrix_t gtm, int row_start, int row_num,
+    int col_start, int col_num
+);
+
+// Create a view of a sub-region of another view, row_start and col_start are
+// relative to the parent view. The new view does not depend on the parent view.
+// This call is not collective, thread-safe
+int GTM_createSubView(
+    GTM_View_t *_view, GTM_View_t parent, int row_start, int row_num,
+    int col_start, int col_num
+);
+
+// Free a GTM_View structure, the referenced GTMatrix is not changed
+// This call is not collective, thread-safe
+int GTM_destroyView(GTM_View_t view);
+
+// Get / put / accumulate / scaled accumulate / update with a predefined MPI
+// operation on a block of a view, the same as the GTMatrix functions without
+// "view" in the name. Batched requests are executed with the batch functions
+// of the referenced GTMatrix, e.g. GTM_execBatchGet(view->gtm).
+// These calls are not collective, not thread-safe
+int GTM_viewGetBlock(GTM_VIEW_PARAM);
+int GTM_viewGetBlockNB(GTM_VIEW_PARAM);
+int GTM_viewAddGetBlockRequest(GTM_VIEW_PARAM);
+
+int GTM_viewPutBlock(GTM_VIEW_PARAM);
+int GTM_viewPutBlockNB(GTM_VIEW_PARAM);
+int GTM_viewAddPutBlockRequest(GTM_VIEW_PARAM);
+
+int GTM_viewAccBlock(GTM_VIEW_PARAM);
+int GTM_viewAccBlockNB(GTM_VIEW_PARAM);
+int GTM_viewAddAccBlockRequest(GTM_VIEW_PARAM);
+
+int GTM_viewAccBlockScaled(GTM_VIEW_PARAM, void *alpha);
+int GTM_viewAccBlockScaledNB(GTM_VIEW_PARAM, void *alpha);
+int GTM_viewAddAccBlockScaledRequest(GTM_VIEW_PARAM, void *alpha);
+
+int GTM_viewUpdateBlockOp(GTM_VIEW_PARAM, MPI_Op op);
+int GTM_viewUpdateBlockOpNB(GTM_VIEW_PARAM, MPI_Op op);
+int GTM_viewAddUpdateBlockOpRequest(GTM_VIEW_PARAM, MPI_Op op);
+
+// Fill a view with a single value, each process fills its part of the view
+// in its local block. With symmetric storage, the mirror elements of the view
+// are also filled.
+// This call is collective, not thread-safe
+// Input parameter:
+// *value : Pointer to the value, see GTM_fill()
+int GTM_viewFill(GTM_View_t view, void *value);
+
+#endif
@@ -17,9 +17,54 @@ extern "C" {
 // GTMatrix one-sided put and accumulation operations
 #include "GTMatrix_Update.h"
 
+// GTMatrix read-modify-write operations: fetch-and-accumulate, compare-and-swap
+#include "GTMatrix_Atomic.h"
+
+// GTMatrix notified put and accumulation operations
+#include "GTMatrix_Notify.h"
+
+// GTMatrix dirty tile tracking and delta refresh
+#include "GTMatrix_Track.h"
+
 // GTMatrix other operations: symmetrize, fill with value
 #include "GTMatrix_Other.h"
 
+// Submatrix views of a GTMatrix
+#include "GTM_View.h"
+
+// Persistent access plans of batched requests
+#include "GTM_Plan.h"
+
+// Halo exchange of local blocks with process grid neighbors
+#include "GTM_Halo.h"
+
+// Process row / column communicators and pipelined panel collectives
+#include "GTM_Panel.h"
+
+// Distributed blocked Cholesky factorization
+#include "GTM_Cholesky.h"
+
+// Distributed triangular solves with multiple right-hand sides
+#include "GTM_Trsm.h"
+
+// Block-sparse matrix with zero tile skipping
+#include "GTM_Blk_Sparse.h"
+
+// Distributed sparse CSR matrix with batched accumulation and SpMV / SpMM
+#include "GTM_CSR.h"
+
+// Distributed 3D tensor (batch of matrices) with 3D box access
+#include "GTM_Tensor.h"
+
+// Distributed 1D vector with GTMatrix-aligned partitions
+#include "GTM_Vector.h"
+
+// Pooled communication buffers allocated with MPI_Alloc_mem
+#include "GTM_Buffer.h"
+
+// Distributed MCS mutexes for user critical sections
+#include "GTM_Mutex.h"
+
 #ifdef __cplusplus
 }
 #endif
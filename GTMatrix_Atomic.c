@@ -0,0 +1,296 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <mpi.h>
+
+#include "GTMatrix_Retval.h"
+#include "GTMatrix_Typedef.h"
+#include "GTMatrix_Atomic.h"
+#include "GTMatrix_Other.h"
+#include "GTMatrix_Track.h"
+#include "utils.h"
+
+#define GTM_ATOMIC_NONE   -1
+#define GTM_ATOMIC_INT     0
+#define GTM_ATOMIC_INT64   1
+#define GTM_ATOMIC_DOUBLE  2
+
+// Get the element type for element-wise atomic operations
+static int GTM_getAtomicType(GTMatrix_t gtm)
+{
+    if (MPI_INT == gtm->datatype)           return GTM_ATOMIC_INT;
+    if (GTM_IS_INT64_TYPE(gtm->datatype))   return GTM_ATOMIC_INT64;
+    if (MPI_DOUBLE == gtm->datatype)        return GTM_ATOMIC_DOUBLE;
+    return GTM_ATOMIC_NONE;
+}
+
+// Check if op can be used in element-wise fetch-and-op for an atomic type
+static int GTM_checkElementOp(int atomic_type, MPI_Op op)
+{
+    if (atomic_type == GTM_ATOMIC_NONE) return GTM_INVALID_OP;
+    if ((MPI_SUM == op) || (MPI_PROD == op) || (MPI_MAX == op) ||
+        (MPI_MIN == op) || (MPI_REPLACE == op) || (MPI_NO_OP == op)) return GTM_SUCCESS;
+    if ((MPI_BAND == op) || (MPI_BOR == op) || (MPI_BXOR == op) ||
+        (MPI_LAND == op) || (MPI_LOR == op) || (MPI_LXOR == op))
+        return (atomic_type == GTM_ATOMIC_DOUBLE) ? GTM_INVALID_OP : GTM_SUCCESS;
+    return GTM_INVALID_OP;
+}
+
+// Find the process that stores element (row, col) and the element's offset in
+// the process's local block. With symmetric storage, lower triangle elements
+// are redirected to their mirror elements in the upper triangle.
+static int GTM_locateElement(GTMatrix_t gtm, int row, int col, int *dst_rank, MPI_Aint *dst_pos)
+{
+    if ((row < 0) || (row >= gtm->nrows) ||
+        (col < 0) || (col >= gtm->ncols)) return GTM_INVALID_BLOCK;
+    if (gtm->symm_storage && (row > col))
+    {
+        int tmp = row;
+        row = col;
+        col = tmp;
+    }
+    int blk_r = GTM_findBlockIndex(gtm->r_displs, gtm->r_blocks, row);
+    int blk_c = GTM_findBlockIndex(gtm->c_displs, gtm->c_blocks, col);
+    *dst_rank = blk_r * gtm->c_blocks + blk_c;
+    *dst_pos  = (MPI_Aint) GTM_LOCAL_OFFSET(gtm, row - gtm->r_displs[blk_r], col - gtm->c_displs[blk_c]);
+    *dst_pos += (MPI_Aint) gtm->wr_offset;
+    return GTM_SUCCESS;
+}
+
+// Create a committed MPI data type that traverses a row_num * col_num block row 
+// by row, the block is row-major (col_major == 0) or column-major (col_major == 1) 
+// with leading dimension ld
+static void GTM_createRowOrderType(
+    GTMatrix_t gtm, int row_num, int col_num, int ld, int col_major, MPI_Datatype *dt
+)
+{
+    if (col_major)
+    {
+        GTM_createTransBlockType(gtm, col_num, row_num, ld, dt);
+    } else {
+        MPI_Type_vector(row_num, col_num, ld, gtm->datatype, dt);
+        MPI_Type_commit(dt);
+    }
+}
+
+int GTM_fetchAccBlock(GTM_PARAM, MPI_Op op, void *fetch_buf, int fetch_buf_ld)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    if (gtm->symm_storage) return GTM_INVALID_FLAGS;
+    if (MPI_NO_OP != op)
+    {
+        int ret = GTM_checkUpdateOp(gtm, op);
+        if (ret != GTM_SUCCESS) return ret;
+    }
+    if ((row_start < 0) || (col_start < 0) ||
+        (row_start + row_num > gtm->nrows)  ||
+        (col_start + col_num > gtm->ncols)  ||
+        (row_num * col_num == 0)) return GTM_INVALID_BLOCK;
+
+    // Find the processes that contain the requested block
+    int owner_range[4];
+    int row_end = row_start + row_num - 1;
+    int col_end = col_start + col_num - 1;
+    GTM_findOwnerBlocks(gtm, row_start, row_num, col_start, col_num, NULL, owner_range);
+
+    // Fetch and update each process's piece in its own access epoch
+    int blk_r_s, blk_r_e, blk_c_s, blk_c_e, need_to_fetch;
+    for (int blk_r = owner_range[0]; blk_r <= owner_range[1]; blk_r++)      // Notice: <=
+    {
+        int dst_r_s = gtm->r_displs[blk_r];
+        int dst_r_e = gtm->r_displs[blk_r + 1] - 1;
+        for (int blk_c = owner_range[2]; blk_c <= owner_range[3]; blk_c++)  // Notice: <=
+        {
+            int dst_c_s  = gtm->c_displs[blk_c];
+            int dst_c_e  = gtm->c_displs[blk_c + 1] - 1;
+            int dst_rank = blk_r * gtm->c_blocks + blk_c;
+            getRectIntersection(
+                dst_r_s,   dst_r_e, dst_c_s,   dst_c_e,
+                row_start, row_end, col_start, col_end,
+                &need_to_fetch, &blk_r_s, &blk_r_e, &blk_c_s, &blk_c_e
+            );
+            assert(need_to_fetch == 1);
+            int blk_r_num = blk_r_e - blk_r_s + 1;
+            int blk_c_num = blk_c_e - blk_c_s + 1;
+            int dst_lrow  = blk_r_s - dst_r_s;
+            int dst_lcol  = blk_c_s - dst_c_s;
+
+            // Each piece inside a tile (the whole piece in row-major layout) is 
+            // one MPI_Get_accumulate, all pieces are in the same access epoch
+            MPI_Win_lock(gtm->acc_lock_type, dst_rank, 0, gtm->mpi_win);
+            for (int r0 = 0, nr; r0 < blk_r_num; r0 += nr)
+            {
+                nr = GTM_TILE_SPAN(gtm, dst_lrow + r0, blk_r_num - r0);
+                for (int c0 = 0, nc; c0 < blk_c_num; c0 += nc)
+                {
+                    nc = GTM_TILE_SPAN(gtm, dst_lcol + c0, blk_c_num - c0);
+                    int row_dist = blk_r_s + r0 - row_start;
+                    int col_dist = blk_c_s + c0 - col_start;
+                    char *src_ptr   = (char*) src_buf;
+                    char *fetch_ptr = (char*) fetch_buf;
+                    fetch_ptr += GTM_BUF_OFFSET(gtm, fetch_buf_ld, row_dist, col_dist) * gtm->unit_size;
+                    if (src_ptr != NULL) src_ptr += GTM_BUF_OFFSET(gtm, src_buf_ld, row_dist, col_dist) * gtm->unit_size;
+                    MPI_Aint dst_pos = (MPI_Aint) GTM_LOCAL_OFFSET(gtm, dst_lrow + r0, dst_lcol + c0);
+                    dst_pos += (MPI_Aint) gtm->wr_offset;
+
+                    // All data types traverse the piece row by row, layouts are 
+                    // converted during the transfer
+                    MPI_Datatype src_dt, fetch_dt, dst_dt;
+                    GTM_createRowOrderType(gtm, nr, nc, src_buf_ld,   gtm->col_major_buf, &src_dt);
+                    GTM_createRowOrderType(gtm, nr, nc, fetch_buf_ld, gtm->col_major_buf, &fetch_dt);
+                    GTM_createRowOrderType(gtm, nr, nc, GTM_LOCAL_LD(gtm), gtm->col_major, &dst_dt);
+                    MPI_Get_accumulate(
+                        src_ptr, 1, src_dt, fetch_ptr, 1, fetch_dt,
+                        dst_rank, dst_pos, 1, dst_dt, op, gtm->mpi_win
+                    );
+                    MPI_Type_free(&src_dt);
+                    MPI_Type_free(&fetch_dt);
+                    MPI_Type_free(&dst_dt);
+                }
+            }
+            MPI_Win_unlock(dst_rank, gtm->mpi_win);
+            if (op != MPI_NO_OP)
+            {
+                GTM_ADD_TOUCHED(gtm, dst_rank, 1);
+                GTM_stampTiles(gtm, dst_rank, blk_r_s, blk_r_num, blk_c_s, blk_c_num);
+            }
+        }
+    }
+    return GTM_SUCCESS;
+}
+
+int GTM_fetchAndOp(GTMatrix_t gtm, int row, int col, MPI_Op op, void *value, void *result)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    int atomic_type = GTM_getAtomicType(gtm);
+    int ret = GTM_checkElementOp(atomic_type, op);
+    if (ret != GTM_SUCCESS) return ret;
+
+    int dst_rank;
+    MPI_Aint dst_pos;
+    ret = GTM_locateElement(gtm, row, col, &dst_rank, &dst_pos);
+    if (ret != GTM_SUCCESS) return ret;
+
+    MPI_Win_lock(gtm->acc_lock_type, dst_rank, 0, gtm->mpi_win);
+    MPI_Fetch_and_op(value, result, gtm->datatype, dst_rank, dst_pos, op, gtm->mpi_win);
+    MPI_Win_unlock(dst_rank, gtm->mpi_win);
+    if (op != MPI_NO_OP)
+    {
+        GTM_ADD_TOUCHED(gtm, dst_rank, 1);
+        GTM_stampTiles(gtm, dst_rank, row, 1, col, 1);
+    }
+    return GTM_SUCCESS;
+}
+
+int GTM_compareAndSwap(GTMatrix_t gtm, int row, int col, void *compare, void *value, void *result)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    int atomic_type = GTM_getAtomicType(gtm);
+    if (atomic_type == GTM_ATOMIC_NONE) return GTM_INVALID_OP;
+
+    int dst_rank;
+    MPI_Aint dst_pos;
+    int ret = GTM_locateElement(gtm, row, col, &dst_rank, &dst_pos);
+    if (ret != GTM_SUCCESS) return ret;
+
+#ifdef GTM_CAS64_EMULATION
+    // Workaround for MPI libraries whose 64-bit MPI_Compare_and_swap crashes on 
+    // shared memory targets (Open MPI osc/rdma): fetch, compare and replace in an 
+    // exclusive epoch, double elements are compared bitwise. It is not atomic 
+    // with concurrent MPI_Accumulate / MPI_Fetch_and_op on the same element.
+    if (atomic_type != GTM_ATOMIC_INT)
+    {
+        MPI_Win_lock(MPI_LOCK_EXCLUSIVE, dst_rank, 0, gtm->mpi_win);
+        MPI_Get(result, 1, gtm->datatype, dst_rank, dst_pos, 1, gtm->datatype, gtm->mpi_win);
+        MPI_Win_flush(dst_rank, gtm->mpi_win);
+        if (memcmp(result, compare, gtm->unit_size) == 0)
+            MPI_Put(value, 1, gtm->datatype, dst_rank, dst_pos, 1, gtm->datatype, gtm->mpi_win);
+        MPI_Win_unlock(dst_rank, gtm->mpi_win);
+    } else
+#endif
+    {
+        // MPI_Compare_and_swap only takes integer types, double elements are 
+        // compared bitwise as 64-bit integers
+        MPI_Datatype cas_dt = (atomic_type == GTM_ATOMIC_DOUBLE) ? MPI_INT64_T : gtm->datatype;
+        MPI_Win_lock(gtm->acc_lock_type, dst_rank, 0, gtm->mpi_win);
+        MPI_Compare_and_swap(value, compare, result, cas_dt, dst_rank, dst_pos, gtm->mpi_win);
+        MPI_Win_unlock(dst_rank, gtm->mpi_win);
+    }
+    GTM_ADD_TOUCHED(gtm, dst_rank, 1);
+    // The element is only modified if the swap succeeded
+    if (memcmp(result, compare, gtm->unit_size) == 0) GTM_stampTiles(gtm, dst_rank, row, 1, col, 1);
+    return GTM_SUCCESS;
+}
+
+int GTM_fetchAndOpElements(
+    GTMatrix_t gtm, int nelem, int *rows, int *cols,
+    MPI_Op op, void *values, void *results
+)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    int atomic_type = GTM_getAtomicType(gtm);
+    int ret = GTM_checkElementOp(atomic_type, op);
+    if (ret != GTM_SUCCESS) return ret;
+    if (nelem <= 0) return GTM_SUCCESS;
+
+    // Locate all elements and sort them by target process, keep the given order
+    // of elements on the same process
+    int *dst_ranks   = (int*) malloc(sizeof(int) * nelem);
+    int *order       = (int*) malloc(sizeof(int) * nelem);
+    int *rank_displs = (int*) malloc(sizeof(int) * (gtm->comm_size + 1));
+    MPI_Aint *dst_poss = (MPI_Aint*) malloc(sizeof(MPI_Aint) * nelem);
+    if ((dst_ranks == NULL) || (order == NULL) ||
+        (rank_displs == NULL) || (dst_poss == NULL))
+    {
+        free(dst_ranks);
+        free(order);
+        free(rank_displs);
+        free(dst_poss);
+        return GTM_ALLOC_FAILED;
+    }
+    memset(rank_displs, 0, sizeof(int) * (gtm->comm_size + 1));
+    for (int i = 0; i < nelem; i++)
+    {
+        ret = GTM_locateElement(gtm, rows[i], cols[i], &dst_ranks[i], &dst_poss[i]);
+        if (ret != GTM_SUCCESS) break;
+        rank_displs[dst_ranks[i] + 1]++;
+    }
+    if (ret == GTM_SUCCESS)
+    {
+        for (int i = 1; i <= gtm->comm_size; i++) rank_displs[i] += rank_displs[i - 1];
+        for (int i = 0; i < nelem; i++) order[rank_displs[dst_ranks[i]]++] = i;
+        // rank_displs[i] is now the end of process i's elements
+        for (int i = gtm->comm_size; i > 0; i--) rank_displs[i] = rank_displs[i - 1];
+        rank_displs[0] = 0;
+    }
+
+    // One access epoch for each target process
+    int unit_size = gtm->unit_size;
+    for (int _dst_rank = gtm->my_rank; _dst_rank < gtm->comm_size + gtm->my_rank; _dst_rank++)
+    {
+        if (ret != GTM_SUCCESS) break;
+        int dst_rank = _dst_rank % gtm->comm_size;
+        int s_idx = rank_displs[dst_rank];
+        int e_idx = rank_displs[dst_rank + 1];
+        if (s_idx == e_idx) continue;
+        if (op != MPI_NO_OP) GTM_ADD_TOUCHED(gtm, dst_rank, e_idx - s_idx);
+
+        MPI_Win_lock(gtm->acc_lock_type, dst_rank, 0, gtm->mpi_win);
+        for (int k = s_idx; k < e_idx; k++)
+        {
+            int i = order[k];
+            char *value  = (char*) values  + (size_t) i * (size_t) unit_size;
+            char *result = (char*) results + (size_t) i * (size_t) unit_size;
+            MPI_Fetch_and_op(value, result, gtm->datatype, dst_rank, dst_poss[i], op, gtm->mpi_win);
+            if (op != MPI_NO_OP) GTM_stampTiles(gtm, dst_rank, rows[i], 1, cols[i], 1);
+        }
+        MPI_Win_unlock(dst_rank, gtm->mpi_win);
+    }
+
+    free(dst_ranks);
+    free(order);
+    free(rank_displs);
+    free(dst_poss);
+    return ret;
+}
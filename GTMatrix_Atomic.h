@@ -0,0 +1,55 @@
+#ifndef __GTMATRIX_ATOMIC_H__
+#define __GTMATRIX_ATOMIC_H__
+
+#include <mpi.h>
+#include "GTMatrix_Typedef.h"
+
+// Read-modify-write operations on a GTMatrix. All operations are MPI accumulate 
+// operations for every origin process, including processes on the target's node, 
+// so each element is updated atomically with respect to other accumulate operations 
+// (GTM_accBlock(), GTM_updateBlockOp() and functions in this file) on the same element.
+// Exception: with region locks (GTM_UPDATE_ATOMICITY=3), scaled accumulations and 
+// MPI_PROD / MPI_MAX / MPI_MIN updates to targets on the same node are done with 
+// local loads and stores under lock tiles, they must not race with functions in 
+// this file on the same elements.
+
+// All functions in this header file are not collective, not thread-safe.
+// Symmetric storage (GTM_STORAGE_SYMM) is only supported by element-wise operations.
+
+// Fetch a block and update it with a predefined MPI operation using MPI_Get_accumulate,
+// i.e. F = A(rows, cols), A(rows, cols) = op(A(rows, cols), X), element by element
+// Blocking call, the access operation is finished when function returns
+// Input parameters:
+//   GTM_PARAM     : Same as GTM_accBlock(), src_buf holds X
+//   op            : Same as GTM_updateBlockOp(), or MPI_NO_OP to only fetch A
+//   fetch_buf_ld  : Leading dimension of fetch_buf
+// Output parameter:
+//   *fetch_buf    : Values of A(rows, cols) before the update
+int GTM_fetchAccBlock(GTM_PARAM, MPI_Op op, void *fetch_buf, int fetch_buf_ld);
+
+// Fetch an element and update it with a predefined MPI operation, i.e.
+// *result = A(row, col), A(row, col) = op(A(row, col), *value).
+// Supported data types: int, int64 (MPI_INT64_T or MPI_LONG_LONG), double.
+// Supported operations: MPI_SUM, MPI_PROD, MPI_MAX, MPI_MIN, MPI_REPLACE, MPI_NO_OP,
+// plus MPI_BAND, MPI_BOR, MPI_BXOR, MPI_LAND, MPI_LOR, MPI_LXOR for integers.
+// Elements are updated with MPI_Fetch_and_op.
+// Blocking call, the access operation is finished when function returns
+int GTM_fetchAndOp(GTMatrix_t gtm, int row, int col, MPI_Op op, void *value, void *result);
+
+// Compare an element with *compare and replace it with *value if they are equal,
+// *result = A(row, col) before the operation. double elements are compared bitwise.
+// Supported data types are the same as GTM_fetchAndOp().
+// Blocking call, the access operation is finished when function returns
+int GTM_compareAndSwap(GTMatrix_t gtm, int row, int col, void *compare, void *value, void *result);
+
+// Batched GTM_fetchAndOp() on nelem elements: results[i] = A(rows[i], cols[i]),
+// A(rows[i], cols[i]) = op(A(rows[i], cols[i]), values[i]). Elements on the same
+// target process are updated in one access epoch. Elements are updated in the
+// given order for each target process, so repeated elements see previous updates.
+// Blocking call, the access operation is finished when function returns
+int GTM_fetchAndOpElements(
+    GTMatrix_t gtm, int nelem, int *rows, int *cols,
+    MPI_Op op, void *values, void *results
+);
+
+#endif
@@ -20,13 +20,15 @@
 //   col_start  : 1st column of the required block
 //   col_num    : Number of columns the required block has
 //   src_buf_ld : Leading dimension of the received buffer
+//   trans      : If src_buf receives the transpose of the required block, 
+//                i.e. src_buf is a col_num * row_num matrix
 // Output parameter:
 //   *src_buf : Receive buffer
 int GTM_getBlockFromProcess(
     GTMatrix_t gtm, int dst_rank, 
     int row_start, int row_num,
     int col_start, int col_num,
-    void *src_buf, int src_buf_ld
+    void *src_buf, int src_buf_ld, int trans
 )
 {
     if (gtm == NULL) return GTM_NULL_PTR;
@@ -35,7 +37,7 @@ int GTM_getBlockFromProcess(
     int col_end       = col_start + col_num;
     int dst_rowblk    = dst_rank / gtm->c_blocks;
     int dst_colblk    = dst_rank % gtm->c_blocks;
-    int dst_blk_ld    = gtm->ld_local; // gtm->ld_blks[dst_rank];
+    int dst_blk_ld    = GTM_LOCAL_LD(gtm); // gtm->ld_blks[dst_rank];
     int dst_row_start = gtm->r_displs[dst_rowblk];
     int dst_col_start = gtm->c_displs[dst_colblk];
     int dst_row_end   = gtm->r_displs[dst_rowblk + 1];
@@ -48,13 +50,71 @@ int GTM_getBlockFromProcess(
         (col_end   > dst_col_end)   ||
         (row_num   * col_num == 0)) return GTM_INVALID_BLOCK;
 
+    // Tile-major layout: get the pieces inside each tile separately
+    int dst_lrow = row_start - dst_row_start;
+    int dst_lcol = col_start - dst_col_start;
+    if ((GTM_TILE_SPAN(gtm, dst_lrow, row_num) < row_num) ||
+        (GTM_TILE_SPAN(gtm, dst_lcol, col_num) < col_num))
+    {
+        for (int r0 = 0, nr; r0 < row_num; r0 += nr)
+        {
+            nr = GTM_TILE_SPAN(gtm, dst_lrow + r0, row_num - r0);
+            for (int c0 = 0, nc; c0 < col_num; c0 += nc)
+            {
+                nc = GTM_TILE_SPAN(gtm, dst_lcol + c0, col_num - c0);
+                size_t offset = trans ? ((size_t) c0 * (size_t) src_buf_ld + (size_t) r0) : 
+                                        ((size_t) r0 * (size_t) src_buf_ld + (size_t) c0);
+                int ret = GTM_getBlockFromProcess(
+                    gtm, dst_rank, row_start + r0, nr, col_start + c0, nc, 
+                    (char*) src_buf + offset * gtm->unit_size, src_buf_ld, trans
+                );
+                if (ret != GTM_SUCCESS) return ret;
+            }
+        }
+        return GTM_SUCCESS;
+    }
+
     // Check if the target process is in the shared memory communicator
     int shm_rank  = getElementIndexInArray(dst_rank, gtm->shm_global_ranks, gtm->shm_size);
     void *shm_ptr = (shm_rank == -1) ? NULL : gtm->shm_mat_blocks[shm_rank];
 
+    MPI_Aint dst_pos = (MPI_Aint) GTM_LOCAL_OFFSET(gtm, dst_lrow, dst_lcol);
+    dst_pos += gtm->rd_offset;  // Read the published version
+
+    // Column-major storage: get the transposed piece of the storage frame
+    if (gtm->col_major)
+    {
+        int tmp = row_num;
+        row_num = col_num;
+        col_num = tmp;
+        trans   = 1 - trans;
+    }
     size_t row_msize = (size_t)col_num * (size_t)gtm->unit_size;
-    int dst_pos = (row_start - dst_row_start) * dst_blk_ld;
-    dst_pos += col_start - dst_col_start;
+
+    if (trans == 1)
+    {
+        if (shm_rank != -1)
+        {
+            // Target process and current process is in same node, copy and transpose
+            int unit_size = gtm->unit_size;
+            char *dst_ptr = (char*) shm_ptr + dst_pos * unit_size;
+            for (int icol = 0; icol < col_num; icol++)
+            {
+                char *src_ptr = (char*) src_buf + icol * src_buf_ld * unit_size;
+                for (int irow = 0; irow < row_num; irow++)
+                    memcpy(src_ptr + irow * unit_size, dst_ptr + (irow * dst_blk_ld + icol) * unit_size, unit_size);
+            }
+        } else {
+            MPI_Datatype dst_dt, rcv_dt;
+            GTM_createTransBlockType(gtm, row_num, col_num, dst_blk_ld, &dst_dt);
+            MPI_Type_vector(col_num, row_num, src_buf_ld, gtm->datatype, &rcv_dt);
+            MPI_Type_commit(&rcv_dt);
+            MPI_Get(src_buf, 1, rcv_dt, dst_rank, dst_pos, 1, dst_dt, gtm->mpi_win);
+            MPI_Type_free(&dst_dt);
+            MPI_Type_free(&rcv_dt);
+        }
+        return GTM_SUCCESS;
+    }
 
     if (shm_rank != -1)
     {
@@ -71,7 +131,21 @@ int GTM_getBlockFromProcess(
         }
     } else {
         // Target process and current process isn't in same node, use MPI_Get
-        if (row_num <= MPI_DT_SB_DIM_MAX && col_num <= MPI_DT_SB_DIM_MAX)  
+        if (col_num == dst_blk_ld)
+        {
+            // Whole rows of the local block or of a tile, the target is contiguous
+            int nelem = row_num * col_num;
+            if (col_num == src_buf_ld)
+            {
+                MPI_Get(src_buf, nelem, gtm->datatype, dst_rank, dst_pos, nelem, gtm->datatype, gtm->mpi_win);
+            } else {
+                MPI_Datatype rcv_dt;
+                MPI_Type_vector(row_num, col_num, src_buf_ld, gtm->datatype, &rcv_dt);
+                MPI_Type_commit(&rcv_dt);
+                MPI_Get(src_buf, 1, rcv_dt, dst_rank, dst_pos, nelem, gtm->datatype, gtm->mpi_win);
+                MPI_Type_free(&rcv_dt);
+            }
+        } else if (row_num <= MPI_DT_SB_DIM_MAX && col_num <= MPI_DT_SB_DIM_MAX && dst_blk_ld == gtm->ld_local)  
         {
             // Block is small, use predefined data type or define a new 
             // data type to reduce MPI_Get overhead
@@ -108,6 +182,214 @@ int GTM_getBlockFromProcess(
     return GTM_SUCCESS;
 }
 
+// Get a block from a process with the given access mode
+// Input parameters are the same as GTM_getBlockFromProcess(), plus:
+//   access_mode : Access mode, see GTMatrix_Typedef.h
+static int GTM_getBlockFromProcessMode(
+    GTMatrix_t gtm, int dst_rank, 
+    int row_start, int row_num,
+    int col_start, int col_num,
+    void *src_buf, int src_buf_ld, int trans,
+    int access_mode
+)
+{
+    int ret = GTM_SUCCESS;
+    
+    if (access_mode == BLOCKING_ACCESS)
+    {
+        MPI_Win_lock(MPI_LOCK_SHARED, dst_rank, 0, gtm->mpi_win);
+        ret = GTM_getBlockFromProcess(
+            gtm, dst_rank, row_start, row_num, 
+            col_start, col_num, src_buf, src_buf_ld, trans
+        );
+        MPI_Win_unlock(dst_rank, gtm->mpi_win);
+    }
+    
+    if (access_mode == NONBLOCKING_ACCESS)
+    {
+        if (gtm->nb_op_proc_cnt[dst_rank] == 0)
+            MPI_Win_lock(MPI_LOCK_SHARED, dst_rank, 0, gtm->mpi_win);
+        
+        ret = GTM_getBlockFromProcess(
+            gtm, dst_rank, row_start, row_num, 
+            col_start, col_num, src_buf, src_buf_ld, trans
+        );
+        
+        gtm->nb_op_proc_cnt[dst_rank]++;
+        gtm->nb_op_cnt++;
+        if (gtm->nb_op_cnt >= gtm->max_nb_get)
+            GTM_waitNB(gtm);
+    }
+    
+    if (access_mode == BATCH_ACCESS)
+    {
+        GTM_Req_Vector_t req_vec = gtm->req_vec[dst_rank];
+        ret = GTM_pushToReqVector(
+            req_vec, MPI_NO_OP, row_start, row_num, 
+            col_start, col_num, src_buf, src_buf_ld, trans
+        );
+    }
+    
+    return ret;
+}
+
+// Get a square piece [row_start, row_start + row_num)^2 on the diagonal of a 
+// diagonal process block from a GTMatrix with symmetric storage. The square 
+// is fetched in one operation and its lower triangle is mirrored locally. 
+// The mirroring needs the data, so in nonblocking and batch mode the square 
+// is fetched row by row instead: the upper part of each row is stored in 
+// this row and the lower part is stored in the mirror column.
+// Input parameters are the same as GTM_getBlockFromProcessMode() with 
+// col_start == row_start and col_num == row_num
+static int GTM_getSymmDiagSquare(
+    GTMatrix_t gtm, int dst_rank, int row_start, int row_num,
+    void *src_buf, int src_buf_ld, int trans, int access_mode
+)
+{
+    int unit_size = gtm->unit_size;
+    if (access_mode != BLOCKING_ACCESS)
+    {
+        int ret = GTM_SUCCESS;
+        for (int irow = 0; irow < row_num; irow++)
+        {
+            // Buffer elements (irow, 0) and (irow, irow)
+            size_t l_offset = trans ? (size_t) irow : (size_t) irow * (size_t) src_buf_ld;
+            size_t u_offset = l_offset + (size_t) irow * (trans ? (size_t) src_buf_ld : 1);
+            int row = row_start + irow;
+            ret = GTM_getBlockFromProcessMode(
+                gtm, dst_rank, row, 1, row, row_num - irow, 
+                (char*) src_buf + u_offset * (size_t) unit_size, src_buf_ld, trans, access_mode
+            );
+            if ((ret == GTM_SUCCESS) && (irow > 0))
+                ret = GTM_getBlockFromProcessMode(
+                    gtm, dst_rank, row_start, irow, row, 1, 
+                    (char*) src_buf + l_offset * (size_t) unit_size, src_buf_ld, 1 - trans, access_mode
+                );
+            if (ret != GTM_SUCCESS) return ret;
+        }
+        return GTM_SUCCESS;
+    }
+    
+    // GTM_getBlock() is thread-safe, the GTM_allocBuffer() pool is not
+    char *sq_buf;
+    MPI_Aint sq_msize = (MPI_Aint) unit_size * (MPI_Aint) row_num * (MPI_Aint) row_num;
+    if (MPI_Alloc_mem(sq_msize, MPI_INFO_NULL, &sq_buf) != MPI_SUCCESS) return GTM_ALLOC_FAILED;
+    
+    if (gtm->nb_op_proc_cnt[dst_rank] != 0) GTM_waitNB(gtm);
+    MPI_Win_lock(MPI_LOCK_SHARED, dst_rank, 0, gtm->mpi_win);
+    int ret = GTM_getBlockFromProcess(
+        gtm, dst_rank, row_start, row_num, row_start, row_num, 
+        sq_buf, row_num, 0
+    );
+    MPI_Win_unlock(dst_rank, gtm->mpi_win);
+    
+    // Only the upper triangle of a diagonal process block is meaningful
+    for (int irow = 0; irow < row_num; irow++)
+    {
+        for (int icol = 0; icol < row_num; icol++)
+        {
+            size_t sq_pos  = (icol >= irow) ? ((size_t) irow * (size_t) row_num + (size_t) icol) :
+                                              ((size_t) icol * (size_t) row_num + (size_t) irow);
+            size_t buf_pos = trans ? ((size_t) icol * (size_t) src_buf_ld + (size_t) irow) : 
+                                     ((size_t) irow * (size_t) src_buf_ld + (size_t) icol);
+            char *buf_ptr  = (char*) src_buf + buf_pos * (size_t) unit_size;
+            memcpy(buf_ptr, sq_buf + sq_pos * (size_t) unit_size, unit_size);
+            if (icol < irow) GTM_conjBlock(gtm, buf_ptr, 1, 1, 1);
+        }
+    }
+    MPI_Free_mem(sq_buf);
+    return ret;
+}
+
+// Get a block piece in process block (blk_r, blk_c), blk_r >= blk_c, from a 
+// GTMatrix with symmetric storage. Lower triangle elements are fetched from 
+// their mirror elements in the upper triangle and transposed by MPI data 
+// types. Conjugation for double _Complex needs the data, so complex pieces
+// are always fetched in blocking mode. A piece crossing the diagonal of a 
+// diagonal process block is split into rectangles in the upper or the lower 
+// triangle and a square on the diagonal, see GTM_getSymmDiagSquare().
+// Input parameters are the same as GTM_getBlockFromProcessMode(), plus:
+//   blk_r, blk_c : Process block of the piece 
+static int GTM_getSymmBlockPiece(
+    GTMatrix_t gtm, int blk_r, int blk_c,
+    int row_start, int row_num,
+    int col_start, int col_num,
+    void *src_buf, int src_buf_ld, int trans,
+    int access_mode
+)
+{
+    int is_complex = (MPI_C_DOUBLE_COMPLEX == gtm->datatype) ? 1 : 0;
+    int dst_rank   = blk_c * gtm->c_blocks + blk_r;  // Mirror process block in upper triangle
+    int row_end    = row_start + row_num - 1;
+    int col_end    = col_start + col_num - 1;
+    int ret = GTM_SUCCESS;
+    
+    if (is_complex)
+    {
+        if (gtm->nb_op_proc_cnt[dst_rank] != 0) GTM_waitNB(gtm);
+        access_mode = BLOCKING_ACCESS;
+    }
+    
+    // Upper triangle piece of a diagonal block
+    if ((blk_r == blk_c) && (col_start >= row_end))
+    {
+        return GTM_getBlockFromProcessMode(
+            gtm, dst_rank, row_start, row_num, col_start, col_num, 
+            src_buf, src_buf_ld, trans, access_mode
+        );
+    }
+    
+    // Lower triangle piece
+    if ((blk_r > blk_c) || (col_end < row_start))
+    {
+        ret = GTM_getBlockFromProcessMode(
+            gtm, dst_rank, col_start, col_num, row_start, row_num, 
+            src_buf, src_buf_ld, 1 - trans, access_mode
+        );
+        if (is_complex && trans)  GTM_conjBlock(gtm, src_buf, src_buf_ld, col_num, row_num);
+        if (is_complex && !trans) GTM_conjBlock(gtm, src_buf, src_buf_ld, row_num, col_num);
+        return ret;
+    }
+    
+    // Diagonal block: rows above and below the diagonal square [d_s, d_e]^2 
+    // are in one triangle, so are columns left and right of the square
+    int d_s = MAX(row_start, col_start);
+    int d_e = MIN(row_end, col_end);
+    if ((row_start < d_s) || (row_end > d_e))
+    {
+        int sub_s[3] = {row_start, d_s, d_e + 1};
+        int sub_n[3] = {d_s - row_start, d_e - d_s + 1, row_end - d_e};
+        for (int i = 0; i < 3; i++)
+        {
+            if (sub_n[i] == 0) continue;
+            size_t offset = (size_t) (sub_s[i] - row_start) * (trans ? 1 : (size_t) src_buf_ld);
+            ret = GTM_getSymmBlockPiece(
+                gtm, blk_r, blk_c, sub_s[i], sub_n[i], col_start, col_num, 
+                (char*) src_buf + offset * (size_t) gtm->unit_size, src_buf_ld, trans, access_mode
+            );
+            if (ret != GTM_SUCCESS) return ret;
+        }
+        return GTM_SUCCESS;
+    }
+    if ((col_start < d_s) || (col_end > d_e))
+    {
+        int sub_s[3] = {col_start, d_s, d_e + 1};
+        int sub_n[3] = {d_s - col_start, d_e - d_s + 1, col_end - d_e};
+        for (int i = 0; i < 3; i++)
+        {
+            if (sub_n[i] == 0) continue;
+            size_t offset = (size_t) (sub_s[i] - col_start) * (trans ? (size_t) src_buf_ld : 1);
+            ret = GTM_getSymmBlockPiece(
+                gtm, blk_r, blk_c, row_start, row_num, sub_s[i], sub_n[i], 
+                (char*) src_buf + offset * (size_t) gtm->unit_size, src_buf_ld, trans, access_mode
+            );
+            if (ret != GTM_SUCCESS) return ret;
+        }
+        return GTM_SUCCESS;
+    }
+    return GTM_getSymmDiagSquare(gtm, dst_rank, row_start, row_num, src_buf, src_buf_ld, trans, access_mode);
+}
+
 // Get a block from all related processes using MPI_Get
 // Non-blocking, data may not be ready before synchronization
 // This call is not collective, thread-safe
@@ -119,9 +401,11 @@ int GTM_getBlockFromProcess(
 //   col_num     : Number of columns the required block has
 //   src_buf_ld  : Leading dimension of the received buffer
 //   access_mode : Access mode, see GTMatrix_Typedef.h
+//   *search_range : Process grid blocks to search for the owners of the block,
+//                   see GTM_findOwnerBlocks(), NULL means all blocks
 // Output parameter:
 //   *src_buf : Receive buffer
-int GTM_getBlock_(GTM_PARAM, int access_mode)
+int GTM_getBlockInRange_(GTM_PARAM, int access_mode, const int *search_range)
 {
     if (gtm == NULL) return GTM_NULL_PTR;
     
@@ -132,24 +416,12 @@ int GTM_getBlock_(GTM_PARAM, int access_mode)
         (row_num * col_num == 0)) return GTM_INVALID_BLOCK;
     
     // Find the processes that contain the requested block
-    // No need to initialize, just to avoid compiler warning
-    int s_blk_r = 0, e_blk_r = -1, s_blk_c = 0, e_blk_c = -1;  
+    int owner_range[4];
+    GTM_findOwnerBlocks(gtm, row_start, row_num, col_start, col_num, search_range, &owner_range[0]);
+    int s_blk_r = owner_range[0], e_blk_r = owner_range[1];
+    int s_blk_c = owner_range[2], e_blk_c = owner_range[3];
     int row_end = row_start + row_num - 1;
     int col_end = col_start + col_num - 1;
-    for (int i = 0; i < gtm->r_blocks; i++)
-    {
-        if ((gtm->r_displs[i] <= row_start) && 
-            (row_start < gtm->r_displs[i+1])) s_blk_r = i;
-        if ((gtm->r_displs[i] <= row_end)   && 
-            (row_end   < gtm->r_displs[i+1])) e_blk_r = i;
-    }
-    for (int i = 0; i < gtm->c_blocks; i++)
-    {
-        if ((gtm->c_displs[i] <= col_start) && 
-            (col_start < gtm->c_displs[i+1])) s_blk_c = i;
-        if ((gtm->c_displs[i] <= col_end)   && 
-            (col_end   < gtm->c_displs[i+1])) e_blk_c = i;
-    }
     
     // Fetch data from each process
     int blk_r_s, blk_r_e, blk_c_s, blk_c_e, need_to_fetch;
@@ -173,51 +445,36 @@ int GTM_getBlock_(GTM_PARAM, int access_mode)
             int row_dist  = blk_r_s - row_start;
             int col_dist  = blk_c_s - col_start;
             char *blk_ptr = (char*) src_buf;
-            blk_ptr += (row_dist * src_buf_ld + col_dist) * gtm->unit_size;
-            
-            int ret = GTM_SUCCESS;
+            blk_ptr += GTM_BUF_OFFSET(gtm, src_buf_ld, row_dist, col_dist) * gtm->unit_size;
             
-            if (access_mode == BLOCKING_ACCESS)
+            // A column-major buffer holds the transpose of the block in row-major layout
+            int ret, trans = gtm->col_major_buf;
+            if (gtm->symm_storage && (blk_r >= blk_c))
             {
-                MPI_Win_lock(MPI_LOCK_SHARED, dst_rank, 0, gtm->mpi_win);
-                ret = GTM_getBlockFromProcess(
-                    gtm, dst_rank, blk_r_s, blk_r_num, 
-                    blk_c_s, blk_c_num, blk_ptr, src_buf_ld
+                ret = GTM_getSymmBlockPiece(
+                    gtm, blk_r, blk_c, blk_r_s, blk_r_num, 
+                    blk_c_s, blk_c_num, blk_ptr, src_buf_ld, trans, access_mode
                 );
-                MPI_Win_unlock(dst_rank, gtm->mpi_win);
-            }
-            
-            if (access_mode == NONBLOCKING_ACCESS)
-            {
-                if (gtm->nb_op_proc_cnt[dst_rank] == 0)
-                    MPI_Win_lock(MPI_LOCK_SHARED, dst_rank, 0, gtm->mpi_win);
-                
-                ret = GTM_getBlockFromProcess(
+            } else {
+                ret = GTM_getBlockFromProcessMode(
                     gtm, dst_rank, blk_r_s, blk_r_num, 
-                    blk_c_s, blk_c_num, blk_ptr, src_buf_ld
+                    blk_c_s, blk_c_num, blk_ptr, src_buf_ld, trans, access_mode
                 );
-                
-                gtm->nb_op_proc_cnt[dst_rank]++;
-                gtm->nb_op_cnt++;
-                if (gtm->nb_op_cnt >= gtm->max_nb_get)
-                    GTM_waitNB(gtm);
             }
-            
-            if (access_mode == BATCH_ACCESS)
-            {
-                GTM_Req_Vector_t req_vec = gtm->req_vec[dst_rank];
-                ret = GTM_pushToReqVector(
-                    req_vec, MPI_NO_OP, blk_r_s, blk_r_num, 
-                    blk_c_s, blk_c_num, blk_ptr, src_buf_ld
-                );
-            }
-            
             if (ret != GTM_SUCCESS) return ret;
         }
     }
     return GTM_SUCCESS;
 }
 
+int GTM_getBlock_(GTM_PARAM, int access_mode)
+{
+    return GTM_getBlockInRange_(
+        gtm, row_start, row_num, col_start, col_num, 
+        src_buf, src_buf_ld, access_mode, NULL
+    );
+}
+
 // Get a block from the global matrix
 int GTM_getBlock(GTM_PARAM)
 {
@@ -286,9 +543,10 @@ int GTM_execBatchGet(GTMatrix_t gtm)
                 int blk_c_num  = req_vec->col_nums[i];
                 void *blk_ptr  = req_vec->src_bufs[i];
                 int src_buf_ld = req_vec->src_buf_lds[i];
+                int trans      = req_vec->trans[i];
                 int ret = GTM_getBlockFromProcess(
                     gtm, dst_rank, blk_r_s, blk_r_num, 
-                    blk_c_s, blk_c_num, blk_ptr, src_buf_ld
+                    blk_c_s, blk_c_num, blk_ptr, src_buf_ld, trans
                 );
                 if (ret != GTM_SUCCESS) return ret;
             }
@@ -27,5 +27,13 @@ int GTM_execBatchGet(GTMatrix_t gtm);
 // Stop a batch get epoch and disallow to submit get requests
 int GTM_stopBatchGet(GTMatrix_t gtm);
 
+// ========== Below are internal helper functions ========== //
+
+// Get a block, only search the owners of the block in search_range
+// Input parameters are the same as GTM_getBlock(), and:
+//   access_mode   : Access mode, see GTMatrix_Typedef.h
+//   *search_range : Process grid blocks to search for the owners of the block,
+//                   see GTM_findOwnerBlocks(), NULL means all blocks
+int GTM_getBlockInRange_(GTM_PARAM, int access_mode, const int *search_range);
 
 #endif
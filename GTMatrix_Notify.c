@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <mpi.h>
+
+#include "GTMatrix_Retval.h"
+#include "GTMatrix_Typedef.h"
+#include "GTMatrix_Other.h"
+#include "GTMatrix_Update.h"
+#include "GTMatrix_Notify.h"
+#include "utils.h"
+
+// Update a block and notify each process holding a part of the block
+// Input parameters are the same as GTM_updateBlock() without trans, alpha and access_mode
+static int GTM_updateBlockNotify(
+    GTMatrix_t gtm, MPI_Op op, 
+    int row_start, int row_num,
+    int col_start, int col_num,
+    void *src_buf, int src_buf_ld
+)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    if ((row_start < 0) || (col_start < 0) ||
+        (row_start + row_num > gtm->nrows)  ||
+        (col_start + col_num > gtm->ncols)  ||
+        (row_num * col_num == 0)) return GTM_INVALID_BLOCK;
+    
+    // Issue the updates of all pieces, then complete them and previous nonblocking 
+    // updates together, the notifications are posted after all updates are complete
+    int ret = GTM_updateBlock(
+        gtm, op, row_start, row_num, col_start, col_num, 
+        src_buf, src_buf_ld, gtm->col_major_buf, NULL, NONBLOCKING_ACCESS
+    );
+    if (ret != GTM_SUCCESS) return ret;
+    if (gtm->nb_op_cnt > 0) GTM_waitNB(gtm);
+    
+    int row_end = row_start + row_num - 1;
+    int col_end = col_start + col_num - 1;
+    int one = 1;
+    for (int blk_r = 0; blk_r < gtm->r_blocks; blk_r++)
+    {
+        int dst_r_s = gtm->r_displs[blk_r];
+        int dst_r_e = gtm->r_displs[blk_r + 1] - 1;
+        for (int blk_c = 0; blk_c < gtm->c_blocks; blk_c++)
+        {
+            int dst_c_s = gtm->c_displs[blk_c];
+            int dst_c_e = gtm->c_displs[blk_c + 1] - 1;
+            int blk_r_s, blk_r_e, blk_c_s, blk_c_e, intersect;
+            getRectIntersection(
+                dst_r_s,   dst_r_e, dst_c_s,   dst_c_e,
+                row_start, row_end, col_start, col_end,
+                &intersect, &blk_r_s, &blk_r_e, &blk_c_s, &blk_c_e
+            );
+            if (intersect == 0) continue;
+            
+            // Lower triangle pieces of a symmetric storage matrix are stored in the mirror process
+            int dst_rank = blk_r * gtm->c_blocks + blk_c;
+            if (gtm->symm_storage && (blk_r > blk_c)) dst_rank = blk_c * gtm->c_blocks + blk_r;
+            MPI_Accumulate(&one, 1, MPI_INT, dst_rank, 0, 1, MPI_INT, MPI_SUM, gtm->notify_win);
+        }
+    }
+    MPI_Win_flush_all(gtm->notify_win);
+    return GTM_SUCCESS;
+}
+
+int GTM_putBlockNotify(GTM_PARAM)
+{
+    return GTM_updateBlockNotify(
+        gtm, MPI_REPLACE, row_start, row_num, 
+        col_start, col_num, src_buf, src_buf_ld
+    );
+}
+
+int GTM_accBlockNotify(GTM_PARAM)
+{
+    return GTM_updateBlockNotify(
+        gtm, MPI_SUM, row_start, row_num, 
+        col_start, col_num, src_buf, src_buf_ld
+    );
+}
+
+int GTM_testNotify(GTMatrix_t gtm, int *count)
+{
+    if ((gtm == NULL) || (count == NULL)) return GTM_NULL_PTR;
+    int dummy = 0;
+    MPI_Fetch_and_op(&dummy, count, MPI_INT, gtm->my_rank, 0, MPI_NO_OP, gtm->notify_win);
+    MPI_Win_flush(gtm->my_rank, gtm->notify_win);
+    return GTM_SUCCESS;
+}
+
+int GTM_waitNotify(GTMatrix_t gtm, int count)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    if (count <= 0) return GTM_SUCCESS;
+    
+    // Only poll the local counter, no remote traffic
+    int received = 0, neg_count = -count, old;
+    while (received < count) GTM_testNotify(gtm, &received);
+    MPI_Fetch_and_op(&neg_count, &old, MPI_INT, gtm->my_rank, 0, MPI_SUM, gtm->notify_win);
+    MPI_Win_flush(gtm->my_rank, gtm->notify_win);
+    
+    // Updates are complete before the notifications, synchronize the public and 
+    // private copies of the local block so later local reads see the notified updates
+    if (gtm->nb_op_proc_cnt[gtm->my_rank] != 0)
+    {
+        MPI_Win_sync(gtm->mpi_win);
+    } else {
+        MPI_Win_lock(MPI_LOCK_SHARED, gtm->my_rank, 0, gtm->mpi_win);
+        MPI_Win_sync(gtm->mpi_win);
+        MPI_Win_unlock(gtm->my_rank, gtm->mpi_win);
+    }
+    return GTM_SUCCESS;
+}
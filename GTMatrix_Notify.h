@@ -0,0 +1,35 @@
+#ifndef __GTMATRIX_NOTIFY_H__
+#define __GTMATRIX_NOTIFY_H__
+
+#include <mpi.h>
+#include "GTMatrix_Typedef.h"
+
+// Notified updates for producer / consumer pipelines. Each process has a 
+// notification counter. A notified put / accumulate updates the block like 
+// GTM_putBlock() / GTM_accBlock(), then increases the notification counter of 
+// each process that holds a part of the block by 1. The increments are issued 
+// after the updates of all pieces are complete, so a consumer that sees the 
+// notification can read the updated elements without a GTM_sync(). All previous
+// nonblocking updates of this process are also complete before the notification.
+
+// Notified put / accumulate, GTM_PARAM is the same as GTM_putBlock()
+// Blocking call, the update and notification are finished when function returns
+// This call is not collective, not thread-safe
+int GTM_putBlockNotify(GTM_PARAM);
+int GTM_accBlockNotify(GTM_PARAM);
+
+// Wait until this process has received count notifications that are not 
+// consumed by a previous GTM_waitNotify(), then consume them
+// This call is not collective, not thread-safe
+// Input parameters:
+//   gtm   : GTMatrix handle
+//   count : Number of notifications to wait for
+int GTM_waitNotify(GTMatrix_t gtm, int count);
+
+// Get the number of received and not consumed notifications of this process
+// This call is not collective, not thread-safe
+// Output parameter:
+//   *count : Number of received and not consumed notifications
+int GTM_testNotify(GTMatrix_t gtm, int *count);
+
+#endif
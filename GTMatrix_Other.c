@@ -9,23 +9,175 @@
 #include "GTMatrix_Typedef.h"
 #include "GTMatrix_Get.h"
 #include "GTMatrix_Other.h"
+#include "GTMatrix_Track.h"
 
-int GTM_sync(GTMatrix_t gtm)
+// Let MPI make progress for passive target RMA operations while spinning
+static void GTM_syncProgress(GTMatrix_t gtm)
+{
+    int flag;
+    MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, gtm->mpi_comm, &flag, MPI_STATUS_IGNORE);
+}
+
+// Synchronize the public and private copies of the local block, so stores to 
+// the local block are visible to RMA operations of other processes and the 
+// updates from other processes are visible to local loads. MPI_Win_sync needs 
+// an access epoch, nonblocking accesses should be complete before calling it.
+static void GTM_syncLocalWin(GTMatrix_t gtm)
+{
+    MPI_Win_lock_all(0, gtm->mpi_win);
+    MPI_Win_sync(gtm->mpi_win);
+    MPI_Win_unlock_all(gtm->mpi_win);
+}
+
+// Post the leader barrier if all processes in this node have arrived
+static void GTM_tryPostLeaderBarrier(GTMatrix_t gtm)
+{
+    if (gtm->sync_posted) return;
+    if (__atomic_load_n(&gtm->sync_flags[0], __ATOMIC_ACQUIRE) < gtm->shm_size) return;
+    // Other processes in this node cannot arrive again before being released
+    __atomic_store_n(&gtm->sync_flags[0], 0, __ATOMIC_RELAXED);
+    MPI_Ibarrier(gtm->leader_comm, &gtm->sync_req);
+    gtm->sync_posted = 1;
+}
+
+int GTM_syncBegin(GTMatrix_t gtm)
 {
     if (gtm == NULL) return GTM_NULL_PTR;
-    if (SYNC_IBARRIER == 1)
+    if (gtm->in_sync) return GTM_IN_SYNC;
+    
+    // Nonblocking accesses and tile stamps should be complete at the targets before arriving
+    GTM_waitNB(gtm);
+    GTM_flushTileStamps(gtm);
+    GTM_syncLocalWin(gtm);
+    gtm->in_sync = 1;
+    
+    if (gtm->hier_sync == 0)
     {
         // Observed that on some Skylake & KNL machine with IMPI 17, when not all
         // MPI processes have RMA calls, a MPI_Barrier will lead to deadlock when 
         // running more than 16 MPI processes on the same node. Don't know why using  
         // a MPI_Ibarrier + MPI_Ibarrier can solve this problem...
-        MPI_Status  status;
-        MPI_Request req;
-        MPI_Ibarrier(gtm->mpi_comm, &req);
-        MPI_Wait(&req, &status);
+        if (SYNC_IBARRIER == 1) MPI_Ibarrier(gtm->mpi_comm, &gtm->sync_req);
+        return GTM_SUCCESS;
+    }
+    
+    // Arrive at the node barrier, the release order makes previous stores 
+    // of this process visible to the processes that pass the barrier
+    gtm->sync_sense  = 1 - gtm->sync_sense;
+    gtm->sync_posted = 0;
+    __atomic_fetch_add(&gtm->sync_flags[0], 1, __ATOMIC_ACQ_REL);
+    if (gtm->shm_rank == 0) GTM_tryPostLeaderBarrier(gtm);
+    return GTM_SUCCESS;
+}
+
+int GTM_syncEnd(GTMatrix_t gtm)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    if (gtm->in_sync == 0) return GTM_NO_SYNC;
+    
+    if (gtm->hier_sync == 0)
+    {
+        if (SYNC_IBARRIER == 1) MPI_Wait(&gtm->sync_req, MPI_STATUS_IGNORE);
+        else MPI_Barrier(gtm->mpi_comm);
+        GTM_syncLocalWin(gtm);
+        gtm->in_sync = 0;
+        gtm->track_version++;
+        return GTM_SUCCESS;
+    }
+    
+    if (gtm->shm_rank == 0)
+    {
+        // Leader: wait for the node, then for other nodes, then release the node
+        while (gtm->sync_posted == 0)
+        {
+            GTM_tryPostLeaderBarrier(gtm);
+            GTM_syncProgress(gtm);
+        }
+        MPI_Wait(&gtm->sync_req, MPI_STATUS_IGNORE);
+        __atomic_store_n(&gtm->sync_flags[1], gtm->sync_sense, __ATOMIC_RELEASE);
     } else {
-        MPI_Barrier(gtm->mpi_comm);
+        while (__atomic_load_n(&gtm->sync_flags[1], __ATOMIC_ACQUIRE) != gtm->sync_sense)
+            GTM_syncProgress(gtm);
     }
+    GTM_syncLocalWin(gtm);
+    gtm->in_sync = 0;
+    gtm->track_version++;
+    return GTM_SUCCESS;
+}
+
+int GTM_sync(GTMatrix_t gtm)
+{
+    int ret = GTM_syncBegin(gtm);
+    if (ret != GTM_SUCCESS) return ret;
+    return GTM_syncEnd(gtm);
+}
+
+int GTM_syncTouched(GTMatrix_t gtm, int *n_incoming)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    if (gtm->in_sync) return GTM_IN_SYNC;
+    
+    // Blocking updates are complete when returning, complete nonblocking updates
+    GTM_waitNB(gtm);
+    GTM_flushTileStamps(gtm);
+    
+    // Tell each updated process how many operations it received from this process. 
+    // Consecutive calls use different tags: a process that has finished this call 
+    // may send messages of the next call while others are still receiving.
+    int tag = GTM_SYNC_TOUCHED_TAG + (gtm->track_version & 1);
+    int n_dst = 0, recv_cnt, incoming = 0;
+    MPI_Request *send_reqs = (MPI_Request*) malloc(sizeof(MPI_Request) * (gtm->n_touched + 1));
+    if (send_reqs == NULL) return GTM_ALLOC_FAILED;
+    for (int i = 0; i < gtm->n_touched; i++)
+    {
+        int dst_rank = gtm->touched_list[i];
+        if (dst_rank == gtm->my_rank) continue;
+        MPI_Issend(
+            &gtm->touched_cnt[dst_rank], 1, MPI_INT, dst_rank, 
+            tag, gtm->mpi_comm, &send_reqs[n_dst]
+        );
+        n_dst++;
+    }
+    
+    // Nonblocking consensus: receive messages until all of this process's 
+    // synchronous sends are matched and then all processes reach the barrier
+    MPI_Request barrier_req;
+    int barrier_posted = 0, done = 0;
+    while (done == 0)
+    {
+        int flag;
+        MPI_Status status;
+        MPI_Iprobe(MPI_ANY_SOURCE, tag, gtm->mpi_comm, &flag, &status);
+        if (flag)
+        {
+            MPI_Recv(
+                &recv_cnt, 1, MPI_INT, status.MPI_SOURCE, 
+                tag, gtm->mpi_comm, MPI_STATUS_IGNORE
+            );
+            incoming += recv_cnt;
+        }
+        if (barrier_posted)
+        {
+            MPI_Test(&barrier_req, &done, MPI_STATUS_IGNORE);
+        } else {
+            int sent;
+            MPI_Testall(n_dst, send_reqs, &sent, MPI_STATUSES_IGNORE);
+            if (sent)
+            {
+                MPI_Ibarrier(gtm->mpi_comm, &barrier_req);
+                barrier_posted = 1;
+            }
+        }
+    }
+    free(send_reqs);
+    
+    // Updates from this process to itself, only the touched processes are reset
+    incoming += gtm->touched_cnt[gtm->my_rank];
+    for (int i = 0; i < gtm->n_touched; i++) gtm->touched_cnt[gtm->touched_list[i]] = 0;
+    gtm->n_touched = 0;
+    if (n_incoming != NULL) *n_incoming = incoming;
+    gtm->track_version++;
+    __sync_synchronize();
     return GTM_SUCCESS;
 }
 
@@ -41,48 +193,131 @@ int GTM_waitNB(GTMatrix_t gtm)
         }
     }
     gtm->nb_op_cnt = 0;
+    GTM_freeTmpBuffers(gtm);
     return GTM_SUCCESS;
 }
 
-int GTM_fill(GTMatrix_t gtm, void *value)
+void *GTM_getLocalWriteBlock(GTMatrix_t gtm)
+{
+    return (char*) gtm->mat_block + (size_t) gtm->wr_offset * (size_t) gtm->unit_size;
+}
+
+void GTM_copyLocalPublishedBlock(GTMatrix_t gtm)
+{
+    if (gtm->versioned == 0) return;
+    if (gtm->symm_storage && (gtm->my_rowblk > gtm->my_colblk)) return;
+    int f_nrows = gtm->col_major ? gtm->my_ncols : gtm->my_nrows;
+    int f_ncols = gtm->col_major ? gtm->my_nrows : gtm->my_ncols;
+    size_t row_msize = (size_t) f_ncols * (size_t) gtm->unit_size;
+    size_t ld_msize  = (size_t) gtm->ld_local * (size_t) gtm->unit_size;
+    char *src = (char*) gtm->mat_block + (size_t) gtm->rd_offset * (size_t) gtm->unit_size;
+    char *dst = (char*) gtm->mat_block + (size_t) gtm->wr_offset * (size_t) gtm->unit_size;
+    if (gtm->tile_size > 0)
+    {
+        // Tile-major layout, copy all tiles including the padding
+        memcpy(dst, src, (size_t) gtm->ver_stride * (size_t) gtm->unit_size);
+        return;
+    }
+    for (int irow = 0; irow < f_nrows; irow++)
+        memcpy(dst + irow * ld_msize, src + irow * ld_msize, row_msize);
+}
+
+int GTM_publish(GTMatrix_t gtm)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    if (gtm->versioned == 0) return GTM_INVALID_FLAGS;
+    
+    // All updates to the write version and all reads of the published 
+    // version are finished after the synchronization
+    int ret = GTM_sync(gtm);
+    if (ret != GTM_SUCCESS) return ret;
+    gtm->version++;
+    int tmp = gtm->rd_offset;
+    gtm->rd_offset = gtm->wr_offset;
+    gtm->wr_offset = tmp;
+    return GTM_SUCCESS;
+}
+
+int GTM_copyPublished(GTMatrix_t gtm)
 {
     if (gtm == NULL) return GTM_NULL_PTR;
+    if (gtm->versioned == 0) return GTM_INVALID_FLAGS;
+    GTM_copyLocalPublishedBlock(gtm);
+    return GTM_sync(gtm);
+}
+
+void GTM_fillLocalRect(
+    GTMatrix_t gtm, void *value, int lrow_start, int lrow_num, 
+    int lcol_start, int lcol_num
+)
+{
+    // With versioned storage, fill the write version
+    void *mat_block = GTM_getLocalWriteBlock(gtm);
+    GTM_stampTiles(
+        gtm, gtm->my_rank, gtm->r_displs[gtm->my_rowblk] + lrow_start, lrow_num, 
+        gtm->c_displs[gtm->my_colblk] + lcol_start, lcol_num
+    );
+    // Fill the storage frame row by row, each run inside a tile is contiguous
+    int f_row_s = gtm->col_major ? lcol_start : lrow_start;
+    int f_col_s = gtm->col_major ? lrow_start : lcol_start;
+    int f_row_e = f_row_s + (gtm->col_major ? lcol_num : lrow_num);
+    int f_col_e = f_col_s + (gtm->col_major ? lrow_num : lcol_num);
     if (gtm->unit_size == 4)
     {
         int _value, *ptr;
         memcpy(&_value, value, 4);
-        ptr = (int*) gtm->mat_block;
-        for (int i = 0; i < gtm->my_nrows; i++)
+        ptr = (int*) mat_block;
+        for (int i = f_row_s; i < f_row_e; i++)
         {
-            int offset_i = i * gtm->ld_local;
-            for (int j = 0; j < gtm->my_ncols; j++) 
-                ptr[offset_i + j] = _value;
+            for (int j0 = f_col_s, nj; j0 < f_col_e; j0 += nj)
+            {
+                nj = GTM_TILE_SPAN(gtm, j0, f_col_e - j0);
+                size_t offset_i = GTM_STORAGE_OFFSET(gtm, i, j0);
+                for (int j = 0; j < nj; j++) 
+                    ptr[offset_i + j] = _value;
+            }
         }
     }
     if (gtm->unit_size == 8)
     {
         double _value, *ptr;
         memcpy(&_value, value, 8);
-        ptr = (double*) gtm->mat_block;
-        for (int i = 0; i < gtm->my_nrows; i++)
+        ptr = (double*) mat_block;
+        for (int i = f_row_s; i < f_row_e; i++)
         {
-            int offset_i = i * gtm->ld_local;
-            for (int j = 0; j < gtm->my_ncols; j++) 
-                ptr[offset_i + j] = _value;
+            for (int j0 = f_col_s, nj; j0 < f_col_e; j0 += nj)
+            {
+                nj = GTM_TILE_SPAN(gtm, j0, f_col_e - j0);
+                size_t offset_i = GTM_STORAGE_OFFSET(gtm, i, j0);
+                for (int j = 0; j < nj; j++) 
+                    ptr[offset_i + j] = _value;
+            }
         }
     }
     if (gtm->unit_size == 16)
     {
         double _Complex _value, *ptr;
         memcpy(&_value, value, 16);
-        ptr = (double _Complex*) gtm->mat_block;
-        for (int i = 0; i < gtm->my_nrows; i++)
+        ptr = (double _Complex*) mat_block;
+        for (int i = f_row_s; i < f_row_e; i++)
         {
-            int offset_i = i * gtm->ld_local;
-            for (int j = 0; j < gtm->my_ncols; j++) 
-                ptr[offset_i + j] = _value;
+            for (int j0 = f_col_s, nj; j0 < f_col_e; j0 += nj)
+            {
+                nj = GTM_TILE_SPAN(gtm, j0, f_col_e - j0);
+                size_t offset_i = GTM_STORAGE_OFFSET(gtm, i, j0);
+                for (int j = 0; j < nj; j++) 
+                    ptr[offset_i + j] = _value;
+            }
         }
     }
+}
+
+int GTM_fill(GTMatrix_t gtm, void *value)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    // With symmetric storage, processes in the lower triangle store nothing
+    if (gtm->symm_storage && (gtm->my_rowblk > gtm->my_colblk)) return GTM_SUCCESS;
+    GTM_fillLocalRect(gtm, value, 0, gtm->my_nrows, 0, gtm->my_ncols);
     return GTM_SUCCESS;
 }
 
@@ -91,6 +326,9 @@ int GTM_symmetrize(GTMatrix_t gtm)
     if (gtm == NULL) return GTM_NULL_PTR;
     if (gtm->nrows != gtm->ncols) return GTM_NOT_SQUARE_MAT;
     
+    // Symmetric storage is always symmetric
+    if (gtm->symm_storage) return GTM_sync(gtm);
+    
     // This process holds [rs:re, cs:ce], need to fetch [cs:ce, rs:re]
     void *rcv_buf = gtm->symm_buf;
 
@@ -99,26 +337,33 @@ int GTM_symmetrize(GTMatrix_t gtm)
     
     GTM_sync(gtm);
     
+    int rcv_ld = gtm->col_major_buf ? gtm->my_ncols : gtm->my_nrows;
     GTM_getBlock(
         gtm, my_col_start, gtm->my_ncols, 
         my_row_start, gtm->my_nrows, 
-        rcv_buf, gtm->my_nrows
+        rcv_buf, rcv_ld
     );
     
     // Wait all processes to get the symmetric block before modifying
     // local block, or some processes will get the modified block
     GTM_sync(gtm);
     
+    // With versioned storage, the result of the published version is written 
+    // to the write version
+    void *mat_block = GTM_getLocalWriteBlock(gtm);
+    if (gtm->versioned) GTM_copyLocalPublishedBlock(gtm);
+    GTM_stampTiles(gtm, gtm->my_rank, my_row_start, gtm->my_nrows, my_col_start, gtm->my_ncols);
+    
     if (MPI_INT == gtm->datatype)
     {
-        int *src_buf = (int*) gtm->mat_block;
+        int *src_buf = (int*) mat_block;
         int *dst_buf = (int*) rcv_buf;
         for (int irow = 0; irow < gtm->my_nrows; irow++)
         {
             for (int icol = 0; icol < gtm->my_ncols; icol++)
             {
-                int idx_s = irow * gtm->ld_local + icol;
-                int idx_d = icol * gtm->my_nrows + irow;
+                size_t idx_s = GTM_LOCAL_OFFSET(gtm, irow, icol);
+                size_t idx_d = GTM_BUF_OFFSET(gtm, rcv_ld, icol, irow);
                 src_buf[idx_s] += dst_buf[idx_d];
                 src_buf[idx_s] /= 2;
             }
@@ -126,14 +371,14 @@ int GTM_symmetrize(GTMatrix_t gtm)
     }
     if (MPI_DOUBLE == gtm->datatype)
     {
-        double *src_buf = (double*) gtm->mat_block;
+        double *src_buf = (double*) mat_block;
         double *dst_buf = (double*) rcv_buf;
         for (int irow = 0; irow < gtm->my_nrows; irow++)
         {
             for (int icol = 0; icol < gtm->my_ncols; icol++)
             {
-                int idx_s = irow * gtm->ld_local + icol;
-                int idx_d = icol * gtm->my_nrows + irow;
+                size_t idx_s = GTM_LOCAL_OFFSET(gtm, irow, icol);
+                size_t idx_d = GTM_BUF_OFFSET(gtm, rcv_ld, icol, irow);
                 src_buf[idx_s] += dst_buf[idx_d];
                 src_buf[idx_s] *= 0.5;
             }
@@ -141,14 +386,14 @@ int GTM_symmetrize(GTMatrix_t gtm)
     }
     if (MPI_C_DOUBLE_COMPLEX == gtm->datatype)
     {
-        double _Complex *src_buf = (double _Complex*) gtm->mat_block;
+        double _Complex *src_buf = (double _Complex*) mat_block;
         double _Complex *dst_buf = (double _Complex*) rcv_buf;
         for (int irow = 0; irow < gtm->my_nrows; irow++)
         {
             for (int icol = 0; icol < gtm->my_ncols; icol++)
             {
-                int idx_s = irow * gtm->ld_local + icol;
-                int idx_d = icol * gtm->my_nrows + irow;
+                size_t idx_s = GTM_LOCAL_OFFSET(gtm, irow, icol);
+                size_t idx_d = GTM_BUF_OFFSET(gtm, rcv_ld, icol, irow);
                 src_buf[idx_s] += conj(dst_buf[idx_d]);
                 src_buf[idx_s] *= 0.5;
             }
@@ -157,3 +402,149 @@ int GTM_symmetrize(GTMatrix_t gtm)
     
     return GTM_sync(gtm);
 }
+
+int GTM_setBufferLayout(GTMatrix_t gtm, int buf_layout)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    if ((buf_layout != GTM_BUF_ROW_MAJOR) && (buf_layout != GTM_BUF_COL_MAJOR)) return GTM_INVALID_FLAGS;
+    gtm->col_major_buf = (buf_layout == GTM_BUF_COL_MAJOR) ? 1 : 0;
+    return GTM_SUCCESS;
+}
+
+void GTM_findOwnerBlocks(
+    GTMatrix_t gtm, int row_start, int row_num, int col_start, int col_num, 
+    const int *search_range, int *owner_range
+)
+{
+    int r_lo = 0, r_hi = gtm->r_blocks - 1, c_lo = 0, c_hi = gtm->c_blocks - 1;
+    if (search_range != NULL)
+    {
+        r_lo = search_range[0];
+        r_hi = search_range[1];
+        c_lo = search_range[2];
+        c_hi = search_range[3];
+    }
+    
+    int r_nblk = r_hi - r_lo + 1, c_nblk = c_hi - c_lo + 1;
+    owner_range[0] = r_lo + GTM_findBlockIndex(gtm->r_displs + r_lo, r_nblk, row_start);
+    owner_range[1] = r_lo + GTM_findBlockIndex(gtm->r_displs + r_lo, r_nblk, row_start + row_num - 1);
+    owner_range[2] = c_lo + GTM_findBlockIndex(gtm->c_displs + c_lo, c_nblk, col_start);
+    owner_range[3] = c_lo + GTM_findBlockIndex(gtm->c_displs + c_lo, c_nblk, col_start + col_num - 1);
+}
+
+int GTM_findBlockIndex(const int *displs, int nblocks, int x)
+{
+    int blk = 0;
+    while ((blk < nblocks - 1) && (displs[blk + 1] <= x)) blk++;
+    return blk;
+}
+
+int GTM_copyPartition(
+    int nrows, int ncols, int r_blocks, int c_blocks, 
+    const int *r_displs, const int *c_displs, int **_r_displs, 
+    int **_r_blklens, int **_c_displs, int **_c_blklens
+)
+{
+    // Validate r_displs and c_displs
+    int r_displs_valid = 1, c_displs_valid = 1;
+    if (r_displs[0] != 0) r_displs_valid = 0;
+    if (c_displs[0] != 0) c_displs_valid = 0;
+    if (r_displs[r_blocks] != nrows) r_displs_valid = 0;
+    if (c_displs[c_blocks] != ncols) c_displs_valid = 0;
+    for (int i = 0; i < r_blocks; i++)
+        if (r_displs[i + 1] - r_displs[i] <= 0) r_displs_valid = 0;
+    for (int i = 0; i < c_blocks; i++)
+        if (c_displs[i + 1] - c_displs[i] <= 0) c_displs_valid = 0;
+    if (r_displs_valid == 0) return GTM_INVALID_R_DISPLS;
+    if (c_displs_valid == 0) return GTM_INVALID_C_DISPLS;
+    
+    // Copy displacement arrays, then generate r_blklens and c_blklens
+    size_t r_displs_msize = sizeof(int) * (r_blocks + 1);
+    size_t c_displs_msize = sizeof(int) * (c_blocks + 1);
+    int *r_displs_ = (int*) malloc(r_displs_msize);
+    int *c_displs_ = (int*) malloc(c_displs_msize);
+    int *r_blklens = (int*) malloc(r_displs_msize);
+    int *c_blklens = (int*) malloc(c_displs_msize);
+    if ((r_displs_ == NULL) || (c_displs_ == NULL) || (r_blklens == NULL) || (c_blklens == NULL))
+    {
+        free(r_displs_);
+        free(c_displs_);
+        free(r_blklens);
+        free(c_blklens);
+        return GTM_ALLOC_FAILED;
+    }
+    memcpy(r_displs_, r_displs, r_displs_msize);
+    memcpy(c_displs_, c_displs, c_displs_msize);
+    for (int i = 0; i < r_blocks; i++) r_blklens[i] = r_displs[i + 1] - r_displs[i];
+    for (int i = 0; i < c_blocks; i++) c_blklens[i] = c_displs[i + 1] - c_displs[i];
+    
+    *_r_displs  = r_displs_;
+    *_r_blklens = r_blklens;
+    *_c_displs  = c_displs_;
+    *_c_blklens = c_blklens;
+    return GTM_SUCCESS;
+}
+
+void GTM_createTransBlockType(GTMatrix_t gtm, int row_num, int col_num, int ld, MPI_Datatype *dt)
+{
+    MPI_Datatype col_dt, col_dt_rs;
+    MPI_Type_vector(row_num, 1, ld, gtm->datatype, &col_dt);
+    MPI_Type_create_resized(col_dt, 0, gtm->unit_size, &col_dt_rs);
+    MPI_Type_contiguous(col_num, col_dt_rs, dt);
+    MPI_Type_commit(dt);
+    MPI_Type_free(&col_dt);
+    MPI_Type_free(&col_dt_rs);
+}
+
+int GTM_reserveTmpBuffer(GTMatrix_t gtm)
+{
+    if (gtm->n_tmp_buf + gtm->n_tmp_rsv >= gtm->max_tmp_buf)
+    {
+        int new_max = (gtm->max_tmp_buf == 0) ? 16 : gtm->max_tmp_buf * 2;
+        void **new_bufs = (void**) realloc(gtm->tmp_bufs, sizeof(void*) * new_max);
+        if (new_bufs == NULL) return GTM_ALLOC_FAILED;
+        gtm->tmp_bufs    = new_bufs;
+        gtm->max_tmp_buf = new_max;
+    }
+    gtm->n_tmp_rsv++;
+    return GTM_SUCCESS;
+}
+
+void GTM_keepTmpBuffer(GTMatrix_t gtm, void *buf)
+{
+    gtm->n_tmp_rsv--;
+    gtm->tmp_bufs[gtm->n_tmp_buf++] = buf;
+}
+
+void GTM_freeTmpBuffers(GTMatrix_t gtm)
+{
+    if (gtm->nb_op_cnt > 0) return;
+    for (int i = 0; i < gtm->comm_size; i++)
+        if (gtm->req_vec[i]->curr_size > 0) return;
+    for (int i = 0; i < gtm->n_tmp_buf; i++) free(gtm->tmp_bufs[i]);
+    gtm->n_tmp_buf = 0;
+}
+
+void GTM_conjBlock(GTMatrix_t gtm, void *buf, int buf_ld, int row_num, int col_num)
+{
+    if (MPI_C_DOUBLE_COMPLEX != gtm->datatype) return;
+    double _Complex *ptr = (double _Complex*) buf;
+    for (int irow = 0; irow < row_num; irow++)
+    {
+        double _Complex *row_ptr = ptr + irow * buf_ld;
+        for (int icol = 0; icol < col_num; icol++)
+            row_ptr[icol] = conj(row_ptr[icol]);
+    }
+}
+
+int GTM_checkUpdateOp(GTMatrix_t gtm, MPI_Op op)
+{
+    int is_int = ((MPI_INT == gtm->datatype) || GTM_IS_INT64_TYPE(gtm->datatype)) ? 1 : 0;
+    if ((MPI_SUM == op) || (MPI_PROD == op) || (MPI_REPLACE == op)) return GTM_SUCCESS;
+    if ((MPI_MAX == op) || (MPI_MIN == op))
+        return (MPI_C_DOUBLE_COMPLEX == gtm->datatype) ? GTM_INVALID_OP : GTM_SUCCESS;
+    if ((MPI_BAND == op) || (MPI_BOR == op) || (MPI_BXOR == op) || 
+        (MPI_LAND == op) || (MPI_LOR == op) || (MPI_LXOR == op))
+        return is_int ? GTM_SUCCESS : GTM_INVALID_OP;
+    return GTM_INVALID_OP;
+}
\ No newline at end of file
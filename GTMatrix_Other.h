@@ -5,12 +5,43 @@
 
 #define SYNC_IBARRIER 1
 
-// Synchronize all processes
+// Synchronize all processes, same as GTM_syncBegin() + GTM_syncEnd()
+// This call is collective, not thread-safe
 int GTM_sync(GTMatrix_t gtm);
 
+// Split-phase synchronization of all processes, computation can be placed 
+// between GTM_syncBegin() and GTM_syncEnd() to overlap with the barrier.
+// GTM_syncBegin() completes all nonblocking accesses of this process, 
+// GTM_syncEnd() returns after all processes have called GTM_syncBegin(), so 
+// all RMA operations before GTM_syncBegin() on all processes are complete and 
+// visible. The barrier is hierarchical: processes in the same shared memory 
+// node use a sense-reversing barrier in shared memory, and only one leader 
+// process of each node joins a barrier across nodes. Set environment variable 
+// GTM_HIER_SYNC=0 to use a flat MPI_Ibarrier on all processes.
+// These calls are collective, not thread-safe
+int GTM_syncBegin(GTMatrix_t gtm);
+int GTM_syncEnd(GTMatrix_t gtm);
+
 // Complete all nonblocking accesses
 int GTM_waitNB(GTMatrix_t gtm);
 
+// Sparse synchronization: complete all accesses of this process, then wait 
+// until all update operations to this process's local block (put, accumulate, 
+// read-modify-write) issued before other processes' GTM_syncTouched() are 
+// complete. Only the processes that updated each other exchange messages, using 
+// a nonblocking consensus (synchronous sends + MPI_Ibarrier), so the cost scales 
+// with the number of communication partners instead of the number of processes. 
+// Unlike GTM_sync(), reading blocks of other processes after this call may see 
+// updates that are still in progress.
+// This call is collective, not thread-safe
+// Output parameter:
+//   *n_incoming : Number of update operations to this process since the last 
+//                 GTM_syncTouched(), can be NULL
+int GTM_syncTouched(GTMatrix_t gtm, int *n_incoming);
+
+#define GTM_SYNC_TOUCHED_TAG  0x4754  // MPI tags of GTM_syncTouched() messages, consecutive 
+                                      // calls alternate between this tag and this tag + 1
+
 // Fill the GTMatrix with a single value
 // This call is collective, not thread-safe
 // Input parameter:
@@ -19,7 +50,101 @@ int GTM_waitNB(GTMatrix_t gtm);
 int GTM_fill(GTMatrix_t gtm, void *value);
 
 // Symmetrize a matrix, i.e. (A + A^T) / 2, now support int, double, and double _Complex
+// With versioned storage, the symmetrized published version is written to the write version
 // This call is collective, not thread-safe
 int GTM_symmetrize(GTMatrix_t gtm);
 
+// Publish the write version of a GTMatrix with versioned storage (GTM_STORAGE_VERSIONED):
+// after all processes finish their updates and reads, version N+1 becomes the 
+// published version and the buffer of version N becomes the write version. 
+// No data is copied, the write version still holds version N-1 data. 
+// This call is collective, not thread-safe
+int GTM_publish(GTMatrix_t gtm);
+
+// Copy the published version to the write version, so updates of the write 
+// version start from the published matrix. Call it before any process updates 
+// the write version, e.g. right after GTM_publish().
+// This call is collective, not thread-safe
+int GTM_copyPublished(GTMatrix_t gtm);
+
+// Set the layout of user block buffers of a GTMatrix, the default is GTM_BUF_ROW_MAJOR.
+// With GTM_BUF_COL_MAJOR, all block buffers (src_buf of get / put / accumulate 
+// and fetch_buf of GTM_fetchAccBlock()) are column-major, element (i, j) of a 
+// buffer with leading dimension ld is buf[j * ld + i]. Data types and shared
+// memory kernels convert the layout during the transfer.
+// This call is not collective, not thread-safe
+// Input parameter:
+//   buf_layout : GTM_BUF_ROW_MAJOR or GTM_BUF_COL_MAJOR
+int GTM_setBufferLayout(GTMatrix_t gtm, int buf_layout);
+
+// ========== Below are internal helper functions ========== //
+
+// Create a committed MPI data type that traverses a row_num * col_num block 
+// in a matrix block with leading dimension ld column by column, so it matches
+// a row-major col_num * row_num buffer that holds the transpose of the block
+void GTM_createTransBlockType(GTMatrix_t gtm, int row_num, int col_num, int ld, MPI_Datatype *dt);
+
+// Find the process grid blocks that contain a block of the global matrix
+// Input parameters:
+//   row_start, row_num, col_start, col_num : The block, must be inside the matrix
+//   *search_range : Range of blocks to search, {first row block, last row block, 
+//                   first column block, last column block}, NULL means all blocks,
+//                   it must contain the block
+// Output parameter:
+//   *owner_range  : Range of blocks containing the block, same format as search_range
+void GTM_findOwnerBlocks(
+    GTMatrix_t gtm, int row_start, int row_num, int col_start, int col_num, 
+    const int *search_range, int *owner_range
+);
+
+// Find the block that contains position x, block i is [displs[i], displs[i + 1])
+int GTM_findBlockIndex(const int *displs, int nblocks, int x);
+
+// Copy and validate the displacement arrays of a nrows * ncols matrix on a 
+// r_blocks * c_blocks process grid and generate the block length arrays, used
+// by distributed structures with the same partition as GTMatrix. The output 
+// arrays are allocated with malloc(), nothing is allocated if it fails.
+// Output parameters:
+//   *_r_displs, *_c_displs   : Copies of r_displs and c_displs
+//   *_r_blklens, *_c_blklens : Length of each block on row / column direction
+//   @return : GTM_SUCCESS, GTM_ALLOC_FAILED, GTM_INVALID_R_DISPLS or GTM_INVALID_C_DISPLS
+int GTM_copyPartition(
+    int nrows, int ncols, int r_blocks, int c_blocks, 
+    const int *r_displs, const int *c_displs, int **_r_displs, 
+    int **_r_blklens, int **_c_displs, int **_c_blklens
+);
+
+// Fill rows [lrow_start, lrow_start + lrow_num) and columns [lcol_start, 
+// lcol_start + lcol_num) of the write version of the local matrix block with
+// a single value, local indices
+void GTM_fillLocalRect(
+    GTMatrix_t gtm, void *value, int lrow_start, int lrow_num, 
+    int lcol_start, int lcol_num
+);
+
+// Temporary source buffers of batch and nonblocking updates must stay valid
+// until the updates finish. Reserve a slot before posting the updates of a 
+// malloc()-ed buffer, then keep the buffer in the slot after posting them, so
+// a GTM_waitNB() in between does not free it. Kept buffers are freed when no
+// nonblocking operation and no batch request is pending.
+int  GTM_reserveTmpBuffer(GTMatrix_t gtm);
+void GTM_keepTmpBuffer(GTMatrix_t gtm, void *buf);
+void GTM_freeTmpBuffers(GTMatrix_t gtm);
+
+// Conjugate a block in place if the GTMatrix data type is double _Complex
+void GTM_conjBlock(GTMatrix_t gtm, void *buf, int buf_ld, int row_num, int col_num);
+
+// Get the pointer of the write version of the local matrix block
+void *GTM_getLocalWriteBlock(GTMatrix_t gtm);
+
+// Copy the published version of the local matrix block to the write version
+void GTM_copyLocalPublishedBlock(GTMatrix_t gtm);
+
+// 64-bit integer data types
+#define GTM_IS_INT64_TYPE(dt) ((MPI_INT64_T == (dt)) || (MPI_LONG_LONG == (dt)))
+
+// Check if op is a predefined MPI operation that can be used to update the 
+// GTMatrix data type with MPI_Accumulate, return GTM_SUCCESS or GTM_INVALID_OP
+int GTM_checkUpdateOp(GTMatrix_t gtm, MPI_Op op);
+
 #endif
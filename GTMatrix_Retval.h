@@ -17,11 +17,18 @@
 #define GTM_IN_BATCHED_PUT   0x000D  // GTMatrix is in batched put mode
 #define GTM_IN_BATCHED_ACC   0x000E  // GTMatrix is in batched acc mode
 #define GTM_NOT_SQUARE_MAT   0x000F  // GTMatrix failed to symmetrize a non-square matrix
+#define GTM_TILE_POOL_FULL   0x0010  // GTMatrix block-sparse matrix has no free tile pool slot on target process
+#define GTM_INVALID_FLAGS    0x0011  // GTMatrix failed to create with invalid storage flags or partition for the flags
+#define GTM_INVALID_OP       0x0012  // GTMatrix update operation is not a predefined MPI operation supported for the data type
+#define GTM_IN_SYNC          0x0013  // GTMatrix is in a split-phase synchronization
+#define GTM_NO_SYNC          0x0014  // GTMatrix is not in a split-phase synchronization
+#define GTM_NOT_POS_DEF      0x0015  // GTMatrix failed to factorize a matrix that is not positive definite
 
 #define GTM_RV_SUCCESS       0x0000  // GTMatrix request vector operation is performed successfully
 #define GTM_RV_NULL_PTR      0x0101  // GTMatrix request vector pointer is NULL
 #define GTM_RV_ALLOC_FAILED  0x0102  // GTMatrix request vector failed to allocate memory
 #define GTM_RV_RESIZE_FAILED 0x0103  // GTMatrix request vector failed to allocate memory when resizing
+#define GTM_RV_INVALID_REQ   0x0104  // GTMatrix request vector has no such request or the parameter is too large
 
 #define GTM_TQ_SUCCESS       0x0000  // GTMatrix task queue operation is performed successfully
 #define GTM_TQ_NULL_PTR     -0x0201  // GTMatrix task queue pointer is NULL
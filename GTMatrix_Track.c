@@ -0,0 +1,255 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <mpi.h>
+
+#include "GTMatrix_Retval.h"
+#include "GTMatrix_Typedef.h"
+#include "GTMatrix_Get.h"
+#include "GTMatrix_Other.h"
+#include "GTMatrix_Track.h"
+#include "utils.h"
+
+int GTM_createTileStamps(GTMatrix_t gtm)
+{
+    gtm->track_tile_size = GTM_TRACK_TILE_SIZE;
+    char *track_tile_size_p = getenv("GTM_TRACK_TILE_SIZE");
+    if (track_tile_size_p != NULL) gtm->track_tile_size = atoi(track_tile_size_p);
+    if (gtm->track_tile_size < 1) gtm->track_tile_size = GTM_TRACK_TILE_SIZE;
+    int tts = gtm->track_tile_size;
+    int n_tiles = ((gtm->my_nrows + tts - 1) / tts) * ((gtm->my_ncols + tts - 1) / tts);
+    MPI_Allreduce(&n_tiles, &gtm->max_track_tiles, 1, MPI_INT, MPI_MAX, gtm->mpi_comm);
+    if (gtm->max_track_tiles < 1) gtm->max_track_tiles = 1;
+    
+    gtm->stamp_buf   = (int*)  malloc(sizeof(int) * gtm->max_track_tiles);
+    gtm->pend_stamps = (int**) calloc(gtm->comm_size, sizeof(int*));
+    gtm->pend_list   = (int*)  malloc(sizeof(int) * gtm->comm_size);
+    gtm->n_pend      = 0;
+    if ((gtm->stamp_buf == NULL) || (gtm->pend_stamps == NULL) || (gtm->pend_list == NULL)) 
+        return GTM_ALLOC_FAILED;
+    MPI_Win_allocate(
+        (MPI_Aint) sizeof(int) * (MPI_Aint) gtm->max_track_tiles, sizeof(int), 
+        MPI_INFO_NULL, gtm->mpi_comm, &gtm->tile_stamps, &gtm->track_win
+    );
+    memset(gtm->tile_stamps, 0, sizeof(int) * gtm->max_track_tiles);
+    MPI_Win_lock_all(0, gtm->track_win);
+    MPI_Barrier(gtm->mpi_comm);
+    return GTM_SUCCESS;
+}
+
+void GTM_destroyTileStamps(GTMatrix_t gtm)
+{
+    MPI_Win_unlock_all(gtm->track_win);
+    MPI_Win_free(&gtm->track_win);
+    for (int i = 0; i < gtm->n_pend; i++) free(gtm->pend_stamps[gtm->pend_list[i]]);
+    free(gtm->stamp_buf);
+    free(gtm->pend_stamps);
+    free(gtm->pend_list);
+}
+
+void GTM_flushTileStamps(GTMatrix_t gtm)
+{
+    if (gtm->track_tiles == 0) return;
+    // Stamps only increase and unstamped tiles are 0, so concurrent stamping 
+    // of whole stamp arrays with MPI_MAX is safe
+    int max_tiles = gtm->max_track_tiles;
+    for (int i = 0; i < gtm->n_pend; i++)
+    {
+        int dst_rank = gtm->pend_list[i];
+        MPI_Accumulate(
+            gtm->pend_stamps[dst_rank], max_tiles, MPI_INT, dst_rank, 
+            0, max_tiles, MPI_INT, MPI_MAX, gtm->track_win
+        );
+    }
+    MPI_Win_flush_all(gtm->track_win);
+    for (int i = 0; i < gtm->n_pend; i++)
+    {
+        int dst_rank = gtm->pend_list[i];
+        free(gtm->pend_stamps[dst_rank]);
+        gtm->pend_stamps[dst_rank] = NULL;
+    }
+    gtm->n_pend = 0;
+}
+
+// Get the range of tracking tiles of dst_rank touched by a block inside dst_rank's 
+// local block, and the number of tile columns in dst_rank's local block
+static void GTM_getTileRange(
+    GTMatrix_t gtm, int dst_rank, 
+    int row_start, int row_num, int col_start, int col_num,
+    int *tile_r_s, int *tile_r_e, int *tile_c_s, int *tile_c_e, int *tile_ncols
+)
+{
+    int tts        = gtm->track_tile_size;
+    int dst_rowblk = dst_rank / gtm->c_blocks;
+    int dst_colblk = dst_rank % gtm->c_blocks;
+    int row_s = row_start - gtm->r_displs[dst_rowblk];
+    int col_s = col_start - gtm->c_displs[dst_colblk];
+    *tile_ncols = (gtm->c_blklens[dst_colblk] + tts - 1) / tts;
+    *tile_r_s   = row_s / tts;
+    *tile_r_e   = (row_s + row_num - 1) / tts;
+    *tile_c_s   = col_s / tts;
+    *tile_c_e   = (col_s + col_num - 1) / tts;
+}
+
+void GTM_stampTiles(
+    GTMatrix_t gtm, int dst_rank, 
+    int row_start, int row_num, int col_start, int col_num
+)
+{
+    if ((gtm->track_tiles == 0) || (row_num * col_num == 0)) return;
+    int tile_r_s, tile_r_e, tile_c_s, tile_c_e, tile_ncols;
+    GTM_getTileRange(
+        gtm, dst_rank, row_start, row_num, col_start, col_num, 
+        &tile_r_s, &tile_r_e, &tile_c_s, &tile_c_e, &tile_ncols
+    );
+    int stamp = gtm->track_version + 1;
+    
+    // Stamps to a process are collected locally and sent in GTM_flushTileStamps()
+    int *pend = gtm->pend_stamps[dst_rank];
+    if (pend == NULL)
+    {
+        pend = (int*) calloc(gtm->max_track_tiles, sizeof(int));
+        if (pend != NULL)
+        {
+            gtm->pend_stamps[dst_rank] = pend;
+            gtm->pend_list[gtm->n_pend++] = dst_rank;
+        }
+    }
+    if (pend == NULL)
+    {
+        // No memory for collecting stamps, stamp the tiles directly
+        int n_tile_r = tile_r_e - tile_r_s + 1;
+        int n_tile_c = tile_c_e - tile_c_s + 1;
+        for (int i = 0; i < n_tile_r * n_tile_c; i++) gtm->stamp_buf[i] = stamp;
+        MPI_Datatype dst_dt;
+        MPI_Type_vector(n_tile_r, n_tile_c, tile_ncols, MPI_INT, &dst_dt);
+        MPI_Type_commit(&dst_dt);
+        MPI_Accumulate(
+            gtm->stamp_buf, n_tile_r * n_tile_c, MPI_INT, dst_rank, 
+            tile_r_s * tile_ncols + tile_c_s, 1, dst_dt, MPI_MAX, gtm->track_win
+        );
+        MPI_Win_flush_local(dst_rank, gtm->track_win);
+        MPI_Type_free(&dst_dt);
+        return;
+    }
+    for (int tile_r = tile_r_s; tile_r <= tile_r_e; tile_r++)
+        for (int tile_c = tile_c_s; tile_c <= tile_c_e; tile_c++)
+            pend[tile_r * tile_ncols + tile_c] = stamp;
+}
+
+int GTM_getChangedTiles(
+    GTMatrix_t gtm, int row_start, int row_num, int col_start, int col_num,
+    int since_version, int max_tiles, int *n_tiles, int *tiles
+)
+{
+    if ((gtm == NULL) || (n_tiles == NULL)) return GTM_NULL_PTR;
+    if (gtm->track_tiles == 0) return GTM_INVALID_FLAGS;
+    if ((row_start < 0) || (col_start < 0) ||
+        (row_start + row_num > gtm->nrows)  ||
+        (col_start + col_num > gtm->ncols)  ||
+        (row_num * col_num == 0)) return GTM_INVALID_BLOCK;
+    
+    int tts     = gtm->track_tile_size;
+    int row_end = row_start + row_num - 1;
+    int col_end = col_start + col_num - 1;
+    int cnt     = 0;
+    for (int blk_r = 0; blk_r < gtm->r_blocks; blk_r++)
+    {
+        int dst_r_s = gtm->r_displs[blk_r];
+        int dst_r_e = gtm->r_displs[blk_r + 1] - 1;
+        for (int blk_c = 0; blk_c < gtm->c_blocks; blk_c++)
+        {
+            int dst_c_s  = gtm->c_displs[blk_c];
+            int dst_c_e  = gtm->c_displs[blk_c + 1] - 1;
+            int dst_rank = blk_r * gtm->c_blocks + blk_c;
+            int blk_r_s, blk_r_e, blk_c_s, blk_c_e, intersect;
+            getRectIntersection(
+                dst_r_s,   dst_r_e, dst_c_s,   dst_c_e,
+                row_start, row_end, col_start, col_end,
+                &intersect, &blk_r_s, &blk_r_e, &blk_c_s, &blk_c_e
+            );
+            if (intersect == 0) continue;
+            
+            // Fetch the stamps of the tiles touched by the region
+            int tile_r_s, tile_r_e, tile_c_s, tile_c_e, tile_ncols;
+            GTM_getTileRange(
+                gtm, dst_rank, blk_r_s, blk_r_e - blk_r_s + 1, blk_c_s, blk_c_e - blk_c_s + 1, 
+                &tile_r_s, &tile_r_e, &tile_c_s, &tile_c_e, &tile_ncols
+            );
+            int n_tile_r = tile_r_e - tile_r_s + 1;
+            int n_tile_c = tile_c_e - tile_c_s + 1;
+            MPI_Datatype dst_dt;
+            MPI_Type_vector(n_tile_r, n_tile_c, tile_ncols, MPI_INT, &dst_dt);
+            MPI_Type_commit(&dst_dt);
+            MPI_Get_accumulate(
+                NULL, 0, MPI_INT, gtm->stamp_buf, n_tile_r * n_tile_c, MPI_INT, dst_rank, 
+                tile_r_s * tile_ncols + tile_c_s, 1, dst_dt, MPI_NO_OP, gtm->track_win
+            );
+            MPI_Win_flush(dst_rank, gtm->track_win);
+            MPI_Type_free(&dst_dt);
+            
+            for (int tile_r = tile_r_s; tile_r <= tile_r_e; tile_r++)
+            {
+                for (int tile_c = tile_c_s; tile_c <= tile_c_e; tile_c++)
+                {
+                    int stamp = gtm->stamp_buf[(tile_r - tile_r_s) * n_tile_c + (tile_c - tile_c_s)];
+                    if (stamp <= since_version) continue;
+                    if (cnt < max_tiles)
+                    {
+                        int t_r_s = MAX(dst_r_s + tile_r * tts, blk_r_s);
+                        int t_r_e = MIN(dst_r_s + tile_r * tts + tts - 1, blk_r_e);
+                        int t_c_s = MAX(dst_c_s + tile_c * tts, blk_c_s);
+                        int t_c_e = MIN(dst_c_s + tile_c * tts + tts - 1, blk_c_e);
+                        tiles[4 * cnt + 0] = t_r_s;
+                        tiles[4 * cnt + 1] = t_r_e - t_r_s + 1;
+                        tiles[4 * cnt + 2] = t_c_s;
+                        tiles[4 * cnt + 3] = t_c_e - t_c_s + 1;
+                    }
+                    cnt++;
+                }
+            }
+        }
+    }
+    *n_tiles = cnt;
+    return GTM_SUCCESS;
+}
+
+int GTM_refreshBlock(GTM_PARAM, int since_version, int *n_refreshed)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    if (gtm->track_tiles == 0) return GTM_INVALID_FLAGS;
+    if (row_num * col_num == 0) return GTM_INVALID_BLOCK;
+    
+    // Upper bound of the number of tiles in the region
+    int tts = gtm->track_tile_size;
+    int max_tiles = ((row_num + tts - 1) / tts + gtm->r_blocks) * ((col_num + tts - 1) / tts + gtm->c_blocks);
+    int *tiles = (int*) malloc(sizeof(int) * 4 * max_tiles);
+    if (tiles == NULL) return GTM_ALLOC_FAILED;
+    
+    int n_tiles;
+    int ret = GTM_getChangedTiles(
+        gtm, row_start, row_num, col_start, col_num, 
+        since_version, max_tiles, &n_tiles, tiles
+    );
+    if (ret != GTM_SUCCESS)
+    {
+        free(tiles);
+        return ret;
+    }
+    assert(n_tiles <= max_tiles);
+    
+    // Only get modified tiles
+    for (int i = 0; i < n_tiles; i++)
+    {
+        int t_r_s = tiles[4 * i], t_c_s = tiles[4 * i + 2];
+        char *dst_ptr = (char*) src_buf;
+        dst_ptr += GTM_BUF_OFFSET(gtm, src_buf_ld, t_r_s - row_start, t_c_s - col_start) * (size_t) gtm->unit_size;
+        ret = GTM_getBlockNB(gtm, t_r_s, tiles[4 * i + 1], t_c_s, tiles[4 * i + 3], dst_ptr, src_buf_ld);
+        if (ret != GTM_SUCCESS) break;
+    }
+    GTM_waitNB(gtm);
+    free(tiles);
+    if (n_refreshed != NULL) *n_refreshed = n_tiles;
+    return ret;
+}
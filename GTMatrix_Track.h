@@ -0,0 +1,64 @@
+#ifndef __GTMATRIX_TRACK_H__
+#define __GTMATRIX_TRACK_H__
+
+#include <mpi.h>
+#include "GTMatrix_Typedef.h"
+
+// Dirty tile tracking for GTMatrix created with GTM_STORAGE_TRACK. Each local 
+// block is split into track_tile_size * track_tile_size tracking tiles (env 
+// GTM_TRACK_TILE_SIZE, default GTM_TRACK_TILE_SIZE). gtm->track_version counts 
+// completed synchronizations (GTM_sync(), GTM_syncTouched() and collective 
+// functions using them). Put, accumulate, read-modify-write, fill and symmetrize 
+// stamp the tiles they modify with track_version + 1 at the owner process, so 
+// a copy of a region taken at track_version v is outdated exactly in the tiles
+// whose stamps are larger than v.
+
+// Get the tracking tiles in a region that are modified after version since_version
+// This call is not collective, not thread-safe
+// Input parameters:
+//   gtm           : GTMatrix handle
+//   row_start     : 1st row of the region
+//   row_num       : Number of rows the region has
+//   col_start     : 1st column of the region
+//   col_num       : Number of columns the region has
+//   since_version : Tiles with stamps larger than since_version are returned
+//   max_tiles     : Maximum number of tiles can be stored in tiles
+// Output parameters:
+//   *n_tiles : Number of modified tiles, can be larger than max_tiles
+//   *tiles   : Size >= 4 * max_tiles, tiles[4*i ... 4*i+3] are {row_start, row_num, 
+//              col_start, col_num} of the i-th modified tile clipped to the region
+int GTM_getChangedTiles(
+    GTMatrix_t gtm, int row_start, int row_num, int col_start, int col_num,
+    int since_version, int max_tiles, int *n_tiles, int *tiles
+);
+
+// Delta refresh: src_buf holds a copy of a block taken at version since_version, 
+// get only the modified tracking tiles of the block into src_buf
+// Blocking call, the access operation is finished when function returns
+// This call is not collective, not thread-safe
+// Input parameters:
+//   GTM_PARAM     : Same as GTM_getBlock()
+//   since_version : Version of the copy in src_buf
+// Output parameter:
+//   *n_refreshed  : Number of refreshed tiles, can be NULL
+int GTM_refreshBlock(GTM_PARAM, int since_version, int *n_refreshed);
+
+// ========== Below are internal helper functions ========== //
+
+// Create / free the tile stamp window, called by GTM_createEx() and GTM_destroy()
+int  GTM_createTileStamps(GTMatrix_t gtm);
+void GTM_destroyTileStamps(GTMatrix_t gtm);
+
+// Stamp the tracking tiles of dst_rank touched by a block, the block must be inside
+// dst_rank's local block. Stamps are collected locally and sent by the next 
+// GTM_flushTileStamps(), the stamp is complete after the next synchronization.
+void GTM_stampTiles(
+    GTMatrix_t gtm, int dst_rank, 
+    int row_start, int row_num, int col_start, int col_num
+);
+
+// Send the collected tile stamps, one operation for each stamped process, and 
+// complete them. Called by GTM_syncBegin() and GTM_syncTouched().
+void GTM_flushTileStamps(GTMatrix_t gtm);
+
+#endif
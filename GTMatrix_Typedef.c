@@ -7,6 +7,8 @@
 #include "GTMatrix_Retval.h"
 #include "GTMatrix_Typedef.h"
 #include "GTM_Req_Vector.h"
+#include "GTM_Region_Lock.h"
+#include "GTMatrix_Track.h"
 #include "utils.h"
 
 int GTM_create(
@@ -14,6 +16,19 @@ int GTM_create(
     int unit_size, int my_rank, int nrows, int ncols,
     int r_blocks, int c_blocks, int *r_displs, int *c_displs
 )
+{
+    return GTM_createEx(
+        _gtm, comm, datatype, unit_size, my_rank, nrows, ncols,
+        r_blocks, c_blocks, r_displs, c_displs, GTM_STORAGE_DEFAULT
+    );
+}
+
+int GTM_createEx(
+    GTMatrix_t *_gtm, MPI_Comm comm, MPI_Datatype datatype,
+    int unit_size, int my_rank, int nrows, int ncols,
+    int r_blocks, int c_blocks, int *r_displs, int *c_displs,
+    int storage_flags
+)
 {
     GTMatrix_t gtm = (GTMatrix_t) malloc(sizeof(struct GTMatrix));
     if (gtm == NULL) return GTM_ALLOC_FAILED;
@@ -74,12 +89,73 @@ int GTM_create(
     if (c_displs_valid == 0) return GTM_INVALID_C_DISPLS;
     gtm->my_nrows = gtm->r_blklens[gtm->my_rowblk];
     gtm->my_ncols = gtm->c_blklens[gtm->my_colblk];
+    
+    // Validate storage flags
+    gtm->storage_flags = storage_flags;
+    gtm->symm_storage  = (storage_flags & GTM_STORAGE_SYMM) ? 1 : 0;
+    gtm->versioned     = (storage_flags & GTM_STORAGE_VERSIONED) ? 1 : 0;
+    gtm->track_tiles   = (storage_flags & GTM_STORAGE_TRACK) ? 1 : 0;
+    gtm->col_major     = (storage_flags & GTM_STORAGE_COLMAJOR) ? 1 : 0;
+    gtm->col_major_buf = 0;
+    int tiled          = (storage_flags & GTM_STORAGE_TILED) ? 1 : 0;
+    int valid_flags    = GTM_STORAGE_SYMM | GTM_STORAGE_VERSIONED | GTM_STORAGE_TRACK | 
+                         GTM_STORAGE_TILED | GTM_STORAGE_COLMAJOR;
+    if (storage_flags & ~valid_flags) return GTM_INVALID_FLAGS;
+    // Tile stamps are kept in the owner's coordinates, mirrored updates are not tracked
+    if (gtm->symm_storage && gtm->track_tiles) return GTM_INVALID_FLAGS;
+    if (gtm->symm_storage)
+    {
+        if (nrows != ncols) return GTM_NOT_SQUARE_MAT;
+        if (r_blocks != c_blocks) return GTM_INVALID_FLAGS;
+        for (int i = 0; i <= r_blocks; i++)
+            if (r_displs[i] != c_displs[i]) return GTM_INVALID_FLAGS;
+    }
+    // With symmetric storage, processes in the lower triangle store nothing
+    int my_blk_stored = 1;
+    if (gtm->symm_storage && (gtm->my_rowblk > gtm->my_colblk)) my_blk_stored = 0;
+    // Number of rows and columns of the storage frame, a column-major local 
+    // block is stored as its transpose in row-major layout
+    int my_frows = gtm->col_major ? gtm->my_ncols : gtm->my_nrows;
+    int my_fcols = gtm->col_major ? gtm->my_nrows : gtm->my_ncols;
     // gtm->ld_local = gtm->my_ncols;
     // Use the same local leading dimension for all processes
-    MPI_Allreduce(&gtm->my_ncols, &gtm->ld_local, 1, MPI_INT, MPI_MAX, gtm->mpi_comm);
-    size_t symm_buf_msize = (size_t)unit_size * (size_t)gtm->my_nrows * (size_t)gtm->my_ncols;
-    gtm->symm_buf = malloc(symm_buf_msize);
-    if (gtm->symm_buf == NULL) return GTM_ALLOC_FAILED;
+    MPI_Allreduce(&my_fcols, &gtm->ld_local, 1, MPI_INT, MPI_MAX, gtm->mpi_comm);
+    // Tile-major layout: all processes use the same tile grid, partial tiles 
+    // on the right and bottom edges are padded
+    int blk_nelem   = 0;
+    gtm->tile_size  = 0;
+    gtm->tile_ncols = 0;
+    if (tiled || gtm->versioned)
+    {
+        int max_nrow;
+        MPI_Allreduce(&my_frows, &max_nrow, 1, MPI_INT, MPI_MAX, gtm->mpi_comm);
+        blk_nelem = max_nrow * gtm->ld_local;
+        if (tiled)
+        {
+            gtm->tile_size = GTM_TILE_SIZE;
+            char *tile_size_p = getenv("GTM_TILE_SIZE");
+            if (tile_size_p != NULL) gtm->tile_size = atoi(tile_size_p);
+            if (gtm->tile_size < 1) gtm->tile_size = GTM_TILE_SIZE;
+            int ts = gtm->tile_size;
+            gtm->tile_ncols = (gtm->ld_local + ts - 1) / ts;
+            blk_nelem = ((max_nrow + ts - 1) / ts) * gtm->tile_ncols * ts * ts;
+        }
+    }
+    // Versioned storage: the second version starts at the same offset on all processes
+    gtm->version    = 0;
+    gtm->ver_stride = 0;
+    if (gtm->versioned) gtm->ver_stride = blk_nelem;
+    gtm->rd_offset = 0;
+    gtm->wr_offset = gtm->ver_stride;
+    // Symmetric storage is always symmetric, no need to symmetrize. Long-lived 
+    // buffers are not taken from the GTM_allocBuffer() pool, see GTM_Buffer.h
+    gtm->symm_buf = NULL;
+    if (gtm->symm_storage == 0)
+    {
+        size_t symm_buf_msize = (size_t)unit_size * (size_t)gtm->my_nrows * (size_t)gtm->my_ncols;
+        if (MPI_Alloc_mem((MPI_Aint) symm_buf_msize, MPI_INFO_NULL, &gtm->symm_buf) != MPI_SUCCESS) return GTM_ALLOC_FAILED;
+    }
+    if (MPI_Alloc_mem(GTM_SCALE_BUF_SIZE, MPI_INFO_NULL, &gtm->scale_buf) != MPI_SUCCESS) return GTM_ALLOC_FAILED;
     
     // Allocate shared memory and its MPI window
     // Don't know why sometimes MVAPICH2 2.x has a segment fault in MPI_Win_shared_query(),
@@ -106,9 +182,12 @@ int GTM_create(
     }
     // (2) Allocate shared memory 
     int shm_max_nrow, shm_max_ncol;
-    MPI_Allreduce(&gtm->my_nrows, &shm_max_nrow, 1, MPI_INT, MPI_MAX, gtm->shm_comm);
+    MPI_Allreduce(&my_frows, &shm_max_nrow, 1, MPI_INT, MPI_MAX, gtm->shm_comm);
     MPI_Allreduce(&gtm->ld_local, &shm_max_ncol, 1, MPI_INT, MPI_MAX, gtm->shm_comm);
     MPI_Aint shm_msize = (MPI_Aint)shm_max_ncol * (MPI_Aint)shm_max_nrow * (MPI_Aint)unit_size;
+    if (tiled) shm_msize = (MPI_Aint) blk_nelem * (MPI_Aint) unit_size;
+    if (gtm->versioned) shm_msize = (MPI_Aint) 2 * (MPI_Aint) gtm->ver_stride * (MPI_Aint) unit_size;
+    if (my_blk_stored == 0) shm_msize = 0;
     MPI_Info shm_info;
     MPI_Info_create(&shm_info);
     MPI_Info_set(shm_info, "alloc_shared_noncontig", "true");
@@ -134,13 +213,60 @@ int GTM_create(
     // Bind local matrix block to global MPI window
     MPI_Info mpi_info;
     MPI_Info_create(&mpi_info);
-    MPI_Aint my_block_msize = (MPI_Aint)gtm->my_nrows * (MPI_Aint)shm_max_ncol * (MPI_Aint)unit_size;
+    MPI_Aint my_block_msize = (MPI_Aint)my_frows * (MPI_Aint)shm_max_ncol * (MPI_Aint)unit_size;
+    if (tiled) my_block_msize = (MPI_Aint) blk_nelem * (MPI_Aint) unit_size;
+    if (gtm->versioned) my_block_msize = (MPI_Aint) 2 * (MPI_Aint) gtm->ver_stride * (MPI_Aint) unit_size;
+    if (my_blk_stored == 0) my_block_msize = 0;
     MPI_Win_create(gtm->mat_block, my_block_msize, unit_size, mpi_info, gtm->mpi_comm, &gtm->mpi_win);
     //gtm->ld_blks = (int*) malloc(sizeof(int) * gtm->comm_size);
     //assert(gtm->ld_blks != NULL);
     //MPI_Allgather(&gtm->ld_local, 1, MPI_INT, gtm->ld_blks, 1, MPI_INT, gtm->mpi_comm);
     MPI_Info_free(&mpi_info);
     
+    // Hierarchical synchronization: a sense-reversing barrier in shared memory 
+    // inside each node and a nonblocking barrier among node leaders. It needs 
+    // MPI_Win_shared_query(), so it is disabled if GTM_SHM_OPT=0.
+    gtm->hier_sync = shm_opt;
+    char *hier_sync_p = getenv("GTM_HIER_SYNC");
+    if ((hier_sync_p != NULL) && (atoi(hier_sync_p) == 0)) gtm->hier_sync = 0;
+    gtm->in_sync     = 0;
+    gtm->sync_sense  = 0;
+    gtm->sync_posted = 0;
+    gtm->sync_req    = MPI_REQUEST_NULL;
+    int is_leader = (gtm->shm_rank == 0) ? 1 : 0;
+    MPI_Comm_split(gtm->mpi_comm, is_leader ? 0 : MPI_UNDEFINED, my_rank, &gtm->leader_comm);
+    MPI_Aint sync_msize = is_leader ? (MPI_Aint) (2 * sizeof(int)) : 0;
+    MPI_Win_allocate_shared(
+        sync_msize, sizeof(int), MPI_INFO_NULL, 
+        gtm->shm_comm, &gtm->sync_flags, &gtm->sync_win
+    );
+    if (gtm->hier_sync == 1)
+    {
+        MPI_Aint _size;
+        int _disp;
+        MPI_Win_shared_query(gtm->sync_win, 0, &_size, &_disp, &gtm->sync_flags);
+        if (is_leader) gtm->sync_flags[0] = gtm->sync_flags[1] = 0;
+    }
+    MPI_Barrier(gtm->shm_comm);
+    
+    // Tile stamps for dirty tile tracking
+    gtm->track_version = 0;
+    if (gtm->track_tiles)
+    {
+        int ret = GTM_createTileStamps(gtm);
+        if (ret != GTM_SUCCESS) return ret;
+    }
+    
+    // Notification counter window, notified updates and consumers use atomic 
+    // operations in a single passive target epoch
+    MPI_Win_allocate(
+        (MPI_Aint) sizeof(int), sizeof(int), MPI_INFO_NULL, 
+        gtm->mpi_comm, &gtm->notify_cnt, &gtm->notify_win
+    );
+    *gtm->notify_cnt = 0;
+    MPI_Win_lock_all(0, gtm->notify_win);
+    MPI_Barrier(gtm->mpi_comm);
+    
     // Define small block data types
     size_t DDTs_msize = sizeof(MPI_Datatype) * MPI_DT_SB_DIM_MAX * MPI_DT_SB_DIM_MAX;
     gtm->sb_stride   = (MPI_Datatype*) malloc(DDTs_msize);
@@ -184,6 +310,16 @@ int GTM_create(
     gtm->nb_op_proc_cnt = (int*) malloc(gtm->comm_size * sizeof(int));
     if (gtm->nb_op_proc_cnt == NULL) return GTM_ALLOC_FAILED;;
     memset(gtm->nb_op_proc_cnt, 0, gtm->comm_size * sizeof(int));
+    gtm->touched_cnt = (int*) malloc(gtm->comm_size * sizeof(int));
+    if (gtm->touched_cnt == NULL) return GTM_ALLOC_FAILED;
+    memset(gtm->touched_cnt, 0, gtm->comm_size * sizeof(int));
+    gtm->touched_list = (int*) malloc(gtm->comm_size * sizeof(int));
+    if (gtm->touched_list == NULL) return GTM_ALLOC_FAILED;
+    gtm->n_touched = 0;
+    gtm->tmp_bufs    = NULL;
+    gtm->n_tmp_buf   = 0;
+    gtm->n_tmp_rsv   = 0;
+    gtm->max_tmp_buf = 0;
     gtm->nb_op_cnt  = 0;
     gtm->max_nb_acc = 8;
     gtm->max_nb_get = 128;
@@ -196,11 +332,22 @@ int GTM_create(
     if (gtm->max_nb_get <    4) gtm->max_nb_get =    4;
     if (gtm->max_nb_get > 1024) gtm->max_nb_get = 1024;
     
+    // Row and column communicators are created when first used
+    gtm->row_comm = MPI_COMM_NULL;
+    gtm->col_comm = MPI_COMM_NULL;
+    gtm->panel_seg_size = GTM_PANEL_SEG_SIZE;
+    char *panel_seg_size_p = getenv("GTM_PANEL_SEG_SIZE");
+    if (panel_seg_size_p != NULL) gtm->panel_seg_size = atoi(panel_seg_size_p);
+    if (gtm->panel_seg_size < gtm->unit_size) gtm->panel_seg_size = GTM_PANEL_SEG_SIZE;
+    
     // Set up MPI window lock type for update 
     // By default: (1) for accumulation, only element-wise atomicity is needed, use 
     // MPI_LOCK_SHARED; (2) for replacement, user should guarantee the write sequence 
     // and handle conflict, still use MPI_LOCK_SHARED. 
+    // GTM_UPDATE_ATOMICITY=3 uses MPI_LOCK_SHARED epochs plus MCS queue locks on 
+    // lock tiles, updates only serialize on the lock tiles they touch. 
     gtm->acc_lock_type = MPI_LOCK_SHARED;
+    int use_region_lock = 0;
     char *acc_lock_type_p = getenv("GTM_UPDATE_ATOMICITY");
     if (acc_lock_type_p != NULL) 
     {
@@ -209,9 +356,26 @@ int GTM_create(
         {
             case 1:  gtm->acc_lock_type = MPI_LOCK_SHARED;    break; 
             case 2:  gtm->acc_lock_type = MPI_LOCK_EXCLUSIVE; break; 
+            case 3:  gtm->acc_lock_type = MPI_LOCK_SHARED;    use_region_lock = 1; break; 
             default: gtm->acc_lock_type = MPI_LOCK_SHARED;    break; 
         }
     }
+    gtm->region_lock    = NULL;
+    gtm->lock_tile_mask = NULL;
+    gtm->lock_tile_size = GTM_LOCK_TILE_SIZE;
+    if (use_region_lock)
+    {
+        char *lock_tile_size_p = getenv("GTM_LOCK_TILE_SIZE");
+        if (lock_tile_size_p != NULL) gtm->lock_tile_size = atoi(lock_tile_size_p);
+        if (gtm->lock_tile_size < 1) gtm->lock_tile_size = GTM_LOCK_TILE_SIZE;
+        int lts = gtm->lock_tile_size;
+        int n_lock_tiles = ((gtm->my_nrows + lts - 1) / lts) * ((gtm->my_ncols + lts - 1) / lts);
+        int ret = GTM_createRegionLock(&gtm->region_lock, gtm->mpi_comm, n_lock_tiles);
+        if (ret != GTM_SUCCESS) return ret;
+        gtm->lock_tile_mask = (char*) malloc(gtm->region_lock->nlocks);
+        if (gtm->lock_tile_mask == NULL) return GTM_ALLOC_FAILED;
+        memset(gtm->lock_tile_mask, 0, gtm->region_lock->nlocks);
+    }
     
     *_gtm = gtm;
     return GTM_SUCCESS;
@@ -222,6 +386,13 @@ int GTM_destroy(GTMatrix_t gtm)
     if (gtm == NULL) return GTM_NULL_PTR;
     
     MPI_Win_free(&gtm->mpi_win);
+    MPI_Win_unlock_all(gtm->notify_win);
+    MPI_Win_free(&gtm->notify_win);
+    MPI_Win_free(&gtm->sync_win);
+    if (gtm->track_tiles) GTM_destroyTileStamps(gtm);
+    if (gtm->leader_comm != MPI_COMM_NULL) MPI_Comm_free(&gtm->leader_comm);
+    if (gtm->row_comm    != MPI_COMM_NULL) MPI_Comm_free(&gtm->row_comm);
+    if (gtm->col_comm    != MPI_COMM_NULL) MPI_Comm_free(&gtm->col_comm);
     MPI_Win_free(&gtm->shm_win);        // This will also free *mat_block
     MPI_Comm_free(&gtm->mpi_comm);
     MPI_Comm_free(&gtm->shm_comm);
@@ -232,7 +403,8 @@ int GTM_destroy(GTMatrix_t gtm)
     free(gtm->c_blklens);
     //free(gtm->mat_block);
     //free(gtm->ld_blks);
-    free(gtm->symm_buf);
+    if (gtm->symm_buf != NULL) MPI_Free_mem(gtm->symm_buf);
+    MPI_Free_mem(gtm->scale_buf);
     free(gtm->shm_global_ranks);
     free(gtm->shm_mat_blocks);
     
@@ -244,7 +416,18 @@ int GTM_destroy(GTMatrix_t gtm)
             gtm->nb_op_proc_cnt[dst_rank] = 0;
         }
     }
+    gtm->nb_op_cnt = 0;
+    for (int i = 0; i < gtm->n_tmp_buf; i++) free(gtm->tmp_bufs[i]);
+    free(gtm->tmp_bufs);
     free(gtm->nb_op_proc_cnt);
+    free(gtm->touched_cnt);
+    free(gtm->touched_list);
+    
+    if (gtm->region_lock != NULL)
+    {
+        GTM_destroyRegionLock(gtm->region_lock);
+        free(gtm->lock_tile_mask);
+    }
     
     for (int i = 0; i < MPI_DT_SB_DIM_MAX * MPI_DT_SB_DIM_MAX; i++)
     {
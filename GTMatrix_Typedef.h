@@ -3,6 +3,7 @@
 
 #include <mpi.h>
 #include "GTM_Req_Vector.h"
+#include "GTM_Region_Lock.h"
 
 // Distributed matrix, 2D checkerboard partition, no cyclic 
 struct GTMatrix
@@ -12,6 +13,7 @@ struct GTMatrix
     MPI_Win  mpi_win,  shm_win;  // MPI window for distribute matrix
     MPI_Datatype datatype;       // Matrix data type
     int acc_lock_type;           // MPI window lock type for update (accumulate & put)
+    int storage_flags;           // Storage flags, see GTM_STORAGE_* below
     
     // Matrix size and partition
     int nrows, ncols;            // Matrix size
@@ -22,19 +24,70 @@ struct GTMatrix
     int *c_displs, *c_blklens;   // Displacements and length of each block on column direction
     //int *ld_blks;                // Leading dimensions of each matrix block
     int ld_local;                // Local matrix block's leading dimension
+    int col_major;               // If local matrix blocks are stored column-major (GTM_STORAGE_COLMAJOR)
+    int col_major_buf;           // If user block buffers are column-major, see GTM_setBufferLayout()
+    int symm_storage;            // If only upper triangle blocks are stored (GTM_STORAGE_SYMM)
+    int versioned;               // If two versions of the matrix are stored (GTM_STORAGE_VERSIONED)
+    int version;                 // Published version number, get operations read this version
+    int ver_stride;              // Distance between the two versions in the local block, unit is element
+    int rd_offset, wr_offset;    // Offsets of the published and the write version in the local block, unit is element
+    int tile_size;               // Tile size of the tile-major local layout (GTM_STORAGE_TILED), 0 for row-major layout
+    int tile_ncols;              // Number of tiles in each tile row of the local block
+    
+    // Dirty tile tracking (GTM_STORAGE_TRACK), see GTMatrix_Track.h
+    int track_tiles;             // If modified tiles are tracked
+    int track_version;           // Number of completed synchronizations, modified tiles are stamped with track_version + 1
+    int track_tile_size;         // Tracking tiles are track_tile_size * track_tile_size sub-blocks
+    int max_track_tiles;         // Maximum number of tracking tiles in a process's local block
+    MPI_Win track_win;           // MPI window of tile stamps, always in a lock_all epoch
+    int *tile_stamps;            // Local tile stamps, row-major tile order
+    int *stamp_buf;              // Buffer for sending / receiving tile stamps
+    int **pend_stamps;           // Tile stamps to each process not sent yet, NULL if none
+    int *pend_list;              // Processes with pending tile stamps
+    int n_pend;                  // Number of processes in pend_list
     
     // MPI Global window
     int unit_size;               // Size of matrix data type, unit is byte
     int my_rank, comm_size;      // Rank of this process and number of process in the global communicator
     void *mat_block;             // Local matrix block
     void *symm_buf;              // Buffer for symmetrization
+    void *scale_buf;             // Staging buffer for scaled accumulation, GTM_SCALE_BUF_SIZE bytes
     GTM_Req_Vector_t *req_vec;   // Update requests for each process
     int in_batch_get;            // If GTMatrix is in batched get access
     int in_batch_put;            // If GTMatrix is in batched put access
     int in_batch_acc;            // If GTMatrix is in batched acc access
     int *nb_op_proc_cnt;         // Number of outstanding RMA operations on each process from nonblocking calls
     int nb_op_cnt;               // Total number of outstanding RMA operations from nonblocking calls
+    int *touched_cnt;            // Number of update operations to each process since the last GTM_syncTouched()
+    int *touched_list;           // Processes with touched_cnt > 0, in the order of their first update
+    int n_touched;               // Number of processes in touched_list
     int max_nb_acc, max_nb_get;  // Maximum number of outstanding update / get operations from nonblocking calls
+    void **tmp_bufs;             // Temporary source buffers of queued / nonblocking updates, freed when they finish
+    int n_tmp_buf, n_tmp_rsv;    // Number of kept and reserved temporary source buffers
+    int max_tmp_buf;             // Capacity of tmp_bufs
+    
+    // Hierarchical synchronization
+    MPI_Comm leader_comm;        // Communicator of shm_comm leaders (shm_rank == 0), MPI_COMM_NULL on other processes
+    MPI_Win  sync_win;           // MPI shared memory window for the node barrier
+    int *sync_flags;             // Node barrier arrival counter and release sense, hosted by the leader
+    int sync_sense;              // Sense of the current node barrier
+    int hier_sync;               // If hierarchical synchronization is used (GTM_HIER_SYNC, default 1)
+    int in_sync;                 // If GTMatrix is in a split-phase synchronization
+    int sync_posted;             // If the leader barrier of the current synchronization is posted
+    MPI_Request sync_req;        // Leader barrier (or flat barrier) request
+    
+    // Process grid row and column communicators, see GTM_Panel.h
+    MPI_Comm row_comm, col_comm; // Processes in the same process row / column, MPI_COMM_NULL until first used
+    int panel_seg_size;          // Segment size of pipelined panel broadcast / reduction, unit is byte
+    
+    // Notification counter for notified updates
+    MPI_Win notify_win;          // MPI window for notification counters, always in a lock_all epoch
+    int *notify_cnt;             // Local notification counter
+    
+    // Region locks for update (GTM_UPDATE_ATOMICITY=3)
+    GTM_Region_Lock_t region_lock; // MCS lock of each lock tile in each process's block, NULL if not used
+    char *lock_tile_mask;        // Lock tiles touched by the current update, one flag for each lock
+    int lock_tile_size;          // Lock tiles are lock_tile_size * lock_tile_size sub-blocks
     
     // MPI Shared memory window
     int shm_rank, shm_size;      // Rank of this process and number of process in the shared memory communicator
@@ -49,11 +102,72 @@ struct GTMatrix
 typedef struct GTMatrix* GTMatrix_t;
 
 #define MPI_DT_SB_DIM_MAX    16
+#define GTM_SCALE_BUF_SIZE   65536  // Scaled remote accumulation is staged in chunks of this size (bytes)
+#define GTM_MAX_UPDATE_OPS   16     // Maximum number of different update operations in a batch
+#define GTM_LOCK_TILE_SIZE   64     // Default lock tile size for GTM_UPDATE_ATOMICITY=3
+#define GTM_TRACK_TILE_SIZE  64     // Default tracking tile size for GTM_STORAGE_TRACK
+#define GTM_TILE_SIZE        64     // Default tile size for GTM_STORAGE_TILED
+#define GTM_PANEL_SEG_SIZE   65536  // Default segment size of pipelined panel operations (bytes)
 
 #define BLOCKING_ACCESS      0  // The access operation is finished when function returns
 #define NONBLOCKING_ACCESS   1  // The access operation is posted but not finished when function returns
 #define BATCH_ACCESS         2  // The access operation is pushed to the request queue but not posted
 
+// Storage flags for GTM_createEx(), can be combined with bitwise OR
+#define GTM_STORAGE_DEFAULT  0x00  // Full matrix, all blocks are stored
+#define GTM_STORAGE_SYMM     0x01  // Symmetric (Hermitian for double _Complex) matrix, only blocks
+                                   // in the upper triangle of the process grid are stored
+#define GTM_STORAGE_VERSIONED 0x02 // Two versions in the same window: get operations read the 
+                                   // published version N, update operations write version N+1
+#define GTM_STORAGE_TRACK    0x04  // Track modified tiles of each local block, see GTMatrix_Track.h
+#define GTM_STORAGE_TILED    0x08  // Tile-major local block layout, each tile is contiguous
+#define GTM_STORAGE_COLMAJOR 0x10  // Column-major local block layout (column-major tiles 
+                                   // in column-major tile order with GTM_STORAGE_TILED)
+
+// Layout of user block buffers, see GTM_setBufferLayout()
+#define GTM_BUF_ROW_MAJOR    0
+#define GTM_BUF_COL_MAJOR    1
+
+// A column-major local block is stored as its transpose in row-major layout, 
+// the "storage frame" below is the local block (row-major) or its transpose.
+// Offset of element (srow, scol) of the storage frame in a version of a local 
+// block, unit is element. The row-major layout uses leading dimension ld_local. 
+// The tile-major layout stores tile_size * tile_size row-major tiles in 
+// row-major tile order.
+#define GTM_STORAGE_OFFSET(gtm, srow, scol)                                          \
+    (((gtm)->tile_size == 0) ?                                                       \
+    ((size_t) (srow) * (size_t) (gtm)->ld_local + (size_t) (scol)) :                 \
+    (((size_t) ((srow) / (gtm)->tile_size) * (size_t) (gtm)->tile_ncols +            \
+      (size_t) ((scol) / (gtm)->tile_size)) * (size_t) (gtm)->tile_size * (size_t) (gtm)->tile_size + \
+     (size_t) ((srow) % (gtm)->tile_size) * (size_t) (gtm)->tile_size +              \
+     (size_t) ((scol) % (gtm)->tile_size)))
+
+// Offset of local block element (lrow, lcol) in a version of a local block
+#define GTM_LOCAL_OFFSET(gtm, lrow, lcol)                                            \
+    ((gtm)->col_major ? GTM_STORAGE_OFFSET(gtm, lcol, lrow) : GTM_STORAGE_OFFSET(gtm, lrow, lcol))
+
+// Offset of element (r, c) in a user block buffer with leading dimension ld, unit is element
+#define GTM_BUF_OFFSET(gtm, ld, r, c)                                                \
+    ((gtm)->col_major_buf ? ((size_t) (c) * (size_t) (ld) + (size_t) (r)) :          \
+                            ((size_t) (r) * (size_t) (ld) + (size_t) (c)))
+
+// Count cnt update operations to process dst_rank for GTM_syncTouched()
+#define GTM_ADD_TOUCHED(gtm, dst_rank, cnt)                                          \
+    do {                                                                             \
+        if ((gtm)->touched_cnt[dst_rank] == 0)                                       \
+            (gtm)->touched_list[(gtm)->n_touched++] = (dst_rank);                    \
+        (gtm)->touched_cnt[dst_rank] += (cnt);                                       \
+    } while (0)
+
+// Leading dimension of the storage frame (row-major) or a tile (tile-major)
+#define GTM_LOCAL_LD(gtm) (((gtm)->tile_size == 0) ? (gtm)->ld_local : (gtm)->tile_size)
+
+// Number of elements of local rows (columns) [lpos, lpos + len) in the same 
+// tile as lpos, always len for the row-major layout
+#define GTM_TILE_SPAN(gtm, lpos, len)                                                \
+    ((((gtm)->tile_size == 0) || ((len) <= (gtm)->tile_size - (lpos) % (gtm)->tile_size)) ? \
+    (len) : ((gtm)->tile_size - (lpos) % (gtm)->tile_size))
+
 #define GTM_PARAM \
     GTMatrix_t gtm, int row_start, int row_num, \
     int col_start, int col_num, void *src_buf, int src_buf_ld
@@ -88,6 +202,31 @@ int GTM_create(
     int r_blocks, int c_blocks, int *r_displs, int *c_displs
 );
 
+// Create and initialize a GTMatrix structure with storage flags
+// Parameters are the same as GTM_create(), plus:
+//   storage_flags : Storage flags, see GTM_STORAGE_*
+// GTM_STORAGE_SYMM requires a square matrix with r_blocks == c_blocks and 
+// r_displs == c_displs. Processes in the lower triangle of the process grid 
+// do not store any data. Element (i, j) and (j, i) share the same storage: 
+// getting lower triangle elements returns the transposed (conjugated for 
+// double _Complex) upper triangle elements, putting / accumulating lower 
+// triangle elements updates their mirror elements in the upper triangle. 
+// Accumulating both (i, j) and (j, i) adds both values to the same element.
+// GTM_STORAGE_VERSIONED doubles the local storage. Get operations read the 
+// published version, update, read-modify-write and fill operations write the 
+// next version, GTM_publish() makes the next version the published one. 
+// GTM_STORAGE_TILED stores each local block in GTM_TILE_SIZE * GTM_TILE_SIZE 
+// (environment variable GTM_TILE_SIZE, default 64) tiles. Transfers are split 
+// into pieces inside a tile, a piece covering whole tile rows is contiguous. 
+// GTM_STORAGE_COLMAJOR stores each local block column-major, data types and 
+// shared memory kernels transpose the data during the transfer. 
+int GTM_createEx(
+    GTMatrix_t *_gtm, MPI_Comm comm, MPI_Datatype datatype,
+    int unit_size, int my_rank, int nrows, int ncols,
+    int r_blocks, int c_blocks, int *r_displs, int *c_displs,
+    int storage_flags
+);
+
 // Free a GTMatrix structure
 // This call is collective, thread-safe
 int GTM_destroy(GTMatrix_t gtm);
@@ -1,39 +1,305 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <assert.h>
 #include <mpi.h>
+#include <complex.h>
 
 #include "GTMatrix_Retval.h"
 #include "GTMatrix_Typedef.h"
 #include "GTMatrix_Update.h"
 #include "GTMatrix_Other.h"
+#include "GTMatrix_Track.h"
+#include "GTM_Buffer.h"
 #include "utils.h"
 
+// Scale a block: dst = alpha * src (accum == 0) or dst += alpha * src (accum == 1)
+// Input parameters:
+//   gtm        : GTMatrix handle
+//   *alpha     : Pointer to the scaling factor, same type as the matrix
+//   *src_buf   : Source buffer
+//   src_buf_ld : Leading dimension of the source buffer
+//   trans      : If src_buf holds the transpose of the destination block
+//   *dst_buf   : Destination buffer
+//   dst_buf_ld : Leading dimension of the destination buffer
+//   row_num    : Number of rows the destination block has
+//   col_num    : Number of columns the destination block has
+//   accum      : If the scaled block is added to the destination block
+#define GTM_SCALE_BLOCK_KERNEL(type)                                            \
+    do {                                                                        \
+        type _alpha;                                                            \
+        type *src = (type*) src_buf;                                            \
+        type *dst = (type*) dst_buf;                                            \
+        memcpy(&_alpha, alpha, sizeof(type));                                   \
+        for (int irow = 0; irow < row_num; irow++)                              \
+        {                                                                       \
+            type *dst_row = dst + (size_t) irow * (size_t) dst_buf_ld;          \
+            if (trans == 0)                                                     \
+            {                                                                   \
+                type *src_row = src + (size_t) irow * (size_t) src_buf_ld;      \
+                if (accum)                                                      \
+                {                                                               \
+                    for (int icol = 0; icol < col_num; icol++)                  \
+                        dst_row[icol] += _alpha * src_row[icol];                \
+                } else {                                                        \
+                    for (int icol = 0; icol < col_num; icol++)                  \
+                        dst_row[icol] = _alpha * src_row[icol];                 \
+                }                                                               \
+            } else {                                                            \
+                type *src_col = src + irow;                                     \
+                for (int icol = 0; icol < col_num; icol++)                      \
+                {                                                               \
+                    type val = _alpha * src_col[(size_t) icol * (size_t) src_buf_ld]; \
+                    dst_row[icol] = accum ? (dst_row[icol] + val) : val;        \
+                }                                                               \
+            }                                                                   \
+        }                                                                       \
+    } while (0)
+
+static void GTM_scaleBlock(
+    GTMatrix_t gtm, void *alpha, void *src_buf, int src_buf_ld, int trans, 
+    void *dst_buf, int dst_buf_ld, int row_num, int col_num, int accum
+)
+{
+    if (MPI_INT == gtm->datatype)              GTM_SCALE_BLOCK_KERNEL(int);
+    if (GTM_IS_INT64_TYPE(gtm->datatype))      GTM_SCALE_BLOCK_KERNEL(int64_t);
+    if (MPI_DOUBLE == gtm->datatype)           GTM_SCALE_BLOCK_KERNEL(double);
+    if (MPI_C_DOUBLE_COMPLEX == gtm->datatype) GTM_SCALE_BLOCK_KERNEL(double _Complex);
+}
+
+// Element-wise update kernel dst = op_func(dst, src), parameters are the same
+// as GTM_scaleBlock() without alpha and accum. The inner loop has no branch 
+// for trans == 0 so the compiler can vectorize it.
+#define GTM_OP_BLOCK_KERNEL(type, op_func)                                      \
+    do {                                                                        \
+        type *src = (type*) src_buf;                                            \
+        type *dst = (type*) dst_buf;                                            \
+        for (int irow = 0; irow < row_num; irow++)                              \
+        {                                                                       \
+            type *dst_row = dst + (size_t) irow * (size_t) dst_buf_ld;          \
+            if (trans == 0)                                                     \
+            {                                                                   \
+                type *src_row = src + (size_t) irow * (size_t) src_buf_ld;      \
+                for (int icol = 0; icol < col_num; icol++)                      \
+                    dst_row[icol] = op_func(dst_row[icol], src_row[icol]);      \
+            } else {                                                            \
+                type *src_col = src + irow;                                     \
+                for (int icol = 0; icol < col_num; icol++)                      \
+                {                                                               \
+                    type val = src_col[(size_t) icol * (size_t) src_buf_ld];    \
+                    dst_row[icol] = op_func(dst_row[icol], val);                \
+                }                                                               \
+            }                                                                   \
+        }                                                                       \
+    } while (0)
+
+#define GTM_OP_MAX(d, s)  (((s) > (d)) ? (s) : (d))
+#define GTM_OP_MIN(d, s)  (((s) < (d)) ? (s) : (d))
+#define GTM_OP_PROD(d, s) ((d) * (s))
+
+// Check if an update operation has a local kernel for shared memory targets
+// MPI_SUM and MPI_REPLACE do not need one: MPI_Accumulate allows concurrent 
+// updates under a shared lock, a local kernel would need an exclusive lock
+static int GTM_hasShmOpKernel(GTMatrix_t gtm, MPI_Op op)
+{
+    int is_real = ((MPI_INT == gtm->datatype) || (MPI_DOUBLE == gtm->datatype) || 
+                   GTM_IS_INT64_TYPE(gtm->datatype)) ? 1 : 0;
+    if (MPI_PROD == op) return (is_real || (MPI_C_DOUBLE_COMPLEX == gtm->datatype));
+    if ((MPI_MAX == op) || (MPI_MIN == op)) return is_real;
+    return 0;
+}
+
+static void GTM_opBlock(
+    GTMatrix_t gtm, MPI_Op op, void *src_buf, int src_buf_ld, int trans, 
+    void *dst_buf, int dst_buf_ld, int row_num, int col_num
+)
+{
+    if (MPI_INT == gtm->datatype)
+    {
+        if (MPI_MAX  == op) GTM_OP_BLOCK_KERNEL(int, GTM_OP_MAX);
+        if (MPI_MIN  == op) GTM_OP_BLOCK_KERNEL(int, GTM_OP_MIN);
+        if (MPI_PROD == op) GTM_OP_BLOCK_KERNEL(int, GTM_OP_PROD);
+    }
+    if (GTM_IS_INT64_TYPE(gtm->datatype))
+    {
+        if (MPI_MAX  == op) GTM_OP_BLOCK_KERNEL(int64_t, GTM_OP_MAX);
+        if (MPI_MIN  == op) GTM_OP_BLOCK_KERNEL(int64_t, GTM_OP_MIN);
+        if (MPI_PROD == op) GTM_OP_BLOCK_KERNEL(int64_t, GTM_OP_PROD);
+    }
+    if (MPI_DOUBLE == gtm->datatype)
+    {
+        if (MPI_MAX  == op) GTM_OP_BLOCK_KERNEL(double, GTM_OP_MAX);
+        if (MPI_MIN  == op) GTM_OP_BLOCK_KERNEL(double, GTM_OP_MIN);
+        if (MPI_PROD == op) GTM_OP_BLOCK_KERNEL(double, GTM_OP_PROD);
+    }
+    if (MPI_C_DOUBLE_COMPLEX == gtm->datatype)
+    {
+        if (MPI_PROD == op) GTM_OP_BLOCK_KERNEL(double _Complex, GTM_OP_PROD);
+    }
+}
+
+// Update a block to a process in the same shared memory communicator by updating
+// the target elements directly, the caller should hold an exclusive lock of 
+// dst_rank so no other process is updating the target block. alpha != NULL 
+// means accumulating alpha * (the block), otherwise op should have a local 
+// kernel (GTM_hasShmOpKernel() returns 1).
+// Input parameters are the same as GTM_updateBlockToProcess(), plus:
+//   *shm_ptr : Pointer to the target process's local matrix block
+static void GTM_updateBlockToShm(
+    GTMatrix_t gtm, int dst_rank, void *shm_ptr, MPI_Op op, 
+    int row_start, int row_num,
+    int col_start, int col_num,
+    void *src_buf, int src_buf_ld, int trans, void *alpha
+)
+{
+    int dst_rowblk = dst_rank / gtm->c_blocks;
+    int dst_colblk = dst_rank % gtm->c_blocks;
+    int dst_lrow   = row_start - gtm->r_displs[dst_rowblk];
+    int dst_lcol   = col_start - gtm->c_displs[dst_colblk];
+    int dst_blk_ld = GTM_LOCAL_LD(gtm);
+    GTM_ADD_TOUCHED(gtm, dst_rank, 1);
+    GTM_stampTiles(gtm, dst_rank, row_start, row_num, col_start, col_num);
+    // Update the pieces inside each tile, the whole block is one piece in row-major layout
+    for (int r0 = 0, nr; r0 < row_num; r0 += nr)
+    {
+        nr = GTM_TILE_SPAN(gtm, dst_lrow + r0, row_num - r0);
+        for (int c0 = 0, nc; c0 < col_num; c0 += nc)
+        {
+            nc = GTM_TILE_SPAN(gtm, dst_lcol + c0, col_num - c0);
+            size_t src_offset = trans ? ((size_t) c0 * (size_t) src_buf_ld + (size_t) r0) : 
+                                        ((size_t) r0 * (size_t) src_buf_ld + (size_t) c0);
+            size_t dst_pos = GTM_LOCAL_OFFSET(gtm, dst_lrow + r0, dst_lcol + c0);
+            char *src_ptr  = (char*) src_buf + src_offset * gtm->unit_size;
+            char *dst_ptr  = (char*) shm_ptr + dst_pos * gtm->unit_size;
+            // Column-major storage: update the transposed piece of the storage frame
+            int s_trans = gtm->col_major ? (1 - trans) : trans;
+            int s_nr    = gtm->col_major ? nc : nr;
+            int s_nc    = gtm->col_major ? nr : nc;
+            if (alpha != NULL)
+                GTM_scaleBlock(gtm, alpha, src_ptr, src_buf_ld, s_trans, dst_ptr, dst_blk_ld, s_nr, s_nc, 1);
+            else
+                GTM_opBlock(gtm, op, src_ptr, src_buf_ld, s_trans, dst_ptr, dst_blk_ld, s_nr, s_nc);
+        }
+    }
+    MPI_Win_sync(gtm->mpi_win);
+}
+
+// Get the pointer to a process's local matrix block (the write version) if the 
+// process is in the same shared memory communicator, otherwise return NULL
+static void *GTM_getShmBlockPtr(GTMatrix_t gtm, int dst_rank)
+{
+    int shm_rank = getElementIndexInArray(dst_rank, gtm->shm_global_ranks, gtm->shm_size);
+    if ((shm_rank == -1) || (gtm->shm_mat_blocks[shm_rank] == NULL)) return NULL;
+    return (char*) gtm->shm_mat_blocks[shm_rank] + (size_t) gtm->wr_offset * (size_t) gtm->unit_size;
+}
+
+// Mark the lock tiles of dst_rank's local block touched by a block in 
+// gtm->lock_tile_mask, the block must be inside dst_rank's local block
+void GTM_markLockTiles(
+    GTMatrix_t gtm, int dst_rank, 
+    int row_start, int row_num, int col_start, int col_num
+)
+{
+    int lts        = gtm->lock_tile_size;
+    int dst_rowblk = dst_rank / gtm->c_blocks;
+    int dst_colblk = dst_rank % gtm->c_blocks;
+    int tile_ncols = (gtm->c_blklens[dst_colblk] + lts - 1) / lts;
+    int row_s = row_start - gtm->r_displs[dst_rowblk];
+    int col_s = col_start - gtm->c_displs[dst_colblk];
+    for (int tile_r = row_s / lts; tile_r <= (row_s + row_num - 1) / lts; tile_r++)
+        for (int tile_c = col_s / lts; tile_c <= (col_s + col_num - 1) / lts; tile_c++)
+            gtm->lock_tile_mask[tile_r * tile_ncols + tile_c] = 1;
+}
+
+// Acquire all marked lock tiles of dst_rank in ascending order, so processes 
+// locking overlapping regions of the same target cannot deadlock
+void GTM_acquireLockTiles(GTMatrix_t gtm, int dst_rank)
+{
+    for (int i = 0; i < gtm->region_lock->nlocks; i++)
+        if (gtm->lock_tile_mask[i]) GTM_acquireRegionLock(gtm->region_lock, dst_rank, i);
+}
+
+// Release all marked lock tiles of dst_rank and clear the marks
+void GTM_releaseLockTiles(GTMatrix_t gtm, int dst_rank)
+{
+    for (int i = 0; i < gtm->region_lock->nlocks; i++)
+    {
+        if (gtm->lock_tile_mask[i] == 0) continue;
+        GTM_releaseRegionLock(gtm->region_lock, dst_rank, i);
+        gtm->lock_tile_mask[i] = 0;
+    }
+}
+
+// Accumulate alpha * (a block) to a process inside an access epoch of dst_rank. 
+// The block is scaled into gtm->scale_buf chunk by chunk and each chunk is 
+// accumulated with MPI_Accumulate, the staging buffer is reused after 
+// MPI_Win_flush_local().
+// Input parameters are the same as GTM_updateBlockToProcess() without op
+static int GTM_accScaledBlockToProcess(
+    GTMatrix_t gtm, int dst_rank, 
+    int row_start, int row_num,
+    int col_start, int col_num,
+    void *src_buf, int src_buf_ld, int trans, void *alpha
+)
+{
+    int unit_size  = gtm->unit_size;
+    int buf_nelem  = GTM_SCALE_BUF_SIZE / unit_size;
+    int chunk_cols = MIN(col_num, buf_nelem);
+    int chunk_rows = MIN(row_num, buf_nelem / chunk_cols);
+    for (int c0 = 0; c0 < col_num; c0 += chunk_cols)
+    {
+        int nc = MIN(chunk_cols, col_num - c0);
+        for (int r0 = 0; r0 < row_num; r0 += chunk_rows)
+        {
+            int nr = MIN(chunk_rows, row_num - r0);
+            size_t src_offset;
+            if (trans == 0) src_offset = (size_t) r0 * (size_t) src_buf_ld + (size_t) c0;
+            else            src_offset = (size_t) c0 * (size_t) src_buf_ld + (size_t) r0;
+            char *src_ptr = (char*) src_buf + src_offset * unit_size;
+            GTM_scaleBlock(gtm, alpha, src_ptr, src_buf_ld, trans, gtm->scale_buf, nc, nr, nc, 0);
+            int ret = GTM_updateBlockToProcess(
+                gtm, dst_rank, MPI_SUM, row_start + r0, nr, 
+                col_start + c0, nc, gtm->scale_buf, nc, 0, NULL
+            );
+            if (ret != GTM_SUCCESS) return ret;
+            MPI_Win_flush_local(dst_rank, gtm->mpi_win);
+        }
+    }
+    return GTM_SUCCESS;
+}
+
 // Update (put or accumulate) a block to a process using MPI_Accumulate
-// The update operation is not complete when this function returns
+// The update operation is not complete when this function returns. If the 
+// update epoch is exclusive (GTM_UPDATE_ATOMICITY=2) or the caller holds the 
+// lock tiles of the block (GTM_UPDATE_ATOMICITY=3) and the target is in the 
+// same shared memory communicator, scaled accumulation and operations with a 
+// local kernel update the target elements directly.
 // Input parameters:
 //   gtm     : GTMatrix handle
 //   dst_rank   : Target process
-//   op         : MPI operation, only support MPI_SUM (accumulate) and MPI_REPLACE (put)
+//   op         : Predefined MPI operation, MPI_REPLACE for put
 //   row_start  : 1st row of the source block
 //   row_num    : Number of rows the source block has
 //   col_start  : 1st column of the source block
 //   col_num    : Number of columns the source block has
 //   *src_buf   : Source buffer
 //   src_buf_ld : Leading dimension of the source buffer
+//   trans      : If src_buf holds the transpose of the target block, 
+//                i.e. src_buf is a col_num * row_num matrix
+//   *alpha     : Scaling factor for accumulation (op == MPI_SUM), NULL means 1
 int GTM_updateBlockToProcess(
     GTMatrix_t gtm, int dst_rank, MPI_Op op, 
     int row_start, int row_num,
     int col_start, int col_num,
-    void *src_buf, int src_buf_ld
+    void *src_buf, int src_buf_ld, int trans, void *alpha
 )
 {
     int row_end       = row_start + row_num;
     int col_end       = col_start + col_num;
     int dst_rowblk    = dst_rank / gtm->c_blocks;
     int dst_colblk    = dst_rank % gtm->c_blocks;
-    int dst_blk_ld    = gtm->ld_local; // gtm->ld_blks[dst_rank];
+    int dst_blk_ld    = GTM_LOCAL_LD(gtm); // gtm->ld_blks[dst_rank];
     int dst_row_start = gtm->r_displs[dst_rowblk];
     int dst_col_start = gtm->c_displs[dst_colblk];
     int dst_row_end   = gtm->r_displs[dst_rowblk + 1];
@@ -46,10 +312,98 @@ int GTM_updateBlockToProcess(
         (col_end   > dst_col_end)   ||
         (row_num   * col_num == 0)) return GTM_INVALID_BLOCK;
     
-    int dst_pos = (row_start - dst_row_start) * dst_blk_ld;
-    dst_pos += col_start - dst_col_start;
+    // Tile-major layout: update the pieces inside each tile separately
+    int dst_lrow = row_start - dst_row_start;
+    int dst_lcol = col_start - dst_col_start;
+    if ((GTM_TILE_SPAN(gtm, dst_lrow, row_num) < row_num) ||
+        (GTM_TILE_SPAN(gtm, dst_lcol, col_num) < col_num))
+    {
+        for (int r0 = 0, nr; r0 < row_num; r0 += nr)
+        {
+            nr = GTM_TILE_SPAN(gtm, dst_lrow + r0, row_num - r0);
+            for (int c0 = 0, nc; c0 < col_num; c0 += nc)
+            {
+                nc = GTM_TILE_SPAN(gtm, dst_lcol + c0, col_num - c0);
+                size_t offset = trans ? ((size_t) c0 * (size_t) src_buf_ld + (size_t) r0) : 
+                                        ((size_t) r0 * (size_t) src_buf_ld + (size_t) c0);
+                int ret = GTM_updateBlockToProcess(
+                    gtm, dst_rank, op, row_start + r0, nr, col_start + c0, nc, 
+                    (char*) src_buf + offset * gtm->unit_size, src_buf_ld, trans, alpha
+                );
+                if (ret != GTM_SUCCESS) return ret;
+            }
+        }
+        return GTM_SUCCESS;
+    }
+    
+    if ((alpha != NULL) || GTM_hasShmOpKernel(gtm, op))
+    {
+        void *shm_ptr = GTM_getShmBlockPtr(gtm, dst_rank);
+        int exclusive = (gtm->acc_lock_type == MPI_LOCK_EXCLUSIVE) || (gtm->region_lock != NULL);
+        if ((shm_ptr != NULL) && exclusive)
+        {
+            // Complete previous operations of this epoch before touching the elements
+            MPI_Win_flush(dst_rank, gtm->mpi_win);
+            GTM_updateBlockToShm(
+                gtm, dst_rank, shm_ptr, op, row_start, row_num, 
+                col_start, col_num, src_buf, src_buf_ld, trans, alpha
+            );
+            return GTM_SUCCESS;
+        }
+    }
+    
+    // Scaled accumulation is counted and stamped by the unscaled updates it issues
+    if (alpha != NULL)
+    {
+        return GTM_accScaledBlockToProcess(
+            gtm, dst_rank, row_start, row_num, col_start, col_num, 
+            src_buf, src_buf_ld, trans, alpha
+        );
+    }
+    GTM_ADD_TOUCHED(gtm, dst_rank, 1);
+    GTM_stampTiles(gtm, dst_rank, row_start, row_num, col_start, col_num);
+    
+    MPI_Aint dst_pos = (MPI_Aint) GTM_LOCAL_OFFSET(gtm, dst_lrow, dst_lcol);
+    dst_pos += gtm->wr_offset;  // Write the next version
 
-    if (row_num <= MPI_DT_SB_DIM_MAX && col_num <= MPI_DT_SB_DIM_MAX)  
+    // Column-major storage: update the transposed piece of the storage frame
+    if (gtm->col_major)
+    {
+        int tmp = row_num;
+        row_num = col_num;
+        col_num = tmp;
+        trans   = 1 - trans;
+    }
+
+    if (trans == 1)
+    {
+        // Target data type traverses the target block column by column, 
+        // the transpose is done by MPI when accumulating
+        MPI_Datatype dst_dt, src_dt;
+        GTM_createTransBlockType(gtm, row_num, col_num, dst_blk_ld, &dst_dt);
+        MPI_Type_vector(col_num, row_num, src_buf_ld, gtm->datatype, &src_dt);
+        MPI_Type_commit(&src_dt);
+        MPI_Accumulate(src_buf, 1, src_dt, dst_rank, dst_pos, 1, dst_dt, op, gtm->mpi_win);
+        MPI_Type_free(&dst_dt);
+        MPI_Type_free(&src_dt);
+        return GTM_SUCCESS;
+    }
+
+    if (col_num == dst_blk_ld)
+    {
+        // Whole rows of the local block or of a tile, the target is contiguous
+        int nelem = row_num * col_num;
+        if (col_num == src_buf_ld)
+        {
+            MPI_Accumulate(src_buf, nelem, gtm->datatype, dst_rank, dst_pos, nelem, gtm->datatype, op, gtm->mpi_win);
+        } else {
+            MPI_Datatype rcv_dt;
+            MPI_Type_vector(row_num, col_num, src_buf_ld, gtm->datatype, &rcv_dt);
+            MPI_Type_commit(&rcv_dt);
+            MPI_Accumulate(src_buf, 1, rcv_dt, dst_rank, dst_pos, nelem, gtm->datatype, op, gtm->mpi_win);
+            MPI_Type_free(&rcv_dt);
+        }
+    } else if (row_num <= MPI_DT_SB_DIM_MAX && col_num <= MPI_DT_SB_DIM_MAX && dst_blk_ld == gtm->ld_local)  
     {
         // Block is small, use predefined data type or define a new 
         // data type to reduce MPI_Accumulate overhead
@@ -85,24 +439,340 @@ int GTM_updateBlockToProcess(
     return GTM_SUCCESS;
 }
 
+// Update (put or accumulate) a block to a process with the given access mode
+// Input parameters are the same as GTM_updateBlockToProcess(), plus:
+//   access_mode : Access mode, see GTMatrix_Typedef.h
+static int GTM_updateBlockToProcessMode(
+    GTMatrix_t gtm, int dst_rank, MPI_Op op, 
+    int row_start, int row_num,
+    int col_start, int col_num,
+    void *src_buf, int src_buf_ld, int trans, void *alpha,
+    int access_mode
+)
+{
+    int ret = GTM_SUCCESS;
+    
+    // Region locks: hold the lock tiles touched by this block and finish the 
+    // update before releasing them, nonblocking updates keep the epoch open
+    if ((gtm->region_lock != NULL) && (access_mode != BATCH_ACCESS))
+    {
+        int in_nb_epoch = (gtm->nb_op_proc_cnt[dst_rank] != 0);
+        GTM_markLockTiles(gtm, dst_rank, row_start, row_num, col_start, col_num);
+        GTM_acquireLockTiles(gtm, dst_rank);
+        if (in_nb_epoch == 0) MPI_Win_lock(MPI_LOCK_SHARED, dst_rank, 0, gtm->mpi_win);
+        ret = GTM_updateBlockToProcess(
+            gtm, dst_rank, op, row_start, row_num, 
+            col_start, col_num, src_buf, src_buf_ld, trans, alpha
+        );
+        if ((access_mode == BLOCKING_ACCESS) && (in_nb_epoch == 0))
+        {
+            MPI_Win_unlock(dst_rank, gtm->mpi_win);
+        } else {
+            MPI_Win_flush(dst_rank, gtm->mpi_win);
+        }
+        GTM_releaseLockTiles(gtm, dst_rank);
+        if (access_mode == NONBLOCKING_ACCESS)
+        {
+            gtm->nb_op_proc_cnt[dst_rank]++;
+            gtm->nb_op_cnt++;
+            if (gtm->nb_op_cnt >= gtm->max_nb_acc) GTM_waitNB(gtm);
+        }
+        return ret;
+    }
+    
+    // Scaled accumulation or an operation with a local kernel to a process in 
+    // the same shared memory communicator with no outstanding operation: update 
+    // the target elements directly under an exclusive lock, the update is 
+    // finished when returning
+    if (((alpha != NULL) || GTM_hasShmOpKernel(gtm, op)) && 
+        (access_mode != BATCH_ACCESS) && (gtm->nb_op_proc_cnt[dst_rank] == 0))
+    {
+        void *shm_ptr = GTM_getShmBlockPtr(gtm, dst_rank);
+        if (shm_ptr != NULL)
+        {
+            MPI_Win_lock(MPI_LOCK_EXCLUSIVE, dst_rank, 0, gtm->mpi_win);
+            GTM_updateBlockToShm(
+                gtm, dst_rank, shm_ptr, op, row_start, row_num, 
+                col_start, col_num, src_buf, src_buf_ld, trans, alpha
+            );
+            MPI_Win_unlock(dst_rank, gtm->mpi_win);
+            return GTM_SUCCESS;
+        }
+    }
+    
+    if (access_mode == BLOCKING_ACCESS)
+    {
+        MPI_Win_lock(gtm->acc_lock_type, dst_rank, 0, gtm->mpi_win);
+        ret = GTM_updateBlockToProcess(
+            gtm, dst_rank, op, row_start, row_num, 
+            col_start, col_num, src_buf, src_buf_ld, trans, alpha
+        );
+        MPI_Win_unlock(dst_rank, gtm->mpi_win);
+    }
+    
+    if (access_mode == NONBLOCKING_ACCESS)
+    {
+        if (gtm->nb_op_proc_cnt[dst_rank] == 0)
+            MPI_Win_lock(gtm->acc_lock_type, dst_rank, 0, gtm->mpi_win);
+        
+        ret = GTM_updateBlockToProcess(
+            gtm, dst_rank, op, row_start, row_num, 
+            col_start, col_num, src_buf, src_buf_ld, trans, alpha
+        );
+        
+        gtm->nb_op_proc_cnt[dst_rank]++;
+        gtm->nb_op_cnt++;
+        if (gtm->nb_op_cnt >= gtm->max_nb_acc) GTM_waitNB(gtm);
+    }
+    
+    if (access_mode == BATCH_ACCESS)
+    {
+        GTM_Req_Vector_t req_vec = gtm->req_vec[dst_rank];
+        ret = GTM_pushToReqVector(
+            req_vec, op, row_start, row_num, 
+            col_start, col_num, src_buf, src_buf_ld, trans
+        );
+        if ((ret == GTM_SUCCESS) && (alpha != NULL))
+            ret = GTM_setReqVectorAlpha(req_vec, alpha, gtm->unit_size);
+    }
+    
+    return ret;
+}
+
+// Update a square piece [row_start, row_start + row_num)^2 on the diagonal of 
+// a diagonal process block to a GTMatrix with symmetric storage. The update 
+// of each upper triangle element and the update of its mirror element are 
+// combined locally, and the square is updated in one operation. Elements in 
+// the lower triangle of a diagonal process block are never read, they receive
+// the source elements as they are. The combined square is a temporary 
+// buffer, so in nonblocking and batch mode the square is updated row by row 
+// instead: the upper part of each row is updated in this row and the lower 
+// part is redirected to the mirror column. double _Complex squares are 
+// always updated in blocking mode, see GTM_updateSymmBlockPiece().
+// Input parameters are the same as GTM_updateBlockToProcessMode() with 
+// col_start == row_start and col_num == row_num
+static int GTM_updateSymmDiagSquare(
+    GTMatrix_t gtm, int dst_rank, MPI_Op op, int row_start, int row_num,
+    void *src_buf, int src_buf_ld, int trans, void *alpha, int access_mode
+)
+{
+    int unit_size = gtm->unit_size;
+    if (MPI_C_DOUBLE_COMPLEX == gtm->datatype) access_mode = BLOCKING_ACCESS;
+    if (access_mode != BLOCKING_ACCESS)
+    {
+        int ret = GTM_SUCCESS;
+        for (int irow = 0; irow < row_num; irow++)
+        {
+            // Source elements (irow, 0) and (irow, irow)
+            size_t l_offset = trans ? (size_t) irow : (size_t) irow * (size_t) src_buf_ld;
+            size_t u_offset = l_offset + (size_t) irow * (trans ? (size_t) src_buf_ld : 1);
+            int row = row_start + irow;
+            ret = GTM_updateBlockToProcessMode(
+                gtm, dst_rank, op, row, 1, row, row_num - irow, 
+                (char*) src_buf + u_offset * (size_t) unit_size, src_buf_ld, trans, alpha, access_mode
+            );
+            if ((ret == GTM_SUCCESS) && (irow > 0))
+                ret = GTM_updateBlockToProcessMode(
+                    gtm, dst_rank, op, row_start, irow, row, 1, 
+                    (char*) src_buf + l_offset * (size_t) unit_size, src_buf_ld, 1 - trans, alpha, access_mode
+                );
+            if (ret != GTM_SUCCESS) return ret;
+        }
+        return GTM_SUCCESS;
+    }
+    
+    size_t sq_msize = (size_t) unit_size * (size_t) row_num * (size_t) row_num;
+    char *sq_buf  = (char*) GTM_allocBuffer(sq_msize * 2);
+    char *mir_buf = sq_buf + sq_msize;
+    if (sq_buf == NULL) return GTM_ALLOC_FAILED;
+    
+    // sq_buf = alpha * (the block), mir_buf = conj(alpha * (the block)^T)
+    for (int irow = 0; irow < row_num; irow++)
+    {
+        for (int icol = 0; icol < row_num; icol++)
+        {
+            size_t sq_pos  = (size_t) irow * (size_t) row_num + (size_t) icol;
+            size_t mir_pos = (size_t) icol * (size_t) row_num + (size_t) irow;
+            size_t buf_pos = trans ? ((size_t) icol * (size_t) src_buf_ld + (size_t) irow) : 
+                                     ((size_t) irow * (size_t) src_buf_ld + (size_t) icol);
+            char *buf_ptr  = (char*) src_buf + buf_pos * (size_t) unit_size;
+            memcpy(sq_buf  + sq_pos  * (size_t) unit_size, buf_ptr, unit_size);
+            memcpy(mir_buf + mir_pos * (size_t) unit_size, buf_ptr, unit_size);
+        }
+    }
+    if (alpha != NULL)
+    {
+        GTM_scaleBlock(gtm, alpha, sq_buf,  row_num, 0, sq_buf,  row_num, row_num, row_num, 0);
+        GTM_scaleBlock(gtm, alpha, mir_buf, row_num, 0, mir_buf, row_num, row_num, row_num, 0);
+    }
+    GTM_conjBlock(gtm, mir_buf, row_num, row_num, row_num);
+    
+    // Combine the two updates of each strictly upper triangle element. The 
+    // mirror element is updated later by the row-by-row order, so it wins 
+    // for MPI_REPLACE.
+    for (int irow = 0; irow < row_num - 1; irow++)
+    {
+        size_t pos = (size_t) irow * (size_t) row_num + (size_t) (irow + 1);
+        char *sq_ptr  = sq_buf  + pos * (size_t) unit_size;
+        char *mir_ptr = mir_buf + pos * (size_t) unit_size;
+        int seg_len   = row_num - 1 - irow;
+        if (MPI_REPLACE == op) memcpy(sq_ptr, mir_ptr, (size_t) seg_len * (size_t) unit_size);
+        else MPI_Reduce_local(mir_ptr, sq_ptr, seg_len, gtm->datatype, op);
+    }
+    
+    if (gtm->nb_op_proc_cnt[dst_rank] != 0) GTM_waitNB(gtm);
+    int ret = GTM_updateBlockToProcessMode(
+        gtm, dst_rank, op, row_start, row_num, row_start, row_num, 
+        sq_buf, row_num, 0, NULL, BLOCKING_ACCESS
+    );
+    GTM_freeBuffer(sq_buf);
+    return ret;
+}
+
+// Update a block piece in process block (blk_r, blk_c), blk_r >= blk_c, to a 
+// GTMatrix with symmetric storage. Lower triangle elements are redirected to 
+// their mirror elements in the upper triangle and transposed by MPI data types. 
+// double _Complex pieces need a conjugated (and scaled) copy of the source, 
+// so they are always updated in blocking mode. A piece crossing the diagonal 
+// of a diagonal process block is split into rectangles in the upper or the 
+// lower triangle and a square on the diagonal, see GTM_updateSymmDiagSquare().
+// Input parameters are the same as GTM_updateBlockToProcessMode(), plus:
+//   blk_r, blk_c : Process block of the piece 
+static int GTM_updateSymmBlockPiece(
+    GTMatrix_t gtm, int blk_r, int blk_c, MPI_Op op, 
+    int row_start, int row_num,
+    int col_start, int col_num,
+    void *src_buf, int src_buf_ld, int trans, void *alpha,
+    int access_mode
+)
+{
+    int dst_rank  = blk_c * gtm->c_blocks + blk_r;  // Mirror process block in upper triangle
+    int unit_size = gtm->unit_size;
+    int row_end   = row_start + row_num - 1;
+    int col_end   = col_start + col_num - 1;
+    int ret = GTM_SUCCESS;
+    
+    // Upper triangle piece of a diagonal block
+    if ((blk_r == blk_c) && (col_start >= row_end))
+    {
+        if (MPI_C_DOUBLE_COMPLEX == gtm->datatype)
+        {
+            if (gtm->nb_op_proc_cnt[dst_rank] != 0) GTM_waitNB(gtm);
+            access_mode = BLOCKING_ACCESS;
+        }
+        return GTM_updateBlockToProcessMode(
+            gtm, dst_rank, op, row_start, row_num, col_start, col_num, 
+            src_buf, src_buf_ld, trans, alpha, access_mode
+        );
+    }
+    
+    // Diagonal block: rows above and below the diagonal square [d_s, d_e]^2 
+    // are in one triangle, so are columns left and right of the square
+    if ((blk_r == blk_c) && (col_end >= row_start))
+    {
+        int d_s = MAX(row_start, col_start);
+        int d_e = MIN(row_end, col_end);
+        if ((row_start < d_s) || (row_end > d_e))
+        {
+            int sub_s[3] = {row_start, d_s, d_e + 1};
+            int sub_n[3] = {d_s - row_start, d_e - d_s + 1, row_end - d_e};
+            for (int i = 0; i < 3; i++)
+            {
+                if (sub_n[i] == 0) continue;
+                size_t offset = (size_t) (sub_s[i] - row_start) * (trans ? 1 : (size_t) src_buf_ld);
+                ret = GTM_updateSymmBlockPiece(
+                    gtm, blk_r, blk_c, op, sub_s[i], sub_n[i], col_start, col_num, 
+                    (char*) src_buf + offset * (size_t) unit_size, src_buf_ld, trans, alpha, access_mode
+                );
+                if (ret != GTM_SUCCESS) return ret;
+            }
+            return GTM_SUCCESS;
+        }
+        if ((col_start < d_s) || (col_end > d_e))
+        {
+            int sub_s[3] = {col_start, d_s, d_e + 1};
+            int sub_n[3] = {d_s - col_start, d_e - d_s + 1, col_end - d_e};
+            for (int i = 0; i < 3; i++)
+            {
+                if (sub_n[i] == 0) continue;
+                size_t offset = (size_t) (sub_s[i] - col_start) * (trans ? (size_t) src_buf_ld : 1);
+                ret = GTM_updateSymmBlockPiece(
+                    gtm, blk_r, blk_c, op, row_start, row_num, sub_s[i], sub_n[i], 
+                    (char*) src_buf + offset * (size_t) unit_size, src_buf_ld, trans, alpha, access_mode
+                );
+                if (ret != GTM_SUCCESS) return ret;
+            }
+            return GTM_SUCCESS;
+        }
+        return GTM_updateSymmDiagSquare(
+            gtm, dst_rank, op, row_start, row_num, 
+            src_buf, src_buf_ld, trans, alpha, access_mode
+        );
+    }
+    
+    // Lower triangle piece. Source of mirrored elements, it has the same layout as src_buf
+    void *mir_buf   = src_buf;
+    void *mir_alpha = alpha;
+    int mir_buf_ld  = src_buf_ld;
+    if (MPI_C_DOUBLE_COMPLEX == gtm->datatype)
+    {
+        int s_nrow = (trans == 1) ? col_num : row_num;
+        int s_ncol = (trans == 1) ? row_num : col_num;
+        if (gtm->nb_op_proc_cnt[dst_rank] != 0) GTM_waitNB(gtm);
+        access_mode = BLOCKING_ACCESS;
+        mir_buf_ld  = s_ncol;
+        mir_buf     = GTM_allocBuffer((size_t) unit_size * (size_t) s_nrow * (size_t) s_ncol);
+        if (mir_buf == NULL) return GTM_ALLOC_FAILED;
+        if (alpha != NULL)
+        {
+            // conj(alpha * x) is accumulated to the mirror element
+            GTM_scaleBlock(gtm, alpha, src_buf, src_buf_ld, 0, mir_buf, mir_buf_ld, s_nrow, s_ncol, 0);
+            mir_alpha = NULL;
+        } else {
+            for (int irow = 0; irow < s_nrow; irow++)
+            {
+                memcpy(
+                    (char*) mir_buf + (size_t) irow * (size_t) s_ncol * (size_t) unit_size, 
+                    (char*) src_buf + (size_t) irow * (size_t) src_buf_ld * (size_t) unit_size, 
+                    (size_t) s_ncol * (size_t) unit_size
+                );
+            }
+        }
+        GTM_conjBlock(gtm, mir_buf, mir_buf_ld, s_nrow, s_ncol);
+    }
+    
+    // A source buffer holding a block holds the transpose of its mirror block
+    ret = GTM_updateBlockToProcessMode(
+        gtm, dst_rank, op, col_start, col_num, row_start, row_num, 
+        mir_buf, mir_buf_ld, 1 - trans, mir_alpha, access_mode
+    );
+    if (mir_buf != src_buf) GTM_freeBuffer(mir_buf);
+    return ret;
+}
+
 // Update (put or accumulate) a block to all related processes using MPI_Accumulate
 // This call is not collective, not thread-safe
 // Input parameters:
 //   gtm      : GTMatrix handle
-//   op          : MPI operation, only support MPI_SUM (acc) and MPI_REPLACE (put)
+//   op          : Predefined MPI operation, MPI_REPLACE for put
 //   row_start   : 1st row of the source block
 //   row_num     : Number of rows the source block has
 //   col_start   : 1st column of the source block
 //   col_num     : Number of columns the source block has
 //   *src_buf    : Source buffer
 //   src_buf_ld  : Leading dimension of the source buffer
+//   trans       : If src_buf holds the transpose of the target block, 
+//                 i.e. src_buf is a col_num * row_num matrix
+//   *alpha      : Scaling factor for accumulation (op == MPI_SUM), NULL means 1
 //   access_mode : Access mode, see GTMatrix_Typedef.h
-int GTM_updateBlock(
+//   *search_range : Process grid blocks to search for the owners of the block,
+//                   see GTM_findOwnerBlocks(), NULL means all blocks
+int GTM_updateBlockInRange(
     GTMatrix_t gtm, MPI_Op op, 
     int row_start, int row_num,
     int col_start, int col_num,
-    void *src_buf, int src_buf_ld,
-    int access_mode
+    void *src_buf, int src_buf_ld, int trans, void *alpha,
+    int access_mode, const int *search_range
 )
 {
     if (gtm == NULL) return GTM_NULL_PTR;
@@ -112,24 +782,12 @@ int GTM_updateBlock(
         (row_num * col_num == 0)) return GTM_INVALID_BLOCK;
     
     // Find the processes that contain the requested block
-    // No need to initialize, just to avoid compiler warning
-    int s_blk_r = 0, e_blk_r = -1, s_blk_c = 0, e_blk_c = -1;  
+    int owner_range[4];
+    GTM_findOwnerBlocks(gtm, row_start, row_num, col_start, col_num, search_range, &owner_range[0]);
+    int s_blk_r = owner_range[0], e_blk_r = owner_range[1];
+    int s_blk_c = owner_range[2], e_blk_c = owner_range[3];
     int row_end = row_start + row_num - 1;
     int col_end = col_start + col_num - 1;
-    for (int i = 0; i < gtm->r_blocks; i++)
-    {
-        if ((gtm->r_displs[i] <= row_start) && 
-            (row_start < gtm->r_displs[i+1])) s_blk_r = i;
-        if ((gtm->r_displs[i] <= row_end)   && 
-            (row_end   < gtm->r_displs[i+1])) e_blk_r = i;
-    }
-    for (int i = 0; i < gtm->c_blocks; i++)
-    {
-        if ((gtm->c_displs[i] <= col_start) && 
-            (col_start < gtm->c_displs[i+1])) s_blk_c = i;
-        if ((gtm->c_displs[i] <= col_end)   && 
-            (col_end   < gtm->c_displs[i+1])) e_blk_c = i;
-    }
     
     // Update data to each process
     int blk_r_s, blk_r_e, blk_c_s, blk_c_e, need_to_fetch;
@@ -153,50 +811,42 @@ int GTM_updateBlock(
             int row_dist  = blk_r_s - row_start;
             int col_dist  = blk_c_s - col_start;
             char *blk_ptr = (char*) src_buf;
-            blk_ptr += (row_dist * src_buf_ld + col_dist) * gtm->unit_size;
-            
-            int ret = MPI_SUCCESS;
+            if (trans == 0) blk_ptr += (row_dist * src_buf_ld + col_dist) * gtm->unit_size;
+            else            blk_ptr += (col_dist * src_buf_ld + row_dist) * gtm->unit_size;
             
-            if (access_mode == BLOCKING_ACCESS)
+            int ret;
+            if (gtm->symm_storage && (blk_r >= blk_c))
             {
-                MPI_Win_lock(gtm->acc_lock_type, dst_rank, 0, gtm->mpi_win);
-                ret = GTM_updateBlockToProcess(
-                    gtm, dst_rank, op, blk_r_s, blk_r_num, 
-                    blk_c_s, blk_c_num, blk_ptr, src_buf_ld
+                ret = GTM_updateSymmBlockPiece(
+                    gtm, blk_r, blk_c, op, blk_r_s, blk_r_num, 
+                    blk_c_s, blk_c_num, blk_ptr, src_buf_ld, trans, alpha, access_mode
                 );
-                MPI_Win_unlock(dst_rank, gtm->mpi_win);
-            }
-            
-            if (access_mode == NONBLOCKING_ACCESS)
-            {
-                if (gtm->nb_op_proc_cnt[dst_rank] == 0)
-                    MPI_Win_lock(gtm->acc_lock_type, dst_rank, 0, gtm->mpi_win);
-                
-                ret = GTM_updateBlockToProcess(
+            } else {
+                ret = GTM_updateBlockToProcessMode(
                     gtm, dst_rank, op, blk_r_s, blk_r_num, 
-                    blk_c_s, blk_c_num, blk_ptr, src_buf_ld
-                );
-                
-                gtm->nb_op_proc_cnt[dst_rank]++;
-                gtm->nb_op_cnt++;
-                if (gtm->nb_op_cnt >= gtm->max_nb_acc) GTM_waitNB(gtm);
-            }
-            
-            if (access_mode == BATCH_ACCESS)
-            {
-                GTM_Req_Vector_t req_vec = gtm->req_vec[dst_rank];
-                ret = GTM_pushToReqVector(
-                    req_vec, op, blk_r_s, blk_r_num, 
-                    blk_c_s, blk_c_num, blk_ptr, src_buf_ld
+                    blk_c_s, blk_c_num, blk_ptr, src_buf_ld, trans, alpha, access_mode
                 );
             }
-            
             if (ret != GTM_SUCCESS) return ret;
         }
     }
     return GTM_SUCCESS;
 }
 
+int GTM_updateBlock(
+    GTMatrix_t gtm, MPI_Op op, 
+    int row_start, int row_num,
+    int col_start, int col_num,
+    void *src_buf, int src_buf_ld, int trans, void *alpha,
+    int access_mode
+)
+{
+    return GTM_updateBlockInRange(
+        gtm, op, row_start, row_num, col_start, col_num, 
+        src_buf, src_buf_ld, trans, alpha, access_mode, NULL
+    );
+}
+
 // Start a batch update epoch and allow to submit update requests
 int GTM_startBatchUpdate(GTMatrix_t gtm)
 {
@@ -213,6 +863,11 @@ int GTM_startBatchUpdate(GTMatrix_t gtm)
 }
 
 // Execute all update requests in the queues
+// Requests to the same process are executed in a single access epoch, grouped 
+// by operation: all requests with the first submitted operation, then all 
+// requests with the next operation, and so on. The order of requests with the 
+// same operation is preserved. With region locks (GTM_UPDATE_ATOMICITY=3), 
+// the lock tiles touched by all requests to a process are held in this epoch.
 int GTM_execBatchUpdate(GTMatrix_t gtm)
 {
     if (gtm->in_batch_put == 0) return GTM_NO_BATCHED_PUT;
@@ -225,27 +880,76 @@ int GTM_execBatchUpdate(GTMatrix_t gtm)
         
         if (req_vec->curr_size > 0) 
         {
-            MPI_Win_lock(gtm->acc_lock_type, dst_rank, 0, gtm->mpi_win);
-            for (int i = 0; i < req_vec->curr_size; i++)
+            // If the target is in the same shared memory communicator and some requests 
+            // can be done by local kernels, use an exclusive epoch to run these kernels
+            void *shm_ptr = GTM_getShmBlockPtr(gtm, dst_rank);
+            int lock_type = gtm->acc_lock_type;
+            int use_shm_kernel = 0;
+            if (shm_ptr != NULL)
             {
-                MPI_Op op      = req_vec->ops[i];
-                int blk_r_s    = req_vec->row_starts[i];
-                int blk_r_num  = req_vec->row_nums[i];
-                int blk_c_s    = req_vec->col_starts[i];
-                int blk_c_num  = req_vec->col_nums[i];
-                void *blk_ptr  = req_vec->src_bufs[i];
-                int src_buf_ld = req_vec->src_buf_lds[i];
-                int ret = GTM_updateBlockToProcess(
-                    gtm, dst_rank, op, blk_r_s, blk_r_num, 
-                    blk_c_s, blk_c_num, blk_ptr, src_buf_ld
-                );
-                if (ret != GTM_SUCCESS) return ret;
+                for (int i = 0; i < req_vec->curr_size; i++)
+                    if (req_vec->scaled[i] || GTM_hasShmOpKernel(gtm, req_vec->ops[i])) use_shm_kernel = 1;
+            }
+            if (use_shm_kernel && (gtm->region_lock == NULL)) lock_type = MPI_LOCK_EXCLUSIVE;
+            if (gtm->region_lock != NULL)
+            {
+                for (int i = 0; i < req_vec->curr_size; i++)
+                    GTM_markLockTiles(
+                        gtm, dst_rank, req_vec->row_starts[i], req_vec->row_nums[i], 
+                        req_vec->col_starts[i], req_vec->col_nums[i]
+                    );
+                GTM_acquireLockTiles(gtm, dst_rank);
+            }
+            
+            MPI_Op group_ops[GTM_MAX_UPDATE_OPS];
+            int n_group = 0;
+            MPI_Win_lock(lock_type, dst_rank, 0, gtm->mpi_win);
+            for (int g = 0; g < req_vec->curr_size; g++)
+            {
+                // Request g starts a new group if its op has not been executed
+                MPI_Op op = req_vec->ops[g];
+                int new_group = 1;
+                for (int k = 0; k < n_group; k++)
+                    if (group_ops[k] == op) new_group = 0;
+                if (new_group == 0) continue;
+                assert(n_group < GTM_MAX_UPDATE_OPS);
+                group_ops[n_group++] = op;
+                
+                for (int i = g; i < req_vec->curr_size; i++)
+                {
+                    if (req_vec->ops[i] != op) continue;
+                    int blk_r_s    = req_vec->row_starts[i];
+                    int blk_r_num  = req_vec->row_nums[i];
+                    int blk_c_s    = req_vec->col_starts[i];
+                    int blk_c_num  = req_vec->col_nums[i];
+                    void *blk_ptr  = req_vec->src_bufs[i];
+                    int src_buf_ld = req_vec->src_buf_lds[i];
+                    int trans      = req_vec->trans[i];
+                    void *alpha    = NULL;
+                    if (req_vec->scaled[i]) alpha = req_vec->alphas + i * GTM_RV_ALPHA_SIZE;
+                    if (use_shm_kernel && ((alpha != NULL) || GTM_hasShmOpKernel(gtm, op)))
+                    {
+                        MPI_Win_flush(dst_rank, gtm->mpi_win);
+                        GTM_updateBlockToShm(
+                            gtm, dst_rank, shm_ptr, op, blk_r_s, blk_r_num, 
+                            blk_c_s, blk_c_num, blk_ptr, src_buf_ld, trans, alpha
+                        );
+                        continue;
+                    }
+                    int ret = GTM_updateBlockToProcess(
+                        gtm, dst_rank, op, blk_r_s, blk_r_num, 
+                        blk_c_s, blk_c_num, blk_ptr, src_buf_ld, trans, alpha
+                    );
+                    if (ret != GTM_SUCCESS) return ret;
+                }
             }
             MPI_Win_unlock(dst_rank, gtm->mpi_win);
+            if (gtm->region_lock != NULL) GTM_releaseLockTiles(gtm, dst_rank);
         }
         
         GTM_resetReqVector(req_vec);
     }
+    GTM_freeTmpBuffers(gtm);
     return GTM_SUCCESS;
 }
 
@@ -260,6 +964,224 @@ int GTM_stopBatchUpdate(GTMatrix_t gtm)
     return GTM_SUCCESS;
 }
 
+// Allocate a temporary source buffer for updates in access_mode. In nonblocking 
+// and batch mode the buffer is kept until the updates finish, see GTM_keepTmpBuffer()
+static void *GTM_allocTmpSrcBuffer(GTMatrix_t gtm, size_t msize, int access_mode)
+{
+    if (access_mode == BLOCKING_ACCESS) return GTM_allocBuffer(msize);
+    void *buf = malloc(msize);
+    if ((buf != NULL) && (GTM_reserveTmpBuffer(gtm) != GTM_SUCCESS))
+    {
+        free(buf);
+        buf = NULL;
+    }
+    return buf;
+}
+
+// Release a temporary source buffer after its updates in access_mode are posted
+static void GTM_freeTmpSrcBuffer(GTMatrix_t gtm, void *buf, int access_mode)
+{
+    if (access_mode == BLOCKING_ACCESS) GTM_freeBuffer(buf);
+    else GTM_keepTmpBuffer(gtm, buf);
+}
+
+// Accumulate a block X to A(row_start : row_start+row_num-1, col_start : col_start+col_num-1)
+// and X^T (X^H for double _Complex) to the mirror block of A. X^T is accumulated from the 
+// same source buffer by a transposing target data type, no transposed copy is needed. 
+// If the block is a diagonal block, X + X^T is formed locally and accumulated once. 
+// Otherwise X and X^T go to different elements and are sent as two operations: one-sided 
+// operations cannot form X^T at the owner. With symmetric storage, the block is always 
+// accumulated in one payload. 
+// Diagonal blocks and double _Complex mirror blocks need a local temporary buffer, in 
+// nonblocking and batch mode it is kept until the accumulation finishes. 
+// This call is not collective, not thread-safe
+// Input parameters are the same as GTM_updateBlock() without op and trans, 
+// src_buf is always row-major
+static int GTM_accBlockSymRowMajor(GTM_PARAM, int access_mode)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    if (gtm->nrows != gtm->ncols) return GTM_NOT_SQUARE_MAT;
+    if ((row_start < 0) || (col_start < 0) ||
+        (row_start + row_num > gtm->nrows)  ||
+        (col_start + col_num > gtm->ncols)  ||
+        (row_num * col_num == 0)) return GTM_INVALID_BLOCK;
+    
+    int unit_size  = gtm->unit_size;
+    int is_complex = (MPI_C_DOUBLE_COMPLEX == gtm->datatype) ? 1 : 0;
+    int ret;
+    
+    // With symmetric storage, the mirror elements are the same elements, accumulating X 
+    // to a lower triangle element is already redirected to the mirror element. Only the 
+    // diagonal elements of A need X^T once more, they are added to a copy of X so that 
+    // the block is accumulated in one payload.
+    if (gtm->symm_storage)
+    {
+        int diag_s = MAX(row_start, col_start);
+        int diag_e = MIN(row_start + row_num, col_start + col_num) - 1;
+        if (diag_s > diag_e)
+        {
+            return GTM_updateBlock(
+                gtm, MPI_SUM, row_start, row_num, col_start, col_num, 
+                src_buf, src_buf_ld, 0, NULL, access_mode
+            );
+        }
+        char *diag_buf = (char*) GTM_allocTmpSrcBuffer(gtm, (size_t) unit_size * (size_t) row_num * (size_t) col_num, access_mode);
+        if (diag_buf == NULL) return GTM_ALLOC_FAILED;
+        for (int irow = 0; irow < row_num; irow++)
+        {
+            char *src_row = (char*) src_buf + (size_t) irow * (size_t) src_buf_ld * unit_size;
+            memcpy(diag_buf + (size_t) irow * (size_t) col_num * unit_size, src_row, (size_t) col_num * unit_size);
+        }
+        for (int i = diag_s; i <= diag_e; i++)
+        {
+            double _Complex diag_val;
+            char *diag_ptr = diag_buf + ((size_t) (i - row_start) * (size_t) col_num + (size_t) (i - col_start)) * unit_size;
+            memcpy(&diag_val, diag_ptr, unit_size);
+            GTM_conjBlock(gtm, &diag_val, 1, 1, 1);
+            MPI_Reduce_local(&diag_val, diag_ptr, 1, gtm->datatype, MPI_SUM);
+        }
+        ret = GTM_updateBlock(
+            gtm, MPI_SUM, row_start, row_num, col_start, col_num, 
+            diag_buf, col_num, 0, NULL, access_mode
+        );
+        GTM_freeTmpSrcBuffer(gtm, diag_buf, access_mode);
+        return ret;
+    }
+    
+    // Diagonal block: accumulate X + X^T once 
+    if ((row_start == col_start) && (row_num == col_num))
+    {
+        int n = row_num;
+        char *sum_buf = (char*) GTM_allocTmpSrcBuffer(gtm, (size_t) unit_size * (size_t) n * (size_t) n, access_mode);
+        if (sum_buf == NULL) return GTM_ALLOC_FAILED;
+        for (int irow = 0; irow < n; irow++)
+        {
+            char *src_row = (char*) src_buf + (size_t) irow * (size_t) src_buf_ld * unit_size;
+            memcpy(sum_buf + (size_t) irow * (size_t) n * unit_size, src_row, (size_t) n * unit_size);
+        }
+        if (MPI_INT == gtm->datatype)
+        {
+            int *sum = (int*) sum_buf;
+            for (int irow = 0; irow < n; irow++)
+            {
+                for (int icol = irow + 1; icol < n; icol++)
+                {
+                    int tmp = sum[irow * n + icol] + sum[icol * n + irow];
+                    sum[irow * n + icol] = tmp;
+                    sum[icol * n + irow] = tmp;
+                }
+                sum[irow * n + irow] *= 2;
+            }
+        }
+        if (MPI_DOUBLE == gtm->datatype)
+        {
+            double *sum = (double*) sum_buf;
+            for (int irow = 0; irow < n; irow++)
+            {
+                for (int icol = irow + 1; icol < n; icol++)
+                {
+                    double tmp = sum[irow * n + icol] + sum[icol * n + irow];
+                    sum[irow * n + icol] = tmp;
+                    sum[icol * n + irow] = tmp;
+                }
+                sum[irow * n + irow] *= 2.0;
+            }
+        }
+        if (MPI_C_DOUBLE_COMPLEX == gtm->datatype)
+        {
+            double _Complex *sum = (double _Complex*) sum_buf;
+            for (int irow = 0; irow < n; irow++)
+            {
+                for (int icol = irow + 1; icol < n; icol++)
+                {
+                    double _Complex upper = sum[irow * n + icol];
+                    double _Complex lower = sum[icol * n + irow];
+                    sum[irow * n + icol] = upper + conj(lower);
+                    sum[icol * n + irow] = lower + conj(upper);
+                }
+                sum[irow * n + irow] += conj(sum[irow * n + irow]);
+            }
+        }
+        ret = GTM_updateBlock(gtm, MPI_SUM, row_start, n, col_start, n, sum_buf, n, 0, NULL, access_mode);
+        GTM_freeTmpSrcBuffer(gtm, sum_buf, access_mode);
+        return ret;
+    }
+    
+    ret = GTM_updateBlock(
+        gtm, MPI_SUM, row_start, row_num, col_start, col_num, 
+        src_buf, src_buf_ld, 0, NULL, access_mode
+    );
+    if (ret != GTM_SUCCESS) return ret;
+    
+    if (is_complex == 0)
+    {
+        ret = GTM_updateBlock(
+            gtm, MPI_SUM, col_start, col_num, row_start, row_num, 
+            src_buf, src_buf_ld, 1, NULL, access_mode
+        );
+    } else {
+        size_t conj_buf_msize = (size_t) unit_size * (size_t) row_num * (size_t) col_num;
+        char *conj_buf = (char*) GTM_allocTmpSrcBuffer(gtm, conj_buf_msize, access_mode);
+        if (conj_buf == NULL) return GTM_ALLOC_FAILED;
+        for (int irow = 0; irow < row_num; irow++)
+        {
+            char *src_row = (char*) src_buf + (size_t) irow * (size_t) src_buf_ld * unit_size;
+            memcpy(conj_buf + (size_t) irow * (size_t) col_num * unit_size, src_row, (size_t) col_num * unit_size);
+        }
+        GTM_conjBlock(gtm, conj_buf, col_num, row_num, col_num);
+        ret = GTM_updateBlock(
+            gtm, MPI_SUM, col_start, col_num, row_start, row_num, 
+            conj_buf, col_num, 1, NULL, access_mode
+        );
+        GTM_freeTmpSrcBuffer(gtm, conj_buf, access_mode);
+    }
+    return ret;
+}
+
+// Accumulate a block and its transpose from a source buffer in the user buffer 
+// layout, see GTM_accBlockSymRowMajor()
+int GTM_accBlockSym_(GTM_PARAM, int access_mode)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    if (gtm->col_major_buf == 0)
+    {
+        return GTM_accBlockSymRowMajor(
+            gtm, row_start, row_num, col_start, col_num, 
+            src_buf, src_buf_ld, access_mode
+        );
+    }
+    
+    // A column-major buffer of X is a row-major buffer of X^T. For real data 
+    // types, accumulating X^T to A(cols, rows) and X to A(rows, cols) is the same.
+    if (MPI_C_DOUBLE_COMPLEX != gtm->datatype)
+    {
+        return GTM_accBlockSymRowMajor(
+            gtm, col_start, col_num, row_start, row_num, 
+            src_buf, src_buf_ld, access_mode
+        );
+    }
+    
+    // (X^T)^H is conj(X) instead of X, make a row-major copy of X and accumulate it
+    int unit_size = gtm->unit_size;
+    char *rm_buf  = (char*) GTM_allocTmpSrcBuffer(gtm, (size_t) unit_size * (size_t) row_num * (size_t) col_num, access_mode);
+    if (rm_buf == NULL) return GTM_ALLOC_FAILED;
+    for (int irow = 0; irow < row_num; irow++)
+    {
+        for (int icol = 0; icol < col_num; icol++)
+        {
+            size_t src_offset = (size_t) icol * (size_t) src_buf_ld + (size_t) irow;
+            size_t dst_offset = (size_t) irow * (size_t) col_num + (size_t) icol;
+            memcpy(rm_buf + dst_offset * unit_size, (char*) src_buf + src_offset * unit_size, unit_size);
+        }
+    }
+    int ret = GTM_accBlockSymRowMajor(
+        gtm, row_start, row_num, col_start, col_num, 
+        rm_buf, col_num, access_mode
+    );
+    GTM_freeTmpSrcBuffer(gtm, rm_buf, access_mode);
+    return ret;
+}
+
 // ========== Below are wrapper functions ========== //
 
 // Put / accumulate a block to the global matrix
@@ -270,7 +1192,7 @@ int GTM_putBlock(GTM_PARAM)
         gtm, MPI_REPLACE, 
         row_start, row_num,
         col_start, col_num,
-        src_buf, src_buf_ld, BLOCKING_ACCESS
+        src_buf, src_buf_ld, gtm->col_major_buf, NULL, BLOCKING_ACCESS
     );
 }
 int GTM_accBlock(GTM_PARAM)
@@ -280,7 +1202,7 @@ int GTM_accBlock(GTM_PARAM)
         gtm, MPI_SUM, 
         row_start, row_num,
         col_start, col_num,
-        src_buf, src_buf_ld, BLOCKING_ACCESS
+        src_buf, src_buf_ld, gtm->col_major_buf, NULL, BLOCKING_ACCESS
     );
 }
 
@@ -292,7 +1214,7 @@ int GTM_putBlockNB(GTM_PARAM)
         gtm, MPI_REPLACE, 
         row_start, row_num,
         col_start, col_num,
-        src_buf, src_buf_ld, NONBLOCKING_ACCESS
+        src_buf, src_buf_ld, gtm->col_major_buf, NULL, NONBLOCKING_ACCESS
     );
 }
 int GTM_accBlockNB(GTM_PARAM)
@@ -302,7 +1224,7 @@ int GTM_accBlockNB(GTM_PARAM)
         gtm, MPI_SUM, 
         row_start, row_num,
         col_start, col_num,
-        src_buf, src_buf_ld, NONBLOCKING_ACCESS
+        src_buf, src_buf_ld, gtm->col_major_buf, NULL, NONBLOCKING_ACCESS
     );
 }
 
@@ -314,7 +1236,7 @@ int GTM_addPutBlockRequest(GTM_PARAM)
         gtm, MPI_REPLACE, 
         row_start, row_num,
         col_start, col_num,
-        src_buf, src_buf_ld, BATCH_ACCESS
+        src_buf, src_buf_ld, gtm->col_major_buf, NULL, BATCH_ACCESS
     );
 }
 int GTM_addAccBlockRequest(GTM_PARAM)
@@ -324,7 +1246,7 @@ int GTM_addAccBlockRequest(GTM_PARAM)
         gtm, MPI_SUM, 
         row_start, row_num,
         col_start, col_num,
-        src_buf, src_buf_ld, BATCH_ACCESS
+        src_buf, src_buf_ld, gtm->col_major_buf, NULL, BATCH_ACCESS
     );
 }
 
@@ -356,4 +1278,100 @@ int GTM_stopBatchPut(GTMatrix_t gtm)
 int GTM_stopBatchAcc(GTMatrix_t gtm)
 {
     return GTM_stopBatchUpdate(gtm);
-}
\ No newline at end of file
+}
+
+// Accumulate a block and its transpose to the global matrix
+int GTM_accBlockSym(GTM_PARAM)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    return GTM_accBlockSym_(
+        gtm, row_start, row_num, col_start, col_num,
+        src_buf, src_buf_ld, BLOCKING_ACCESS
+    );
+}
+int GTM_accBlockSymNB(GTM_PARAM)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    return GTM_accBlockSym_(
+        gtm, row_start, row_num, col_start, col_num,
+        src_buf, src_buf_ld, NONBLOCKING_ACCESS
+    );
+}
+int GTM_addAccBlockSymRequest(GTM_PARAM)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    return GTM_accBlockSym_(
+        gtm, row_start, row_num, col_start, col_num,
+        src_buf, src_buf_ld, BATCH_ACCESS
+    );
+}
+
+// Accumulate alpha * (a block) to the global matrix
+int GTM_accBlockScaled(GTM_PARAM, void *alpha)
+{
+    if ((gtm == NULL) || (alpha == NULL)) return GTM_NULL_PTR;
+    return GTM_updateBlock(
+        gtm, MPI_SUM, 
+        row_start, row_num,
+        col_start, col_num,
+        src_buf, src_buf_ld, gtm->col_major_buf, alpha, BLOCKING_ACCESS
+    );
+}
+int GTM_accBlockScaledNB(GTM_PARAM, void *alpha)
+{
+    if ((gtm == NULL) || (alpha == NULL)) return GTM_NULL_PTR;
+    return GTM_updateBlock(
+        gtm, MPI_SUM, 
+        row_start, row_num,
+        col_start, col_num,
+        src_buf, src_buf_ld, gtm->col_major_buf, alpha, NONBLOCKING_ACCESS
+    );
+}
+int GTM_addAccBlockScaledRequest(GTM_PARAM, void *alpha)
+{
+    if ((gtm == NULL) || (alpha == NULL)) return GTM_NULL_PTR;
+    return GTM_updateBlock(
+        gtm, MPI_SUM, 
+        row_start, row_num,
+        col_start, col_num,
+        src_buf, src_buf_ld, gtm->col_major_buf, alpha, BATCH_ACCESS
+    );
+}
+
+// Update a block to the global matrix with a predefined MPI operation
+int GTM_updateBlockOp(GTM_PARAM, MPI_Op op)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    int ret = GTM_checkUpdateOp(gtm, op);
+    if (ret != GTM_SUCCESS) return ret;
+    return GTM_updateBlock(
+        gtm, op, 
+        row_start, row_num,
+        col_start, col_num,
+        src_buf, src_buf_ld, gtm->col_major_buf, NULL, BLOCKING_ACCESS
+    );
+}
+int GTM_updateBlockOpNB(GTM_PARAM, MPI_Op op)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    int ret = GTM_checkUpdateOp(gtm, op);
+    if (ret != GTM_SUCCESS) return ret;
+    return GTM_updateBlock(
+        gtm, op, 
+        row_start, row_num,
+        col_start, col_num,
+        src_buf, src_buf_ld, gtm->col_major_buf, NULL, NONBLOCKING_ACCESS
+    );
+}
+int GTM_addUpdateBlockOpRequest(GTM_PARAM, MPI_Op op)
+{
+    if (gtm == NULL) return GTM_NULL_PTR;
+    int ret = GTM_checkUpdateOp(gtm, op);
+    if (ret != GTM_SUCCESS) return ret;
+    return GTM_updateBlock(
+        gtm, op, 
+        row_start, row_num,
+        col_start, col_num,
+        src_buf, src_buf_ld, gtm->col_major_buf, NULL, BATCH_ACCESS
+    );
+}
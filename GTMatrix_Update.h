@@ -36,5 +36,88 @@ int GTM_execBatchAcc(GTMatrix_t gtm);
 int GTM_stopBatchPut(GTMatrix_t gtm);
 int GTM_stopBatchAcc(GTMatrix_t gtm);
 
+// Accumulate a block X and its transpose (conjugate transpose for double _Complex), 
+// i.e. A(rows, cols) += X and A(cols, rows) += X^T, for a square matrix. X^T is 
+// accumulated from src_buf directly, user does not need to form X^T. If the block
+// is a diagonal block (row_start == col_start and row_num == col_num), X + X^T is 
+// accumulated once. Other blocks send X and X^T as two operations from the same 
+// buffer, one-sided operations cannot form X^T at the owner. With GTM_STORAGE_SYMM,
+// the block is sent once. Diagonal blocks, symmetric storage blocks with diagonal 
+// elements and double _Complex X^H are sent from an internal copy, which is kept 
+// until the nonblocking / batch access is finished.
+int GTM_accBlockSym(GTM_PARAM);
+int GTM_accBlockSymNB(GTM_PARAM);
+int GTM_addAccBlockSymRequest(GTM_PARAM);
+
+// Accumulate alpha * X to the global matrix, i.e. A(rows, cols) += alpha * X, 
+// X is not modified and user does not need to form alpha * X. 
+// *alpha : Pointer to the scaling factor, same type as the matrix
+// Blocking / nonblocking / batch mode, the same as GTM_accBlock() / 
+// GTM_accBlockNB() / GTM_addAccBlockRequest(). alpha is copied when the 
+// request is submitted, src_buf must remain valid until the access is finished. 
+int GTM_accBlockScaled(GTM_PARAM, void *alpha);
+int GTM_accBlockScaledNB(GTM_PARAM, void *alpha);
+int GTM_addAccBlockScaledRequest(GTM_PARAM, void *alpha);
+
+// Update a block to the global matrix with a predefined MPI operation, i.e. 
+// A(rows, cols) = op(A(rows, cols), X) element-wise. Supported operations: 
+// MPI_SUM, MPI_PROD, MPI_REPLACE for all data types; MPI_MAX, MPI_MIN for int, 
+// int64 and double; MPI_BAND, MPI_BOR, MPI_BXOR, MPI_LAND, MPI_LOR, MPI_LXOR for 
+// int and int64. 
+// Return GTM_INVALID_OP for other operations (MPI_Accumulate does not accept 
+// user-defined operations). Element-wise atomicity is the same as GTM_accBlock(). 
+// Blocking / nonblocking / batch mode, the same as GTM_accBlock() / 
+// GTM_accBlockNB() / GTM_addAccBlockRequest(). In a batch, requests with 
+// different operations may be executed in a different order than submitted. 
+int GTM_updateBlockOp(GTM_PARAM, MPI_Op op);
+int GTM_updateBlockOpNB(GTM_PARAM, MPI_Op op);
+int GTM_addUpdateBlockOpRequest(GTM_PARAM, MPI_Op op);
+
+// ========== Below are internal helper functions ========== //
+
+// Update a block that is inside dst_rank's local block inside an access epoch 
+// of dst_rank, the update is complete after the next flush of dst_rank
+// Input parameters are the same as GTM_updateBlock(), and:
+//   dst_rank : Target process
+int GTM_updateBlockToProcess(
+    GTMatrix_t gtm, int dst_rank, MPI_Op op, 
+    int row_start, int row_num,
+    int col_start, int col_num,
+    void *src_buf, int src_buf_ld, int trans, void *alpha
+);
+
+// Update a block with op, alpha != NULL means accumulating alpha * (the block)
+// Input parameters are the same as GTM_putBlock(), and:
+//   op          : Predefined MPI operation, MPI_REPLACE for put
+//   trans       : If src_buf holds the transpose of the target block
+//   *alpha      : Scaling factor for accumulation (op == MPI_SUM), NULL means 1
+//   access_mode : Access mode, see GTMatrix_Typedef.h
+int GTM_updateBlock(
+    GTMatrix_t gtm, MPI_Op op, 
+    int row_start, int row_num,
+    int col_start, int col_num,
+    void *src_buf, int src_buf_ld, int trans, void *alpha,
+    int access_mode
+);
+
+// Same as GTM_updateBlock(), only search the owners of the block in search_range,
+// see GTM_findOwnerBlocks(), NULL means all blocks
+int GTM_updateBlockInRange(
+    GTMatrix_t gtm, MPI_Op op, 
+    int row_start, int row_num,
+    int col_start, int col_num,
+    void *src_buf, int src_buf_ld, int trans, void *alpha,
+    int access_mode, const int *search_range
+);
+
+// Mark the region lock tiles of dst_rank touched by a block, the block must be 
+// inside dst_rank's local block. Acquire all marked tiles in ascending order, 
+// release all marked tiles and clear the marks.
+void GTM_markLockTiles(
+    GTMatrix_t gtm, int dst_rank, 
+    int row_start, int row_num, int col_start, int col_num
+);
+void GTM_acquireLockTiles(GTMatrix_t gtm, int dst_rank);
+void GTM_releaseLockTiles(GTMatrix_t gtm, int dst_rank);
 
 #endif
@@ -0,0 +1,141 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <mpi.h>
+#include <complex.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 2
+#define N 160
+
+/*
+Run with: mpirun -np 4 ./test_acc_scaled.x
+Correct output:
+int matrix:
+ 4	 4	 4	 4	 4	 4
+ 4	-4	-4	-4	-4	 4
+ 4	-4	-4	-4	-4	 4
+ 4	 4	 4	 4	 4	 4
+ 4	 4	 4	 4	 4	 4
+ 4	 4	 4	 4	 4	 4
+double matrix max error = 0.000000e+00
+double _Complex matrix max error = 0.000000e+00
+*/
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    int my_rank, nprocs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+    // int matrix, small blocks, all access modes
+    int i_displs[3] = {0, 2, 6};
+    int imat[36], ione[36];
+    int i_alpha = 1, i_zero = 0;
+    for (int i = 0; i < 36; i++) ione[i] = 1;
+    GTMatrix_t gtm_i;
+    GTM_create(
+        &gtm_i, MPI_COMM_WORLD, MPI_INT, 4, my_rank, 6, 6,
+        2, 2, &i_displs[0], &i_displs[0]
+    );
+    GTM_fill(gtm_i, &i_zero);
+    GTM_sync(gtm_i);
+    GTM_accBlockScaled(gtm_i, 0, 6, 0, 6, &ione[0], 6, &i_alpha);
+    i_alpha = -2;
+    GTM_accBlockScaledNB(gtm_i, 1, 2, 1, 2, &ione[0], 6, &i_alpha);
+    GTM_waitNB(gtm_i);
+    GTM_startBatchAcc(gtm_i);
+    GTM_addAccBlockScaledRequest(gtm_i, 1, 2, 3, 2, &ione[0], 6, &i_alpha);
+    i_alpha = 100;  // alpha is copied when the request is submitted
+    GTM_execBatchAcc(gtm_i);
+    GTM_stopBatchAcc(gtm_i);
+    i_alpha = -2;
+    GTM_accBlockScaledNB(gtm_i, 1, 2, 1, 2, &ione[0], 6, &i_alpha);
+    i_alpha = 2;
+    GTM_accBlockScaledNB(gtm_i, 1, 2, 1, 2, &ione[0], 6, &i_alpha);
+    GTM_waitNB(gtm_i);
+    GTM_sync(gtm_i);
+    if (my_rank == ACTOR_RANK)
+    {
+        GTM_getBlock(gtm_i, 0, 6, 0, 6, &imat[0], 6);
+        print_int_mat(&imat[0], 6, 6, 6, "int matrix");
+    }
+    GTM_sync(gtm_i);
+    GTM_destroy(gtm_i);
+
+    // double matrix, blocks larger than the staging buffer
+    int d_displs[3] = {0, 70, N};
+    double *dmat = (double*) malloc(sizeof(double) * N * N);
+    double *dsrc = (double*) malloc(sizeof(double) * N * N);
+    double d_zero = 0.0, d_alpha = 0.25 * (double) (my_rank + 1);
+    for (int i = 0; i < N * N; i++) dsrc[i] = (double) (i % 17);
+    GTMatrix_t gtm_d;
+    GTM_create(
+        &gtm_d, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, N, N,
+        2, 2, &d_displs[0], &d_displs[0]
+    );
+    GTM_fill(gtm_d, &d_zero);
+    GTM_sync(gtm_d);
+    GTM_accBlockScaled(gtm_d, 0, N, 0, N, dsrc, N, &d_alpha);
+    GTM_accBlockScaledNB(gtm_d, 10, N - 20, 5, N - 10, dsrc, N, &d_alpha);
+    GTM_waitNB(gtm_d);
+    GTM_sync(gtm_d);
+    if (my_rank == ACTOR_RANK)
+    {
+        double alpha_sum = 0.0, max_err = 0.0;
+        for (int p = 0; p < nprocs; p++) alpha_sum += 0.25 * (double) (p + 1);
+        GTM_getBlock(gtm_d, 0, N, 0, N, dmat, N);
+        for (int i = 0; i < N; i++)
+        {
+            for (int j = 0; j < N; j++)
+            {
+                double ref = alpha_sum * dsrc[i * N + j];
+                if ((i >= 10) && (i < N - 10) && (j >= 5) && (j < N - 5))
+                    ref += alpha_sum * dsrc[(i - 10) * N + (j - 5)];
+                max_err = MAX(max_err, fabs(dmat[i * N + j] - ref));
+            }
+        }
+        printf("double matrix max error = %e\n", max_err);
+    }
+    GTM_sync(gtm_d);
+    GTM_destroy(gtm_d);
+    free(dmat);
+    free(dsrc);
+
+    // double _Complex matrix, batch mode
+    int z_displs[3] = {0, 3, 8};
+    double _Complex zmat[64], zsrc[64], z_zero = 0.0, z_alpha = 1.0 + 1.0 * I;
+    for (int i = 0; i < 64; i++) zsrc[i] = (double) i - 2.0 * I;
+    GTMatrix_t gtm_z;
+    GTM_create(
+        &gtm_z, MPI_COMM_WORLD, MPI_C_DOUBLE_COMPLEX, 16, my_rank, 8, 8,
+        2, 2, &z_displs[0], &z_displs[0]
+    );
+    GTM_fill(gtm_z, &z_zero);
+    GTM_sync(gtm_z);
+    GTM_startBatchAcc(gtm_z);
+    GTM_addAccBlockScaledRequest(gtm_z, 0, 8, 0, 8, &zsrc[0], 8, &z_alpha);
+    GTM_execBatchAcc(gtm_z);
+    GTM_stopBatchAcc(gtm_z);
+    GTM_sync(gtm_z);
+    if (my_rank == ACTOR_RANK)
+    {
+        double max_err = 0.0;
+        GTM_getBlock(gtm_z, 0, 8, 0, 8, &zmat[0], 8);
+        for (int i = 0; i < 64; i++)
+        {
+            double _Complex diff = zmat[i] - (double) nprocs * z_alpha * zsrc[i];
+            max_err = MAX(max_err, fabs(creal(diff)) + fabs(cimag(diff)));
+        }
+        printf("double _Complex matrix max error = %e\n", max_err);
+    }
+    GTM_sync(gtm_z);
+    GTM_destroy(gtm_z);
+
+    MPI_Finalize();
+}
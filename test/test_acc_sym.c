@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <mpi.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 3
+
+/*
+Run with: mpirun -np 4 ./test_acc_sym.x
+Correct output:
+Accumulated matrix:
+ 0.000	 0.000	 0.000	 4.000	 8.000	 12.000
+ 0.000	 0.000	 0.000	 16.000	 20.000	 24.000
+ 0.000	 0.000	 0.000	 0.000	 0.000	 0.000
+ 4.000	 16.000	 0.000	 0.000	 0.000	 0.000
+ 8.000	 20.000	 0.000	 0.000	 8.000	 12.000
+ 12.000	 24.000	 0.000	 0.000	 12.000	 16.000
+Full storage max error = 0.000000e+00
+Symmetric storage max error = 0.000000e+00
+*/
+
+// Each process accumulates X and X^T in blocking, nonblocking and batch mode
+static void acc_sym_all_modes(GTMatrix_t gtm, double *X, double *D)
+{
+    GTM_accBlockSym(gtm, 0, 2, 3, 2, X, 3);
+    GTM_accBlockSymNB(gtm, 0, 2, 5, 1, X + 2, 3);
+    GTM_accBlockSymNB(gtm, 4, 2, 4, 2, D, 2);
+    GTM_waitNB(gtm);
+    GTM_startBatchAcc(gtm);
+    GTM_addAccBlockSymRequest(gtm, 4, 2, 4, 2, D, 2);
+    GTM_execBatchAcc(gtm);
+    GTM_stopBatchAcc(gtm);
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    int r_displs[3] = {0, 2, 6};
+    int c_displs[3] = {0, 4, 6};
+    int displs[3]   = {0, 3, 6};
+    double X[6] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+    double D[4] = {0.5, 1.0, 0.5, 1.0};
+    double mat[36], ref[36];
+
+    int my_rank, nprocs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+    // Reference: A(0:1, 3:5) += X, A(3:5, 0:1) += X^T, A(4:5, 4:5) += D + D^T twice
+    for (int i = 0; i < 36; i++) ref[i] = 0.0;
+    for (int p = 0; p < nprocs; p++)
+    {
+        for (int i = 0; i < 2; i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                ref[i * 6 + (j + 3)] += X[i * 3 + j];
+                ref[(j + 3) * 6 + i] += X[i * 3 + j];
+            }
+        }
+        for (int i = 0; i < 2; i++)
+            for (int j = 0; j < 2; j++)
+                ref[(i + 4) * 6 + (j + 4)] += 2.0 * (D[i * 2 + j] + D[j * 2 + i]);
+    }
+
+    GTMatrix_t gtm, gtm_symm;
+    GTM_create(
+        &gtm, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, 6, 6,
+        2, 2, &r_displs[0], &c_displs[0]
+    );
+    GTM_createEx(
+        &gtm_symm, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, 6, 6,
+        2, 2, &displs[0], &displs[0], GTM_STORAGE_SYMM
+    );
+    double d_zero = 0.0;
+    GTM_fill(gtm, &d_zero);
+    GTM_fill(gtm_symm, &d_zero);
+    GTM_sync(gtm);
+
+    acc_sym_all_modes(gtm, &X[0], &D[0]);
+    acc_sym_all_modes(gtm_symm, &X[0], &D[0]);
+    GTM_sync(gtm);
+
+    if (my_rank == ACTOR_RANK)
+    {
+        double max_err = 0.0;
+        GTM_getBlock(gtm, 0, 6, 0, 6, &mat[0], 6);
+        print_double_mat(&mat[0], 6, 6, 6, "Accumulated matrix");
+        for (int i = 0; i < 36; i++) max_err = MAX(max_err, fabs(mat[i] - ref[i]));
+        printf("Full storage max error = %e\n", max_err);
+
+        max_err = 0.0;
+        GTM_getBlock(gtm_symm, 0, 6, 0, 6, &mat[0], 6);
+        for (int i = 0; i < 36; i++) max_err = MAX(max_err, fabs(mat[i] - ref[i]));
+        printf("Symmetric storage max error = %e\n", max_err);
+    }
+    GTM_sync(gtm);
+
+    GTM_destroy(gtm);
+    GTM_destroy(gtm_symm);
+
+    MPI_Finalize();
+}
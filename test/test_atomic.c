@@ -0,0 +1,140 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <mpi.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 0
+#define NITER      100
+
+/*
+Run with: mpirun -np 4 ./test_atomic.x
+Correct output:
+int counter = 400, sum of fetched values = 79800
+int CAS: 1 process succeeded, A(1, 3) = winner rank + 1
+int64 matrix after batched fetch-and-add:
+ 8	 4	 4	 4
+ 4	 4	 4	 4
+ 4	 4	 4	 4
+ 4	 4	 4	 4
+double matrix after fetch-and-accumulate:
+ 10.000	 10.000	 10.000	 10.000
+ 10.000	 10.000	 10.000	 10.000
+ 10.000	 10.000	 10.000	 10.000
+ 10.000	 10.000	 10.000	 10.000
+double A(3, 0): MAX = 3.000, CAS MAX -> 1.5 succeeded 1 time(s), final = 1.500
+*/
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    int displs[3] = {0, 2, 4};
+    int my_rank, nprocs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+    // int: shared counter and compare-and-swap
+    GTMatrix_t gtm_i;
+    int i_zero = 0, i_one = 1, i_fetch, i_sum = 0, i_total;
+    GTM_create(&gtm_i, MPI_COMM_WORLD, MPI_INT, 4, my_rank, 4, 4, 2, 2, &displs[0], &displs[0]);
+    GTM_fill(gtm_i, &i_zero);
+    GTM_sync(gtm_i);
+    for (int i = 0; i < NITER; i++)
+    {
+        GTM_fetchAndOp(gtm_i, 0, 0, MPI_SUM, &i_one, &i_fetch);
+        i_sum += i_fetch;
+    }
+    int i_new = my_rank + 1, i_old, i_success, i_nsuccess;
+    GTM_compareAndSwap(gtm_i, 1, 3, &i_zero, &i_new, &i_old);
+    i_success = (i_old == 0) ? 1 : 0;
+    MPI_Reduce(&i_sum, &i_total, 1, MPI_INT, MPI_SUM, ACTOR_RANK, MPI_COMM_WORLD);
+    MPI_Allreduce(&i_success, &i_nsuccess, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    GTM_sync(gtm_i);
+    int winner = -1;
+    if (i_success) winner = my_rank;
+    MPI_Allreduce(MPI_IN_PLACE, &winner, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    if (my_rank == ACTOR_RANK)
+    {
+        int counter, cas_val;
+        GTM_getBlock(gtm_i, 0, 1, 0, 1, &counter, 1);
+        GTM_getBlock(gtm_i, 1, 1, 3, 1, &cas_val, 1);
+        printf("int counter = %d, sum of fetched values = %d\n", counter, i_total);
+        printf(
+            "int CAS: %d process succeeded, A(1, 3) = %s\n", i_nsuccess,
+            (cas_val == winner + 1) ? "winner rank + 1" : "wrong value"
+        );
+    }
+    GTM_sync(gtm_i);
+    GTM_destroy(gtm_i);
+
+    // int64: batched fetch-and-add on all elements, A(0, 0) appears twice
+    GTMatrix_t gtm_l;
+    int64_t l_zero = 0, l_vals[17], l_res[17], l_mat[16];
+    int rows[17], cols[17];
+    GTM_create(&gtm_l, MPI_COMM_WORLD, MPI_INT64_T, 8, my_rank, 4, 4, 2, 2, &displs[0], &displs[0]);
+    GTM_fill(gtm_l, &l_zero);
+    GTM_sync(gtm_l);
+    for (int i = 0; i < 16; i++)
+    {
+        rows[i]   = (i + 5 * my_rank) % 16 / 4;
+        cols[i]   = (i + 5 * my_rank) % 16 % 4;
+        l_vals[i] = 1;
+    }
+    rows[16] = 0;  cols[16] = 0;  l_vals[16] = 1;
+    GTM_fetchAndOpElements(gtm_l, 17, &rows[0], &cols[0], MPI_SUM, &l_vals[0], &l_res[0]);
+    GTM_sync(gtm_l);
+    if (my_rank == ACTOR_RANK)
+    {
+        int i_mat[16];
+        GTM_getBlock(gtm_l, 0, 4, 0, 4, &l_mat[0], 4);
+        for (int i = 0; i < 16; i++) i_mat[i] = (int) l_mat[i];
+        print_int_mat(&i_mat[0], 4, 4, 4, "int64 matrix after batched fetch-and-add");
+    }
+    GTM_sync(gtm_l);
+    GTM_destroy(gtm_l);
+
+    // double: fetch-and-accumulate a block, element MAX and CAS
+    GTMatrix_t gtm_d;
+    double d_zero = 0.0, d_src[16], d_fetch[16];
+    GTM_create(&gtm_d, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, 4, 4, 2, 2, &displs[0], &displs[0]);
+    GTM_fill(gtm_d, &d_zero);
+    GTM_sync(gtm_d);
+    for (int i = 0; i < 16; i++) d_src[i] = (double) (my_rank + 1);
+    GTM_fetchAccBlock(gtm_d, 0, 4, 0, 4, &d_src[0], 4, MPI_SUM, &d_fetch[0], 4);
+    GTM_sync(gtm_d);
+    if (my_rank == ACTOR_RANK)
+    {
+        GTM_fetchAccBlock(gtm_d, 0, 4, 0, 4, NULL, 4, MPI_NO_OP, &d_fetch[0], 4);
+        print_double_mat(&d_fetch[0], 4, 4, 4, "double matrix after fetch-and-accumulate");
+    }
+    GTM_sync(gtm_d);
+
+    double d_val = (double) my_rank, d_old, d_max;
+    GTM_fetchAndOp(gtm_d, 3, 0, MPI_REPLACE, &d_zero, &d_old);
+    GTM_sync(gtm_d);
+    GTM_fetchAndOp(gtm_d, 3, 0, MPI_MAX, &d_val, &d_old);
+    GTM_sync(gtm_d);
+    GTM_fetchAndOp(gtm_d, 3, 0, MPI_NO_OP, &d_val, &d_max);
+    GTM_sync(gtm_d);
+    double d_cmp = d_max, d_new = 1.5, d_final;
+    GTM_compareAndSwap(gtm_d, 3, 0, &d_cmp, &d_new, &d_old);
+    int d_success = (d_old == d_cmp) ? 1 : 0, d_nsuccess;
+    MPI_Allreduce(&d_success, &d_nsuccess, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    GTM_sync(gtm_d);
+    if (my_rank == ACTOR_RANK)
+    {
+        GTM_getBlock(gtm_d, 3, 1, 0, 1, &d_final, 1);
+        printf(
+            "double A(3, 0): MAX = %.3lf, CAS MAX -> 1.5 succeeded %d time(s), final = %.3lf\n",
+            d_max, d_nsuccess, d_final
+        );
+    }
+    GTM_sync(gtm_d);
+    GTM_destroy(gtm_d);
+
+    MPI_Finalize();
+}
@@ -0,0 +1,113 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 1
+
+/*
+Run with: mpirun -np 4 ./test_blk_sparse.x
+Correct output:
+Updated matrix (only diagonal tiles are non-zero):
+ 4.000	 4.000	 0.000	 0.000	 0.000	 0.000	 0.000	 0.000
+ 4.000	 4.000	 0.000	 0.000	 0.000	 0.000	 0.000	 0.000
+ 0.000	 0.000	 4.000	 4.000	 0.000	 0.000	 0.000	 0.000
+ 0.000	 0.000	 4.000	 4.000	 0.000	 0.000	 0.000	 0.000
+ 0.000	 0.000	 0.000	 0.000	 4.000	 4.000	 0.000	 0.000
+ 0.000	 0.000	 0.000	 0.000	 4.000	 4.000	 0.000	 0.000
+ 0.000	 0.000	 0.000	 0.000	 0.000	 0.000	 4.000	 4.000
+ 0.000	 0.000	 0.000	 0.000	 0.000	 0.000	 4.000	 4.000
+Non-zero tiles on each process: 2 0 0 2
+Put to a non-zero tile: 0, put to a zero tile: 0, put to a full tile pool: 16 (GTM_TILE_POOL_FULL)
+Rows 0 and 1 after put:
+ 5.000	 5.000	 0.000	 0.000	 7.000	 7.000	 0.000	 0.000
+ 5.000	 5.000	 0.000	 0.000	 7.000	 7.000	 0.000	 0.000
+Used tile pool slots on each process: 2 1 0 2
+*/
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    int r_displs[3] = {0, 4, 8};
+    int c_displs[3] = {0, 4, 8};
+    double mat[64];
+
+    int my_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+    GTM_Blk_Sparse_t gtbs;
+
+    // 2 * 2 proc grid, matrix size 8 * 8, 2 * 2 tiles, 2 tiles per process
+    GTM_createBlkSparse(
+        &gtbs, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, 8, 8,
+        2, 2, &r_displs[0], &c_displs[0], 2, 2
+    );
+
+    // Each process accumulates a block diagonal matrix, all-zero
+    // tiles are skipped and never allocated on target process
+    for (int i = 0; i < 64; i++) mat[i] = 0.0;
+    for (int i = 0; i < 8; i++)
+        for (int j = 0; j < 8; j++)
+            if (i / 2 == j / 2) mat[i * 8 + j] = 1.0;
+    int ret = GTM_accBlkSparseBlock(gtbs, 0, 8, 0, 8, &mat[0], 8);
+    if (ret != GTM_SUCCESS) printf("Rank %d accumulate failed, ret = %d\n", my_rank, ret);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    int nnz_tiles = GTM_getBlkSparseLocalNnzTiles(gtbs);
+    int all_nnz_tiles[4];
+    MPI_Gather(&nnz_tiles, 1, MPI_INT, &all_nnz_tiles[0], 1, MPI_INT, ACTOR_RANK, MPI_COMM_WORLD);
+
+    if (my_rank == ACTOR_RANK)
+    {
+        for (int i = 0; i < 64; i++) mat[i] = -1.0;
+        GTM_getBlkSparseBlock(gtbs, 0, 8, 0, 8, &mat[0], 8);
+        print_double_mat(&mat[0], 8, 8, 8, "Updated matrix (only diagonal tiles are non-zero)");
+        printf("Non-zero tiles on each process: ");
+        for (int i = 0; i < 4; i++) printf("%d ", all_nnz_tiles[i]);
+        printf("\n");
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    // Put replaces a non-zero tile and allocates a slot for a zero tile. Process 0
+    // has no free slot, its zero tile stays zero and its slot counter stays at 2.
+    if (my_rank == ACTOR_RANK)
+    {
+        double tile[4];
+        for (int i = 0; i < 4; i++) tile[i] = 5.0;
+        int ret0 = GTM_putBlkSparseBlock(gtbs, 0, 2, 0, 2, &tile[0], 2);
+        for (int i = 0; i < 4; i++) tile[i] = 7.0;
+        int ret1 = GTM_putBlkSparseBlock(gtbs, 0, 2, 4, 2, &tile[0], 2);
+        for (int i = 0; i < 4; i++) tile[i] = 6.0;
+        int ret2 = GTM_putBlkSparseBlock(gtbs, 0, 2, 2, 2, &tile[0], 2);
+        ret2 = GTM_putBlkSparseBlock(gtbs, 2, 2, 0, 2, &tile[0], 2);
+        printf(
+            "Put to a non-zero tile: %d, put to a zero tile: %d, put to a full tile pool: %d%s\n",
+            ret0, ret1, ret2, (ret2 == GTM_TILE_POOL_FULL) ? " (GTM_TILE_POOL_FULL)" : ""
+        );
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    int used_slots = gtbs->tile_map[0];
+    int all_used_slots[4];
+    MPI_Gather(&used_slots, 1, MPI_INT, &all_used_slots[0], 1, MPI_INT, ACTOR_RANK, MPI_COMM_WORLD);
+    if (my_rank == ACTOR_RANK)
+    {
+        GTM_getBlkSparseBlock(gtbs, 0, 2, 0, 8, &mat[0], 8);
+        print_double_mat(&mat[0], 8, 2, 8, "Rows 0 and 1 after put");
+        printf("Used tile pool slots on each process: ");
+        for (int i = 0; i < 4; i++) printf("%d ", all_used_slots[i]);
+        printf("\n");
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    GTM_destroyBlkSparse(gtbs);
+
+    MPI_Finalize();
+}
@@ -0,0 +1,66 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 0
+#define N          64
+
+/*
+Run with: mpirun -np 4 ./test_buffer.x
+Correct output:
+freed buffer reused by the same size class: yes
+accumulate from pooled buffers: 0 error(s)
+*/
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    int my_rank, comm_size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
+
+    // A freed buffer is cached and returned for the next allocation of the same size class
+    void *buf0 = GTM_allocBuffer(1000);
+    GTM_freeBuffer(buf0);
+    void *buf1 = GTM_allocBuffer(1500);
+    if (my_rank == ACTOR_RANK) printf("freed buffer reused by the same size class: %s\n", (buf0 == buf1) ? "yes" : "no");
+    GTM_freeBuffer(buf1);
+
+    int r_displs[3] = {0, 30, N}, c_displs[3] = {0, 33, N};
+    GTMatrix_t gtm;
+    GTM_create(&gtm, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, N, N, 2, 2, &r_displs[0], &c_displs[0]);
+    double zero = 0.0;
+    GTM_fill(gtm, &zero);
+    GTM_sync(gtm);
+
+    // Each process accumulates rows [i0, i0 + 8) of a matrix with value (rank + 1) * (i * N + j)
+    double *src = (double*) GTM_allocBuffer(sizeof(double) * N * N);
+    for (int i = 0; i < N; i++)
+        for (int j = 0; j < N; j++)
+            src[i * N + j] = (double) ((my_rank + 1) * (i * N + j));
+    for (int i0 = 0; i0 < N; i0 += 8)
+        GTM_accBlock(gtm, i0, 8, 0, N, src + i0 * N, N);
+    GTM_freeBuffer(src);
+    GTM_sync(gtm);
+
+    if (my_rank == ACTOR_RANK)
+    {
+        double *rcv = (double*) GTM_allocBuffer(sizeof(double) * N * N);
+        int n_error = 0;
+        GTM_getBlock(gtm, 0, N, 0, N, rcv, N);
+        double scale = (double) (comm_size * (comm_size + 1) / 2);
+        for (int i = 0; i < N * N; i++)
+            if (rcv[i] != scale * (double) i) n_error++;
+        printf("accumulate from pooled buffers: %d error(s)\n", n_error);
+        GTM_freeBuffer(rcv);
+    }
+    GTM_sync(gtm);
+
+    GTM_destroy(gtm);
+    MPI_Finalize();
+}
@@ -0,0 +1,201 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <complex.h>
+#include <mpi.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 0
+#define N          10
+
+/*
+Run with: mpirun -np 4 ./test_col_major.x
+Correct output:
+reference checksum = 26609.000
+storage 0x00, column-major buffers: max |diff| = 0.000, fetch matches get = 1
+storage 0x10, row-major buffers   : max |diff| = 0.000, fetch matches get = 1
+storage 0x10, column-major buffers: max |diff| = 0.000, fetch matches get = 1
+storage 0x18, column-major buffers: max |diff| = 0.000, fetch matches get = 1
+double _Complex, symmetric and column-major storage, column-major buffers: max |diff| = 0.000
+*/
+
+// Sub-block of the logical source matrix starting at (r, c) in the buffer layout
+#define SRC(r, c) (col_major_buf ? &src[(c) * N + (r)] : &src[(r) * N + (c)])
+
+static int create_mat(GTMatrix_t *gtm, MPI_Datatype dt, int unit_size, int my_rank, int storage_flags)
+{
+    int displs[3] = {0, 5, N};
+    return GTM_createEx(
+        gtm, MPI_COMM_WORLD, dt, unit_size, my_rank, N, N,
+        2, 2, &displs[0], &displs[0], storage_flags
+    );
+}
+
+// Apply the same sequence of operations to a double matrix with the given
+// user buffer layout, return the whole matrix in row-major layout
+static void run_ops(GTMatrix_t gtm, int my_rank, int col_major_buf, double *mat, int *fetch_ok)
+{
+    double zero = 0.0, half = 0.5, src[N * N], buf[N * N], fetch[N * N];
+
+    GTM_setBufferLayout(gtm, col_major_buf ? GTM_BUF_COL_MAJOR : GTM_BUF_ROW_MAJOR);
+    for (int i = 0; i < N; i++)
+        for (int j = 0; j < N; j++)
+            *SRC(i, j) = (double) (i * N + j + my_rank);
+    GTM_fill(gtm, &zero);
+    GTM_sync(gtm);
+
+    if (my_rank == ACTOR_RANK) GTM_putBlock(gtm, 0, N, 0, N, SRC(0, 0), N);
+    GTM_sync(gtm);
+
+    // Remote and shared memory accumulation, scaled, batched and symmetric
+    GTM_accBlockNB(gtm, 1, 7, 2, 8, SRC(0, 0), N);
+    GTM_waitNB(gtm);
+    GTM_accBlockScaled(gtm, 3, 6, 0, N, SRC(2, 0), N, &half);
+    GTM_startBatchAcc(gtm);
+    GTM_addAccBlockRequest(gtm, 0, 4, 4, 4, SRC(1, 1), N);
+    GTM_addAccBlockScaledRequest(gtm, 6, 3, 1, 9, SRC(0, 0), N, &half);
+    GTM_execBatchAcc(gtm);
+    GTM_stopBatchAcc(gtm);
+    GTM_accBlockSym(gtm, 0, 3, 5, 4, SRC(1, 2), N);
+    GTM_accBlockSym(gtm, 6, 2, 6, 2, SRC(3, 3), N);
+    GTM_fetchAccBlock(gtm, 2, 5, 3, 6, SRC(0, 0), N, MPI_SUM, &fetch[0], N);
+    GTM_sync(gtm);
+
+    // Operations with shared memory kernels, batched and blocking
+    GTM_startBatchAcc(gtm);
+    GTM_addUpdateBlockOpRequest(gtm, 6, 3, 1, 9, SRC(0, 0), N, MPI_MAX);
+    GTM_execBatchAcc(gtm);
+    GTM_stopBatchAcc(gtm);
+    GTM_sync(gtm);
+    GTM_updateBlockOp(gtm, 2, 3, 2, 3, SRC(4, 4), N, MPI_MIN);
+    GTM_sync(gtm);
+
+    // Batched get of two halves, then read the matrix with fetch-and-accumulate
+    if (my_rank == ACTOR_RANK)
+    {
+        double *right = col_major_buf ? &buf[5 * N] : &buf[5];
+        GTM_startBatchGet(gtm);
+        GTM_addGetBlockRequest(gtm, 0, N, 0, 5, &buf[0], N);
+        GTM_addGetBlockRequest(gtm, 0, N, 5, 5, right, N);
+        GTM_execBatchGet(gtm);
+        GTM_stopBatchGet(gtm);
+        GTM_fetchAccBlock(gtm, 0, N, 0, N, NULL, N, MPI_NO_OP, &fetch[0], N);
+        *fetch_ok = 1;
+        for (int i = 0; i < N * N; i++)
+            if (fetch[i] != buf[i]) *fetch_ok = 0;
+        for (int i = 0; i < N; i++)
+            for (int j = 0; j < N; j++)
+                mat[i * N + j] = col_major_buf ? buf[j * N + i] : buf[i * N + j];
+    }
+    GTM_sync(gtm);
+}
+
+static double max_diff(double *a, double *b)
+{
+    double res = 0.0;
+    for (int i = 0; i < N * N; i++)
+    {
+        double diff = a[i] - b[i];
+        if (diff < 0.0) diff = -diff;
+        if (diff > res) res = diff;
+    }
+    return res;
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    // 4 * 4 tiles for GTM_STORAGE_TILED
+    setenv("GTM_TILE_SIZE", "4", 1);
+
+    int my_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+    // Reference: row-major storage and row-major buffers
+    GTMatrix_t gtm;
+    double ref[N * N], mat[N * N];
+    int fetch_ok;
+    create_mat(&gtm, MPI_DOUBLE, 8, my_rank, GTM_STORAGE_DEFAULT);
+    run_ops(gtm, my_rank, 0, &ref[0], &fetch_ok);
+    GTM_destroy(gtm);
+    if (my_rank == ACTOR_RANK)
+    {
+        double checksum = 0.0;
+        for (int i = 0; i < N * N; i++) checksum += ref[i];
+        printf("reference checksum = %.3lf\n", checksum);
+    }
+
+    int storage_flags[4] = {
+        GTM_STORAGE_DEFAULT, GTM_STORAGE_COLMAJOR, GTM_STORAGE_COLMAJOR,
+        GTM_STORAGE_COLMAJOR | GTM_STORAGE_TILED
+    };
+    int col_major_bufs[4] = {1, 0, 1, 1};
+    for (int k = 0; k < 4; k++)
+    {
+        create_mat(&gtm, MPI_DOUBLE, 8, my_rank, storage_flags[k]);
+        run_ops(gtm, my_rank, col_major_bufs[k], &mat[0], &fetch_ok);
+        GTM_destroy(gtm);
+        if (my_rank == ACTOR_RANK)
+        {
+            printf(
+                "storage 0x%02x, %s buffers%s: max |diff| = %.3lf, fetch matches get = %d\n",
+                storage_flags[k], col_major_bufs[k] ? "column-major" : "row-major",
+                col_major_bufs[k] ? "" : "   ", max_diff(&ref[0], &mat[0]), fetch_ok
+            );
+        }
+    }
+
+    // double _Complex with symmetric storage: lower triangle gets are conjugated
+    // and transposed, put a Hermitian matrix and compare both buffer layouts
+    GTMatrix_t gtm_r, gtm_c;
+    double _Complex h[N * N], h_cm[N * N], get_r[N * N], get_c[N * N];
+    for (int i = 0; i < N; i++)
+    {
+        for (int j = 0; j < N; j++)
+        {
+            h[i * N + j] = (double) (i + j) + (double) (j - i) * I;
+            h_cm[j * N + i] = h[i * N + j];
+        }
+    }
+    create_mat(&gtm_r, MPI_C_DOUBLE_COMPLEX, 16, my_rank, GTM_STORAGE_SYMM);
+    create_mat(&gtm_c, MPI_C_DOUBLE_COMPLEX, 16, my_rank, GTM_STORAGE_SYMM | GTM_STORAGE_COLMAJOR);
+    GTM_setBufferLayout(gtm_c, GTM_BUF_COL_MAJOR);
+    if (my_rank == ACTOR_RANK)
+    {
+        GTM_putBlock(gtm_r, 0, N, 0, N, &h[0], N);
+        GTM_putBlock(gtm_c, 0, N, 0, N, &h_cm[0], N);
+    }
+    GTM_sync(gtm_r);
+    GTM_sync(gtm_c);
+    GTM_accBlockSym(gtm_r, 1, 6, 2, 7, &h[0], N);
+    GTM_accBlockSym(gtm_c, 1, 6, 2, 7, &h_cm[0], N);
+    GTM_sync(gtm_r);
+    GTM_sync(gtm_c);
+    if (my_rank == ACTOR_RANK)
+    {
+        double diff = 0.0;
+        GTM_getBlock(gtm_r, 0, N, 0, N, &get_r[0], N);
+        GTM_getBlock(gtm_c, 0, N, 0, N, &get_c[0], N);
+        for (int i = 0; i < N; i++)
+        {
+            for (int j = 0; j < N; j++)
+            {
+                double _Complex d = get_r[i * N + j] - get_c[j * N + i];
+                double d_re = creal(d) < 0.0 ? -creal(d) : creal(d);
+                double d_im = cimag(d) < 0.0 ? -cimag(d) : cimag(d);
+                if (d_re > diff) diff = d_re;
+                if (d_im > diff) diff = d_im;
+            }
+        }
+        printf("double _Complex, symmetric and column-major storage, column-major buffers: max |diff| = %.3lf\n", diff);
+    }
+    GTM_sync(gtm_r);
+    GTM_sync(gtm_c);
+    GTM_destroy(gtm_r);
+    GTM_destroy(gtm_c);
+
+    MPI_Finalize();
+}
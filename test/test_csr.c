@@ -0,0 +1,155 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 0
+#define NROWS      20
+#define NCOLS      16
+#define K          3
+
+/*
+Run with: mpirun -np 4 ./test_csr.x
+Correct output:
+total nnz = 40
+rows [3, 15): 24 non-zeros, 0 error(s)
+SpMM: 0 error(s)
+SpMV: 0 error(s)
+*/
+
+// Entries accumulated by process rank, the expected matrix is the sum over all ranks
+static int make_entries(int rank, int *rows, int *cols, double *vals)
+{
+    int n = 0;
+    for (int i = 0; i < NROWS; i++)
+    {
+        rows[n] = i;
+        cols[n] = i % NCOLS;
+        vals[n] = 1.0;
+        n++;
+        if (i % 4 != rank) continue;
+        // Added twice, combined in the staging hash table
+        for (int t = 0; t < 2; t++)
+        {
+            rows[n] = i;
+            cols[n] = (3 * i + 1) % NCOLS;
+            vals[n] = (double) (i + 1);
+            n++;
+        }
+    }
+    return n;
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    int my_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+    int r_displs[3] = {0, 7, NROWS}, c_displs[3] = {0, 9, NCOLS}, k_displs[3] = {0, 1, K};
+    GTM_CSR_t csr;
+    GTM_createCSR(&csr, MPI_COMM_WORLD, my_rank, NROWS, NCOLS, 2, 2, &r_displs[0], &c_displs[0]);
+
+    int rows[3 * NROWS], cols[3 * NROWS];
+    double vals[3 * NROWS], dense[NROWS * NCOLS];
+    memset(dense, 0, sizeof(dense));
+    for (int r = 0; r < 4; r++)
+    {
+        int n = make_entries(r, &rows[0], &cols[0], &vals[0]);
+        for (int i = 0; i < n; i++) dense[rows[i] * NCOLS + cols[i]] += vals[i];
+    }
+    int n = make_entries(my_rank, &rows[0], &cols[0], &vals[0]);
+    GTM_addCSRAccEntries(csr, n, &rows[0], &cols[0], &vals[0]);
+    GTM_syncCSR(csr);
+
+    int total_nnz;
+    MPI_Reduce(&csr->nnz, &total_nnz, 1, MPI_INT, MPI_SUM, ACTOR_RANK, MPI_COMM_WORLD);
+    if (my_rank == ACTOR_RANK)
+    {
+        printf("total nnz = %d\n", total_nnz);
+
+        // Row range across both row blocks
+        int row_ptr[13], col_idx[3 * 12], n_error = 0;
+        double val[3 * 12], got[12 * NCOLS];
+        GTM_getCSRRows(csr, 3, 12, 3 * 12, &row_ptr[0], &col_idx[0], &val[0]);
+        memset(got, 0, sizeof(got));
+        for (int i = 0; i < 12; i++)
+        {
+            for (int j = row_ptr[i]; j < row_ptr[i + 1]; j++)
+            {
+                got[i * NCOLS + col_idx[j]] = val[j];
+                if ((j > row_ptr[i]) && (col_idx[j] <= col_idx[j - 1])) n_error++;
+            }
+        }
+        for (int i = 0; i < 12 * NCOLS; i++)
+            if (got[i] != dense[3 * NCOLS + i]) n_error++;
+        printf("rows [3, 15): %d non-zeros, %d error(s)\n", row_ptr[12], n_error);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    // x(j, l) = j + l + 1, Y = 2 * A * X
+    GTMatrix_t X, Y;
+    double zero = 0.0, xbuf[NCOLS * K], ybuf[NROWS * K];
+    GTM_createEx(&X, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, NCOLS, K, 2, 2, &c_displs[0], &k_displs[0], GTM_STORAGE_DEFAULT);
+    GTM_createEx(&Y, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, NROWS, K, 2, 2, &r_displs[0], &k_displs[0], GTM_STORAGE_DEFAULT);
+    for (int j = 0; j < NCOLS; j++)
+        for (int l = 0; l < K; l++)
+            xbuf[j * K + l] = (double) (j + l + 1);
+    if (my_rank == ACTOR_RANK) GTM_putBlock(X, 0, NCOLS, 0, K, &xbuf[0], K);
+    GTM_fill(Y, &zero);
+    GTM_sync(X);
+    GTM_sync(Y);
+    GTM_CSRSpMM(csr, 2.0, X, Y);
+    if (my_rank == ACTOR_RANK)
+    {
+        int n_error = 0;
+        GTM_getBlock(Y, 0, NROWS, 0, K, &ybuf[0], K);
+        for (int i = 0; i < NROWS; i++)
+        {
+            for (int l = 0; l < K; l++)
+            {
+                double y = 0.0;
+                for (int j = 0; j < NCOLS; j++) y += 2.0 * dense[i * NCOLS + j] * xbuf[j * K + l];
+                if (y != ybuf[i * K + l]) n_error++;
+            }
+        }
+        printf("SpMM: %d error(s)\n", n_error);
+    }
+    GTM_sync(Y);
+    GTM_destroy(X);
+    GTM_destroy(Y);
+
+    // x(j) = j + 1, y = A * x
+    int one_displs[2] = {0, 1}, r_displs4[5] = {0, 5, 10, 15, NROWS}, c_displs4[5] = {0, 4, 8, 12, NCOLS};
+    GTMatrix_t x, y;
+    GTM_createEx(&x, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, NCOLS, 1, 4, 1, &c_displs4[0], &one_displs[0], GTM_STORAGE_DEFAULT);
+    GTM_createEx(&y, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, NROWS, 1, 4, 1, &r_displs4[0], &one_displs[0], GTM_STORAGE_DEFAULT);
+    for (int j = 0; j < NCOLS; j++) xbuf[j] = (double) (j + 1);
+    if (my_rank == ACTOR_RANK) GTM_putBlock(x, 0, NCOLS, 0, 1, &xbuf[0], 1);
+    GTM_fill(y, &zero);
+    GTM_sync(x);
+    GTM_sync(y);
+    GTM_CSRSpMV(csr, 1.0, x, y);
+    if (my_rank == ACTOR_RANK)
+    {
+        int n_error = 0;
+        GTM_getBlock(y, 0, NROWS, 0, 1, &ybuf[0], 1);
+        for (int i = 0; i < NROWS; i++)
+        {
+            double yi = 0.0;
+            for (int j = 0; j < NCOLS; j++) yi += dense[i * NCOLS + j] * xbuf[j];
+            if (yi != ybuf[i]) n_error++;
+        }
+        printf("SpMV: %d error(s)\n", n_error);
+    }
+    GTM_sync(y);
+    GTM_destroy(x);
+    GTM_destroy(y);
+
+    GTM_destroyCSR(csr);
+    MPI_Finalize();
+}
@@ -0,0 +1,90 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 0
+#define N          12
+
+/*
+Run with: mpirun -np 4 ./test_halo.x
+Correct output:
+2 * 2 grid, storage 0x00: 324 padded elements, 0 error(s)
+2 * 2 grid, storage 0x18: 324 padded elements, 0 error(s)
+1 * 4 grid, storage 0x00: 360 padded elements, 0 error(s)
+*/
+
+// Halo widths: 1 row above, 2 rows below, 2 columns on the left, 1 column on the right
+static void check_halo(int my_rank, int c_blocks, int *r_displs, int *c_displs, int storage_flags)
+{
+    int r_blocks = 4 / c_blocks;
+    GTMatrix_t gtm;
+    GTM_Halo_t halo;
+    GTM_createEx(
+        &gtm, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, N, N,
+        r_blocks, c_blocks, r_displs, c_displs, storage_flags
+    );
+    GTM_createHalo(&halo, gtm, 1, 2, 2, 1);
+
+    // A(i, j) = 100 * i + j + 1, halo elements outside the matrix are 0
+    if (my_rank == ACTOR_RANK)
+    {
+        double mat[N * N];
+        for (int i = 0; i < N; i++)
+            for (int j = 0; j < N; j++)
+                mat[i * N + j] = (double) (100 * i + j + 1);
+        GTM_putBlock(gtm, 0, N, 0, N, &mat[0], N);
+    }
+    GTM_sync(gtm);
+    GTM_updateHalo(halo);
+
+    int n_checked = 0, n_error = 0;
+    int row_s = gtm->r_displs[gtm->my_rowblk];
+    int col_s = gtm->c_displs[gtm->my_colblk];
+    double *local = (double*) halo->local_ptr;
+    for (int i = -halo->h_top; i < gtm->my_nrows + halo->h_bottom; i++)
+    {
+        for (int j = -halo->h_left; j < gtm->my_ncols + halo->h_right; j++)
+        {
+            int gi = row_s + i, gj = col_s + j;
+            double expected = 0.0;
+            if ((gi >= 0) && (gi < N) && (gj >= 0) && (gj < N)) expected = (double) (100 * gi + gj + 1);
+            if (local[i * halo->ld + j] != expected) n_error++;
+            n_checked++;
+        }
+    }
+    int cnt[2] = {n_checked, n_error}, total[2];
+    MPI_Reduce(&cnt[0], &total[0], 2, MPI_INT, MPI_SUM, ACTOR_RANK, MPI_COMM_WORLD);
+    if (my_rank == ACTOR_RANK)
+    {
+        printf(
+            "%d * %d grid, storage 0x%02x: %d padded elements, %d error(s)\n",
+            r_blocks, c_blocks, storage_flags, total[0], total[1]
+        );
+    }
+
+    GTM_destroyHalo(halo);
+    GTM_destroy(gtm);
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    // 4 * 4 tiles for GTM_STORAGE_TILED
+    setenv("GTM_TILE_SIZE", "4", 1);
+
+    int my_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+    int r_displs2[3] = {0, 5, N}, c_displs2[3] = {0, 7, N};
+    int r_displs1[2] = {0, N},    c_displs4[5] = {0, 3, 6, 9, N};
+    check_halo(my_rank, 2, &r_displs2[0], &c_displs2[0], GTM_STORAGE_DEFAULT);
+    check_halo(my_rank, 2, &r_displs2[0], &c_displs2[0], GTM_STORAGE_TILED | GTM_STORAGE_COLMAJOR);
+    check_halo(my_rank, 4, &r_displs1[0], &c_displs4[0], GTM_STORAGE_DEFAULT);
+
+    MPI_Finalize();
+}
@@ -0,0 +1,143 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 0
+#define NITER      100
+#define NBENCH     2000
+
+/*
+Run with: mpirun -np 4 ./test_mutex.x
+Correct output (timings vary):
+counter protected by mutex = 400
+counters protected by two mutexes = 200 400
+trylock on a locked mutex failed on 3 process(es)
+lock + unlock latency, uncontended, local mutex  : ... us
+lock + unlock latency, uncontended, remote mutex : ... us
+lock + unlock latency, 4 processes contending    : ... us per critical section
+*/
+
+// Average time of NBENCH lock + unlock pairs on mutex_id, max over all processes
+static double bench_mutex(GTM_Mutex_t mutex, int mutex_id)
+{
+    double st, et, ut, max_ut;
+    MPI_Barrier(MPI_COMM_WORLD);
+    st = MPI_Wtime();
+    for (int i = 0; i < NBENCH; i++)
+    {
+        GTM_lockMutex(mutex, mutex_id);
+        GTM_unlockMutex(mutex, mutex_id);
+    }
+    et = MPI_Wtime();
+    ut = (et - st) * 1e6 / (double) NBENCH;
+    MPI_Reduce(&ut, &max_ut, 1, MPI_DOUBLE, MPI_MAX, ACTOR_RANK, MPI_COMM_WORLD);
+    return max_ut;
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    int displs[3] = {0, 2, 4};
+    int my_rank, nprocs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+    GTMatrix_t gtm;
+    int zero = 0;
+    GTM_create(&gtm, MPI_COMM_WORLD, MPI_INT, 4, my_rank, 4, 4, 2, 2, &displs[0], &displs[0]);
+    GTM_fill(gtm, &zero);
+    GTM_sync(gtm);
+
+    // One mutex hosted by each process
+    GTM_Mutex_t mutex;
+    GTM_createMutex(&mutex, MPI_COMM_WORLD, nprocs);
+
+    // Critical section: get, increase and put a matrix element
+    for (int i = 0; i < NITER; i++)
+    {
+        int counter;
+        GTM_lockMutex(mutex, 0);
+        GTM_getBlock(gtm, 3, 1, 3, 1, &counter, 1);
+        counter++;
+        GTM_putBlock(gtm, 3, 1, 3, 1, &counter, 1);
+        GTM_unlockMutex(mutex, 0);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (my_rank == ACTOR_RANK)
+    {
+        int counter;
+        GTM_getBlock(gtm, 3, 1, 3, 1, &counter, 1);
+        printf("counter protected by mutex = %d\n", counter);
+    }
+
+    // Even processes hold mutex 0 and mutex 1 (hosted by different processes) at 
+    // the same time, odd processes contend for mutex 1 only
+    for (int i = 0; i < NITER; i++)
+    {
+        int counter0, counter1;
+        if (my_rank % 2 == 0)
+        {
+            GTM_lockMutex(mutex, 0);
+            GTM_getBlock(gtm, 0, 1, 0, 1, &counter0, 1);
+            counter0++;
+            GTM_putBlock(gtm, 0, 1, 0, 1, &counter0, 1);
+        }
+        GTM_lockMutex(mutex, 1);
+        GTM_getBlock(gtm, 0, 1, 3, 1, &counter1, 1);
+        counter1++;
+        GTM_putBlock(gtm, 0, 1, 3, 1, &counter1, 1);
+        GTM_unlockMutex(mutex, 1);
+        if (my_rank % 2 == 0) GTM_unlockMutex(mutex, 0);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (my_rank == ACTOR_RANK)
+    {
+        int counter0, counter1;
+        GTM_getBlock(gtm, 0, 1, 0, 1, &counter0, 1);
+        GTM_getBlock(gtm, 0, 1, 3, 1, &counter1, 1);
+        printf("counters protected by two mutexes = %d %d\n", counter0, counter1);
+    }
+
+    // trylock while the actor holds the mutex
+    int locked = 0, n_failed, failed = 0;
+    if (my_rank == ACTOR_RANK) GTM_lockMutex(mutex, 1);
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (my_rank != ACTOR_RANK)
+    {
+        GTM_trylockMutex(mutex, 1, &locked);
+        if (locked == 0) failed = 1;
+    }
+    MPI_Reduce(&failed, &n_failed, 1, MPI_INT, MPI_SUM, ACTOR_RANK, MPI_COMM_WORLD);
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (my_rank == ACTOR_RANK)
+    {
+        GTM_unlockMutex(mutex, 1);
+        printf("trylock on a locked mutex failed on %d process(es)\n", n_failed);
+    }
+
+    // Latency and contention benchmarks
+    double t_local   = bench_mutex(mutex, my_rank);
+    double t_remote  = bench_mutex(mutex, (my_rank + 1) % nprocs);
+    double t_contend = bench_mutex(mutex, 0);
+    if (my_rank == ACTOR_RANK)
+    {
+        printf("lock + unlock latency, uncontended, local mutex  : %.2lf us\n", t_local);
+        printf("lock + unlock latency, uncontended, remote mutex : %.2lf us\n", t_remote);
+        printf(
+            "lock + unlock latency, %d processes contending    : %.2lf us per critical section\n",
+            nprocs, t_contend / (double) nprocs
+        );
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    GTM_destroyMutex(mutex);
+    GTM_sync(gtm);
+    GTM_destroy(gtm);
+
+    MPI_Finalize();
+}
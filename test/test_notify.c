@@ -0,0 +1,86 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 0
+#define NITER      20
+
+/*
+Run with: mpirun -np 4 ./test_notify.x
+Correct output:
+Rank 3 received block from rank 0, sum = 160
+Ring accumulation: 4 process(es) see 20 updates
+Put spanning all blocks: 4 process(es) see the new value
+*/
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    int displs[3] = {0, 4, 8};
+    int my_rank, nprocs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+    GTMatrix_t gtm;
+    int zero = 0, buf[64], blk[16], ok, n_ok;
+    GTM_create(&gtm, MPI_COMM_WORLD, MPI_INT, 4, my_rank, 8, 8, 2, 2, &displs[0], &displs[0]);
+    GTM_fill(gtm, &zero);
+    GTM_sync(gtm);
+
+    // Producer / consumer: rank 0 puts the block of rank 3, only rank 3 waits
+    if (my_rank == 0)
+    {
+        for (int i = 0; i < 16; i++) blk[i] = 10;
+        GTM_putBlockNotify(gtm, 4, 4, 4, 4, &blk[0], 4);
+    }
+    if (my_rank == 3)
+    {
+        int sum = 0;
+        GTM_waitNotify(gtm, 1);
+        GTM_getBlock(gtm, 4, 4, 4, 4, &blk[0], 4);
+        for (int i = 0; i < 16; i++) sum += blk[i];
+        printf("Rank 3 received block from rank 0, sum = %d\n", sum);
+    }
+    GTM_sync(gtm);
+    GTM_fill(gtm, &zero);
+    GTM_sync(gtm);
+
+    // Ring: each rank accumulates to the block of the next rank
+    int next = (my_rank + 1) % nprocs;
+    int r0 = (next / 2) * 4, c0 = (next % 2) * 4;
+    for (int i = 0; i < 16; i++) blk[i] = 1;
+    for (int i = 0; i < NITER; i++)
+        GTM_accBlockNotify(gtm, r0, 4, c0, 4, &blk[0], 4);
+    GTM_waitNotify(gtm, NITER);
+    int my_r0 = (my_rank / 2) * 4, my_c0 = (my_rank % 2) * 4;
+    GTM_getBlock(gtm, my_r0, 4, my_c0, 4, &blk[0], 4);
+    ok = 1;
+    for (int i = 0; i < 16; i++) if (blk[i] != NITER) ok = 0;
+    MPI_Reduce(&ok, &n_ok, 1, MPI_INT, MPI_SUM, ACTOR_RANK, MPI_COMM_WORLD);
+    if (my_rank == ACTOR_RANK)
+        printf("Ring accumulation: %d process(es) see %d updates\n", n_ok, NITER);
+    GTM_sync(gtm);
+
+    // A put spanning all process blocks notifies each process once
+    if (my_rank == 1)
+    {
+        for (int i = 0; i < 64; i++) buf[i] = 7;
+        GTM_putBlockNotify(gtm, 0, 8, 0, 8, &buf[0], 8);
+    }
+    GTM_waitNotify(gtm, 1);
+    GTM_getBlock(gtm, my_r0, 4, my_c0, 4, &blk[0], 4);
+    ok = 1;
+    for (int i = 0; i < 16; i++) if (blk[i] != 7) ok = 0;
+    MPI_Reduce(&ok, &n_ok, 1, MPI_INT, MPI_SUM, ACTOR_RANK, MPI_COMM_WORLD);
+    if (my_rank == ACTOR_RANK)
+        printf("Put spanning all blocks: %d process(es) see the new value\n", n_ok);
+    GTM_sync(gtm);
+    GTM_destroy(gtm);
+
+    MPI_Finalize();
+}
@@ -0,0 +1,113 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 0
+#define N          12
+
+/*
+Run with: mpirun -np 4 ./test_panel.x
+Correct output:
+storage 0x00: broadcast 0 error(s), reduce 0 error(s)
+storage 0x18: broadcast 0 error(s), reduce 0 error(s)
+*/
+
+static double init_val(int i, int j) { return (double) (100 * i + j + 1); }
+
+static void check_panel(int my_rank, int storage_flags)
+{
+    int displs[3] = {0, 5, N};
+    GTMatrix_t gtm;
+    GTM_createEx(
+        &gtm, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, N, N,
+        2, 2, &displs[0], &displs[0], storage_flags
+    );
+    if (storage_flags & GTM_STORAGE_COLMAJOR) GTM_setBufferLayout(gtm, GTM_BUF_COL_MAJOR);
+
+    if (my_rank == ACTOR_RANK)
+    {
+        double mat[N * N];
+        for (int i = 0; i < N; i++)
+            for (int j = 0; j < N; j++)
+                mat[GTM_BUF_OFFSET(gtm, N, i, j)] = init_val(i, j);
+        GTM_putBlock(gtm, 0, N, 0, N, &mat[0], N);
+    }
+    GTM_sync(gtm);
+
+    // Broadcast columns [6, 9) in each process row and rows [1, 4) in each process column
+    int row_s = gtm->r_displs[gtm->my_rowblk];
+    int col_s = gtm->c_displs[gtm->my_colblk];
+    int n_bcast_err = 0;
+    double col_panel[N * 3], row_panel[3 * N];
+    int col_ld = gtm->col_major_buf ? gtm->my_nrows : 3;
+    int row_ld = gtm->col_major_buf ? 3 : gtm->my_ncols;
+    GTM_bcastColPanel(gtm, 6, 3, &col_panel[0], col_ld);
+    GTM_bcastRowPanel(gtm, 1, 3, &row_panel[0], row_ld);
+    for (int i = 0; i < gtm->my_nrows; i++)
+        for (int j = 0; j < 3; j++)
+            if (col_panel[GTM_BUF_OFFSET(gtm, col_ld, i, j)] != init_val(row_s + i, 6 + j)) n_bcast_err++;
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < gtm->my_ncols; j++)
+            if (row_panel[GTM_BUF_OFFSET(gtm, row_ld, i, j)] != init_val(1 + i, col_s + j)) n_bcast_err++;
+
+    // Columns [0, 3) += sum of (rank + 1) in the process row,
+    // rows [6, 8) = max(A, max of 1000 * (rank + 1) in the process column)
+    for (int i = 0; i < N * 3; i++)
+    {
+        col_panel[i] = (double) (my_rank + 1);
+        row_panel[i] = (double) (1000 * (my_rank + 1));
+    }
+    GTM_reduceColPanel(gtm, 0, 3, &col_panel[0], col_ld, MPI_SUM);
+    GTM_reduceRowPanel(gtm, 6, 2, &row_panel[0], gtm->col_major_buf ? 2 : row_ld, MPI_MAX);
+    GTM_sync(gtm);
+
+    int n_reduce_err = 0;
+    if (my_rank == ACTOR_RANK)
+    {
+        double mat[N * N];
+        GTM_getBlock(gtm, 0, N, 0, N, &mat[0], N);
+        for (int i = 0; i < N; i++)
+        {
+            for (int j = 0; j < N; j++)
+            {
+                double expected = init_val(i, j);
+                if (j < 3) expected += (i < 5) ? 3.0 : 7.0;
+                if ((i == 6) || (i == 7)) expected = (j < 5) ? 3000.0 : 4000.0;
+                if (mat[GTM_BUF_OFFSET(gtm, N, i, j)] != expected) n_reduce_err++;
+            }
+        }
+    }
+    GTM_sync(gtm);
+
+    int total_bcast_err;
+    MPI_Reduce(&n_bcast_err, &total_bcast_err, 1, MPI_INT, MPI_SUM, ACTOR_RANK, MPI_COMM_WORLD);
+    if (my_rank == ACTOR_RANK)
+    {
+        printf(
+            "storage 0x%02x: broadcast %d error(s), reduce %d error(s)\n",
+            storage_flags, total_bcast_err, n_reduce_err
+        );
+    }
+    GTM_destroy(gtm);
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    // 4 * 4 tiles for GTM_STORAGE_TILED, 4-element segments to pipeline panels
+    setenv("GTM_TILE_SIZE", "4", 1);
+    setenv("GTM_PANEL_SEG_SIZE", "32", 1);
+
+    int my_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+    check_panel(my_rank, GTM_STORAGE_DEFAULT);
+    check_panel(my_rank, GTM_STORAGE_TILED | GTM_STORAGE_COLMAJOR);
+
+    MPI_Finalize();
+}
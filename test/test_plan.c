@@ -0,0 +1,173 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 0
+#define N          10
+#define NITER      3
+
+/*
+Run with: mpirun -np 4 ./test_plan.x
+Correct output:
+accumulate plan: 11 request pieces, 9 transfers
+storage 0x00: checksum = 7473.000, max |plan - batch| = 0.000
+storage 0x08: checksum = 7473.000, max |plan - batch| = 0.000
+storage 0x10: checksum = 7429.000, max |plan - batch| = 0.000
+storage 0x12: checksum = 7429.000, max |plan - batch| = 0.000
+storage 0x01: checksum = 13995.000, max |plan - batch| = 0.000
+*/
+
+static int create_mat(GTMatrix_t *gtm, int my_rank, int storage_flags)
+{
+    int displs[3] = {0, 5, N};
+    return GTM_createEx(
+        gtm, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, N, N,
+        2, 2, &displs[0], &displs[0], storage_flags
+    );
+}
+
+// Queue the accumulation requests of one iteration
+static void add_acc_requests(GTMatrix_t gtm, double *src, double *half)
+{
+    // Pieces to the same target are coalesced unless they overlap or are scaled
+    GTM_addAccBlockRequest(gtm, 0, 7, 1, 8, src, N);
+    GTM_addAccBlockRequest(gtm, 8, 2, 0, 3, src, N);
+    GTM_addAccBlockRequest(gtm, 0, 2, 0, 1, src, N);
+    GTM_addAccBlockRequest(gtm, 5, 5, 5, 5, src, N);
+    GTM_addAccBlockScaledRequest(gtm, 2, 5, 0, N, src, N, half);
+}
+
+// Queue the get requests of one iteration
+static void add_get_requests(GTMatrix_t gtm, double *dst)
+{
+    GTM_addGetBlockRequest(gtm, 0, N, 0, 6, &dst[0], N);
+    GTM_addGetBlockRequest(gtm, 0, N, 6, 4, gtm->col_major_buf ? &dst[6 * N] : &dst[6], N);
+}
+
+// Run NITER iterations with persistent plans on gtm_p and with batched
+// requests on gtm_b, return the whole matrices after the last iteration
+static void run_iters(
+    GTMatrix_t gtm_p, GTMatrix_t gtm_b, int my_rank, int print_plan,
+    double *mat_p, double *mat_b
+)
+{
+    double zero = 0.0, half = 0.5, src[N * N];
+    GTM_Plan_t acc_plan, max_plan, get_plan;
+
+    GTM_fill(gtm_p, &zero);
+    GTM_fill(gtm_b, &zero);
+    GTM_sync(gtm_p);
+    GTM_sync(gtm_b);
+
+    // Record the plans once
+    GTM_startBatchAcc(gtm_p);
+    add_acc_requests(gtm_p, &src[0], &half);
+    GTM_createPlan(&acc_plan, gtm_p);
+    GTM_stopBatchAcc(gtm_p);
+    GTM_startBatchAcc(gtm_p);
+    GTM_addUpdateBlockOpRequest(gtm_p, 1, 8, 1, 8, &src[0], N, MPI_MAX);
+    GTM_createPlan(&max_plan, gtm_p);
+    GTM_stopBatchAcc(gtm_p);
+    GTM_startBatchGet(gtm_p);
+    add_get_requests(gtm_p, mat_p);
+    GTM_createPlan(&get_plan, gtm_p);
+    GTM_stopBatchGet(gtm_p);
+    if (print_plan && (my_rank == ACTOR_RANK))
+        printf("accumulate plan: %d request pieces, %d transfers\n", acc_plan->n_req, acc_plan->n_xfer);
+
+    for (int iter = 0; iter < NITER; iter++)
+    {
+        // Buffer contents change, buffer addresses do not
+        for (int i = 0; i < N * N; i++) src[i] = (double) (i % 7 + my_rank + iter);
+
+        GTM_executePlan(acc_plan);
+        GTM_startBatchAcc(gtm_b);
+        add_acc_requests(gtm_b, &src[0], &half);
+        GTM_execBatchAcc(gtm_b);
+        GTM_stopBatchAcc(gtm_b);
+        GTM_sync(gtm_p);
+        GTM_sync(gtm_b);
+
+        GTM_executePlan(max_plan);
+        GTM_updateBlockOp(gtm_b, 1, 8, 1, 8, &src[0], N, MPI_MAX);
+        GTM_sync(gtm_p);
+        GTM_sync(gtm_b);
+
+        // Versioned storage: make the updates visible to gets
+        if (gtm_p->versioned)
+        {
+            GTM_publish(gtm_p);
+            GTM_publish(gtm_b);
+            GTM_copyPublished(gtm_p);
+            GTM_copyPublished(gtm_b);
+        }
+    }
+
+    if (my_rank == ACTOR_RANK)
+    {
+        GTM_executePlan(get_plan);
+        GTM_startBatchGet(gtm_b);
+        add_get_requests(gtm_b, mat_b);
+        GTM_execBatchGet(gtm_b);
+        GTM_stopBatchGet(gtm_b);
+    }
+    GTM_sync(gtm_p);
+    GTM_sync(gtm_b);
+
+    GTM_destroyPlan(acc_plan);
+    GTM_destroyPlan(max_plan);
+    GTM_destroyPlan(get_plan);
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    // 4 * 4 tiles for GTM_STORAGE_TILED
+    setenv("GTM_TILE_SIZE", "4", 1);
+
+    int my_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+    int storage_flags[5] = {
+        GTM_STORAGE_DEFAULT, GTM_STORAGE_TILED, GTM_STORAGE_COLMAJOR,
+        GTM_STORAGE_COLMAJOR | GTM_STORAGE_VERSIONED, GTM_STORAGE_SYMM
+    };
+    for (int k = 0; k < 5; k++)
+    {
+        GTMatrix_t gtm_p, gtm_b;
+        double mat_p[N * N], mat_b[N * N];
+        create_mat(&gtm_p, my_rank, storage_flags[k]);
+        create_mat(&gtm_b, my_rank, storage_flags[k]);
+        // Column-major user buffers for column-major storage
+        if (storage_flags[k] & GTM_STORAGE_COLMAJOR)
+        {
+            GTM_setBufferLayout(gtm_p, GTM_BUF_COL_MAJOR);
+            GTM_setBufferLayout(gtm_b, GTM_BUF_COL_MAJOR);
+        }
+        run_iters(gtm_p, gtm_b, my_rank, (k == 0), &mat_p[0], &mat_b[0]);
+        if (my_rank == ACTOR_RANK)
+        {
+            double checksum = 0.0, max_diff = 0.0;
+            for (int i = 0; i < N * N; i++)
+            {
+                checksum += mat_p[i];
+                double diff = mat_p[i] - mat_b[i];
+                if (diff < 0.0) diff = -diff;
+                if (diff > max_diff) max_diff = diff;
+            }
+            printf(
+                "storage 0x%02x: checksum = %.3lf, max |plan - batch| = %.3lf\n",
+                storage_flags[k], checksum, max_diff
+            );
+        }
+        GTM_destroy(gtm_p);
+        GTM_destroy(gtm_b);
+    }
+
+    MPI_Finalize();
+}
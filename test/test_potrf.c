@@ -0,0 +1,151 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 0
+#define N          150
+#define NB         32
+
+/*
+Run with: mpirun -np 4 ./test_potrf.x
+Correct output (timings vary):
+storage 0x00: max |A - L * L^T| < 1e-10, upper triangle unchanged
+storage 0x18: max |A - L * L^T| < 1e-10, upper triangle unchanged
+not positive definite matrix: GTM_NOT_POS_DEF returned
+N = 600: GTM_potrf 123.456 ms, export to one process 12.345 ms
+*/
+
+static double init_val(int n, int i, int j)
+{
+    if (i == j) return (double) n;
+    return 1.0 / (double) (1 + (i > j ? i - j : j - i));
+}
+
+static int create_mat(GTMatrix_t *gtm, int my_rank, int n, int storage_flags)
+{
+    int r_displs[3] = {0, n / 2 - 5, n};
+    int c_displs[3] = {0, n / 2 + 5, n};
+    int ret = GTM_createEx(
+        gtm, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, n, n,
+        2, 2, &r_displs[0], &c_displs[0], storage_flags
+    );
+    if (storage_flags & GTM_STORAGE_COLMAJOR) GTM_setBufferLayout(*gtm, GTM_BUF_COL_MAJOR);
+    return ret;
+}
+
+static void set_mat(GTMatrix_t gtm, int my_rank, int n, double *mat)
+{
+    if (my_rank == ACTOR_RANK)
+    {
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                mat[GTM_BUF_OFFSET(gtm, n, i, j)] = init_val(n, i, j);
+        GTM_putBlock(gtm, 0, n, 0, n, mat, n);
+    }
+    GTM_sync(gtm);
+}
+
+static void check_potrf(int my_rank, int storage_flags)
+{
+    GTMatrix_t gtm;
+    double *mat = (double*) malloc(sizeof(double) * N * N);
+    create_mat(&gtm, my_rank, N, storage_flags);
+    set_mat(gtm, my_rank, N, mat);
+    GTM_potrf(gtm, NB);
+
+    if (my_rank == ACTOR_RANK)
+    {
+        GTM_getBlock(gtm, 0, N, 0, N, mat, N);
+        double max_err = 0.0;
+        int upper_changed = 0;
+        for (int i = 0; i < N; i++)
+        {
+            for (int j = 0; j < N; j++)
+            {
+                if (j > i)
+                {
+                    if (mat[GTM_BUF_OFFSET(gtm, N, i, j)] != init_val(N, i, j)) upper_changed++;
+                    continue;
+                }
+                double LLT = 0.0;
+                for (int p = 0; p <= j; p++)
+                    LLT += mat[GTM_BUF_OFFSET(gtm, N, i, p)] * mat[GTM_BUF_OFFSET(gtm, N, j, p)];
+                double err = LLT - init_val(N, i, j);
+                if (err < 0.0) err = -err;
+                if (err > max_err) max_err = err;
+            }
+        }
+        printf(
+            "storage 0x%02x: max |A - L * L^T| %s 1e-10, upper triangle %s\n",
+            storage_flags, (max_err < 1e-10) ? "<" : ">=", upper_changed ? "changed" : "unchanged"
+        );
+    }
+    GTM_sync(gtm);
+    GTM_destroy(gtm);
+    free(mat);
+}
+
+static void check_not_pos_def(int my_rank)
+{
+    GTMatrix_t gtm;
+    double minus_one = -1.0;
+    create_mat(&gtm, my_rank, N, GTM_STORAGE_DEFAULT);
+    GTM_fill(gtm, &minus_one);
+    GTM_sync(gtm);
+    int ret = GTM_potrf(gtm, NB);
+    if (my_rank == ACTOR_RANK)
+    {
+        printf(
+            "not positive definite matrix: %s returned\n",
+            (ret == GTM_NOT_POS_DEF) ? "GTM_NOT_POS_DEF" : "wrong value"
+        );
+    }
+    GTM_destroy(gtm);
+}
+
+// Time of the factorization and of exporting the matrix to one process,
+// which is needed before factorizing it with a library outside GTMatrix
+static void bench_potrf(int my_rank, int n)
+{
+    GTMatrix_t gtm;
+    double *mat = (double*) malloc(sizeof(double) * n * n);
+    create_mat(&gtm, my_rank, n, GTM_STORAGE_DEFAULT);
+    set_mat(gtm, my_rank, n, mat);
+
+    double st = MPI_Wtime();
+    if (my_rank == ACTOR_RANK) GTM_getBlock(gtm, 0, n, 0, n, mat, n);
+    GTM_sync(gtm);
+    double export_ms = (MPI_Wtime() - st) * 1000.0;
+
+    st = MPI_Wtime();
+    GTM_potrf(gtm, GTM_POTRF_TILE_SIZE);
+    double potrf_ms = (MPI_Wtime() - st) * 1000.0;
+
+    if (my_rank == ACTOR_RANK)
+        printf("N = %d: GTM_potrf %.3lf ms, export to one process %.3lf ms\n", n, potrf_ms, export_ms);
+    GTM_destroy(gtm);
+    free(mat);
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    // 4 * 4 tiles for GTM_STORAGE_TILED
+    setenv("GTM_TILE_SIZE", "4", 1);
+
+    int my_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+    check_potrf(my_rank, GTM_STORAGE_DEFAULT);
+    check_potrf(my_rank, GTM_STORAGE_TILED | GTM_STORAGE_COLMAJOR);
+    check_not_pos_def(my_rank);
+    unsetenv("GTM_TILE_SIZE");
+    bench_potrf(my_rank, 600);
+
+    MPI_Finalize();
+}
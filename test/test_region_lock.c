@@ -0,0 +1,118 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix.h"
+#include "GTM_Region_Lock.h"
+#include "utils.h"
+
+#define ACTOR_RANK 0
+#define NITER      50
+
+/*
+Run with: mpirun -np 4 ./test_region_lock.x
+Correct output:
+counter protected by region lock = 200
+uniform process blocks after overlapping puts = 4
+matrix after nonblocking and batched accumulation:
+ 400	 400	 400	 400	 400	 400	 400	 400
+ 400	 400	 400	 400	 400	 400	 400	 400
+ 400	 400	 400	 400	 400	 400	 400	 400
+ 400	 400	 400	 400	 400	 400	 400	 400
+ 400	 400	 400	 400	 400	 400	 400	 400
+ 400	 400	 400	 400	 400	 400	 400	 400
+ 400	 400	 400	 400	 400	 400	 400	 400
+ 400	 400	 400	 400	 400	 400	 400	 400
+*/
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    // Use region locks on 2 * 2 lock tiles for all updates
+    setenv("GTM_UPDATE_ATOMICITY", "3", 1);
+    setenv("GTM_LOCK_TILE_SIZE",   "2", 1);
+
+    int displs[3] = {0, 4, 8};
+    int my_rank, nprocs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+    GTMatrix_t gtm;
+    int zero = 0, buf[64];
+    GTM_create(&gtm, MPI_COMM_WORLD, MPI_INT, 4, my_rank, 8, 8, 2, 2, &displs[0], &displs[0]);
+    GTM_fill(gtm, &zero);
+    GTM_sync(gtm);
+
+    // Read-modify-write with get and put, protected by a region lock
+    GTM_Region_Lock_t gtrl;
+    GTM_createRegionLock(&gtrl, MPI_COMM_WORLD, 1);
+    for (int i = 0; i < NITER; i++)
+    {
+        int counter;
+        GTM_acquireRegionLock(gtrl, ACTOR_RANK, 0);
+        GTM_getBlock(gtm, 0, 1, 0, 1, &counter, 1);
+        counter++;
+        GTM_putBlock(gtm, 0, 1, 0, 1, &counter, 1);
+        GTM_releaseRegionLock(gtrl, ACTOR_RANK, 0);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    GTM_destroyRegionLock(gtrl);
+    GTM_sync(gtm);
+    if (my_rank == ACTOR_RANK)
+    {
+        int counter;
+        GTM_getBlock(gtm, 0, 1, 0, 1, &counter, 1);
+        printf("counter protected by region lock = %d\n", counter);
+    }
+    GTM_sync(gtm);
+
+    // Overlapping puts of the whole matrix, each process block is written by
+    // one put at a time, so each process block has only one value
+    for (int i = 0; i < 64; i++) buf[i] = my_rank + 1;
+    for (int i = 0; i < NITER; i++)
+        GTM_putBlock(gtm, 0, 8, 0, 8, &buf[0], 8);
+    GTM_sync(gtm);
+    if (my_rank == ACTOR_RANK)
+    {
+        int n_uniform = 0;
+        GTM_getBlock(gtm, 0, 8, 0, 8, &buf[0], 8);
+        for (int blk = 0; blk < 4; blk++)
+        {
+            int r0 = (blk / 2) * 4, c0 = (blk % 2) * 4, uniform = 1;
+            for (int irow = r0; irow < r0 + 4; irow++)
+                for (int icol = c0; icol < c0 + 4; icol++)
+                    if (buf[irow * 8 + icol] != buf[r0 * 8 + c0]) uniform = 0;
+            n_uniform += uniform;
+        }
+        printf("uniform process blocks after overlapping puts = %d\n", n_uniform);
+    }
+    GTM_sync(gtm);
+
+    // Nonblocking and batched accumulation of overlapping blocks
+    GTM_fill(gtm, &zero);
+    GTM_sync(gtm);
+    for (int i = 0; i < 64; i++) buf[i] = 1;
+    for (int i = 0; i < NITER; i++)
+        GTM_accBlockNB(gtm, 0, 8, 0, 8, &buf[0], 8);
+    GTM_waitNB(gtm);
+    GTM_startBatchAcc(gtm);
+    for (int i = 0; i < NITER; i++)
+    {
+        GTM_addAccBlockRequest(gtm, 0, 5, 0, 8, &buf[0], 8);
+        GTM_addAccBlockRequest(gtm, 5, 3, 0, 8, &buf[0], 8);
+    }
+    GTM_execBatchAcc(gtm);
+    GTM_stopBatchAcc(gtm);
+    GTM_sync(gtm);
+    if (my_rank == ACTOR_RANK)
+    {
+        GTM_getBlock(gtm, 0, 8, 0, 8, &buf[0], 8);
+        print_int_mat(&buf[0], 8, 8, 8, "matrix after nonblocking and batched accumulation");
+    }
+    GTM_sync(gtm);
+    GTM_destroy(gtm);
+
+    MPI_Finalize();
+}
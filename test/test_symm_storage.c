@@ -0,0 +1,135 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+#include <complex.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 1
+
+/*
+Run with: mpirun -np 4 ./test_symm_storage.x
+Correct output:
+Symmetric matrix:
+ 0.000	 1.000	 2.000	 3.000	 4.000	 5.000
+ 1.000	 11.000	 12.000	 13.000	 14.000	 15.000
+ 2.000	 12.000	 22.000	 23.000	 24.000	 25.000
+ 3.000	 13.000	 23.000	 33.000	 34.000	 35.000
+ 4.000	 14.000	 24.000	 34.000	 44.000	 45.000
+ 5.000	 15.000	 25.000	 35.000	 45.000	 55.000
+Lower block accumulated by all processes:
+ 0.000	 1.000	 2.000	 7.000	 8.000	 9.000
+ 1.000	 11.000	 12.000	 17.000	 18.000	 19.000
+ 2.000	 12.000	 22.000	 27.000	 28.000	 29.000
+ 7.000	 17.000	 27.000	 33.000	 34.000	 35.000
+ 8.000	 18.000	 28.000	 34.000	 44.000	 45.000
+ 9.000	 19.000	 29.000	 35.000	 45.000	 55.000
+Batch get lower triangle rows 4-5: 8.000 18.000 28.000 34.000 44.000 9.000 19.000 29.000 35.000 45.000 55.000
+Hermitian matrix:
+1.0+0.0i 1.0+1.0i 1.0+2.0i 1.0+3.0i
+1.0-1.0i 2.0+0.0i 2.0+1.0i 2.0+2.0i
+1.0-2.0i 2.0-1.0i 3.0+0.0i 3.0+1.0i
+1.0-3.0i 2.0-2.0i 3.0-1.0i 4.0+0.0i
+*/
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    int displs[3] = {0, 3, 6};
+    double mat[36], acc[9];
+
+    int my_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+    GTMatrix_t gtm;
+
+    // 2 * 2 proc grid, matrix size 6 * 6, process 2 stores nothing
+    GTM_createEx(
+        &gtm, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, 6, 6,
+        2, 2, &displs[0], &displs[0], GTM_STORAGE_SYMM
+    );
+
+    double d_zero = 0.0;
+    GTM_fill(gtm, &d_zero);
+    GTM_sync(gtm);
+
+    // Put a symmetric matrix, lower triangle puts are redirected to the upper triangle
+    if (my_rank == 0)
+    {
+        for (int i = 0; i < 6; i++)
+            for (int j = 0; j < 6; j++)
+                mat[i * 6 + j] = (double) (MIN(i, j) * 10 + MAX(i, j));
+        GTM_putBlock(gtm, 0, 6, 0, 6, &mat[0], 6);
+    }
+    GTM_sync(gtm);
+
+    if (my_rank == ACTOR_RANK)
+    {
+        for (int i = 0; i < 36; i++) mat[i] = -1.0;
+        GTM_getBlock(gtm, 0, 6, 0, 6, &mat[0], 6);
+        print_double_mat(&mat[0], 6, 6, 6, "Symmetric matrix");
+    }
+    GTM_sync(gtm);
+
+    // Accumulate to the lower-left block, which is stored in the upper-right block
+    for (int i = 0; i < 9; i++) acc[i] = 1.0;
+    GTM_accBlockNB(gtm, 3, 3, 0, 3, &acc[0], 3);
+    GTM_waitNB(gtm);
+    GTM_sync(gtm);
+
+    if (my_rank == ACTOR_RANK)
+    {
+        for (int i = 0; i < 36; i++) mat[i] = -1.0;
+        GTM_getBlock(gtm, 0, 6, 0, 6, &mat[0], 6);
+        print_double_mat(&mat[0], 6, 6, 6, "Lower block accumulated by all processes");
+
+        for (int i = 0; i < 12; i++) mat[i] = -1.0;
+        GTM_startBatchGet(gtm);
+        GTM_addGetBlockRequest(gtm, 4, 2, 0, 5, &mat[0], 5);
+        GTM_execBatchGet(gtm);
+        GTM_stopBatchGet(gtm);
+        printf("Batch get lower triangle rows 4-5: ");
+        for (int i = 0; i < 5; i++) printf("%.3lf ", mat[i]);
+        GTM_getBlockNB(gtm, 5, 1, 0, 6, &mat[5], 6);
+        GTM_waitNB(gtm);
+        for (int i = 5; i < 11; i++) printf("%.3lf ", mat[i]);
+        printf("\n");
+    }
+    GTM_sync(gtm);
+    GTM_destroy(gtm);
+
+    // Hermitian matrix, lower triangle elements are conjugated
+    int z_displs[3] = {0, 2, 4};
+    double _Complex zmat[16];
+    GTMatrix_t gtmz;
+    GTM_createEx(
+        &gtmz, MPI_COMM_WORLD, MPI_C_DOUBLE_COMPLEX, 16, my_rank, 4, 4,
+        2, 2, &z_displs[0], &z_displs[0], GTM_STORAGE_SYMM
+    );
+    if (my_rank == 0)
+    {
+        for (int i = 0; i < 4; i++)
+            for (int j = i; j < 4; j++)
+                zmat[i * 4 + j] = (double) (i + 1) + (double) (j - i) * I;
+        for (int i = 0; i < 4; i++) GTM_putBlock(gtmz, i, 1, i, 4 - i, &zmat[i * 5], 4);
+    }
+    GTM_sync(gtmz);
+    if (my_rank == ACTOR_RANK)
+    {
+        GTM_getBlock(gtmz, 0, 4, 0, 4, &zmat[0], 4);
+        printf("Hermitian matrix:\n");
+        for (int i = 0; i < 4; i++)
+        {
+            for (int j = 0; j < 4; j++)
+                printf("%.1lf%+.1lfi ", creal(zmat[i * 4 + j]), cimag(zmat[i * 4 + j]));
+            printf("\n");
+        }
+    }
+    GTM_sync(gtmz);
+    GTM_destroy(gtmz);
+
+    MPI_Finalize();
+}
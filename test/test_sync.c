@@ -0,0 +1,73 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 0
+#define NITER      200
+
+/*
+Run with: mpirun -np 4 ./test_sync.x
+Correct output (timings vary):
+split-phase sync: 200 iterations, 0 stale element(s), overlapped work = 200
+GTM_sync latency: ... us
+*/
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    int displs[3] = {0, 2, 4};
+    int my_rank, nprocs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+    GTMatrix_t gtm;
+    int zero = 0, row[4], mat[16];
+    GTM_create(&gtm, MPI_COMM_WORLD, MPI_INT, 4, my_rank, 4, 4, 2, 2, &displs[0], &displs[0]);
+    GTM_fill(gtm, &zero);
+    GTM_sync(gtm);
+
+    // Each process writes row my_rank (nonblocking), overlaps some work with 
+    // the barrier, and then all elements should have the new value
+    int n_stale = 0, work = 0;
+    for (int iter = 1; iter <= NITER; iter++)
+    {
+        for (int i = 0; i < 4; i++) row[i] = iter;
+        GTM_putBlockNB(gtm, my_rank, 1, 0, 4, &row[0], 4);
+        GTM_syncBegin(gtm);
+        work++;
+        GTM_syncEnd(gtm);
+        GTM_getBlock(gtm, 0, 4, 0, 4, &mat[0], 4);
+        for (int i = 0; i < 16; i++) if (mat[i] != iter) n_stale++;
+        GTM_sync(gtm);
+    }
+    int total_stale, total_work;
+    MPI_Reduce(&n_stale, &total_stale, 1, MPI_INT, MPI_SUM, ACTOR_RANK, MPI_COMM_WORLD);
+    MPI_Reduce(&work, &total_work, 1, MPI_INT, MPI_MIN, ACTOR_RANK, MPI_COMM_WORLD);
+    if (my_rank == ACTOR_RANK)
+    {
+        printf(
+            "split-phase sync: %d iterations, %d stale element(s), overlapped work = %d\n", 
+            NITER, total_stale, total_work
+        );
+    }
+
+    // Barrier latency
+    double st, et, ut, max_ut;
+    GTM_sync(gtm);
+    st = MPI_Wtime();
+    for (int iter = 0; iter < NITER; iter++) GTM_sync(gtm);
+    et = MPI_Wtime();
+    ut = (et - st) * 1e6 / (double) NITER;
+    MPI_Reduce(&ut, &max_ut, 1, MPI_DOUBLE, MPI_MAX, ACTOR_RANK, MPI_COMM_WORLD);
+    if (my_rank == ACTOR_RANK) printf("GTM_sync latency: %.2lf us\n", max_ut);
+
+    GTM_sync(gtm);
+    GTM_destroy(gtm);
+
+    MPI_Finalize();
+}
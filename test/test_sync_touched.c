@@ -0,0 +1,88 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 0
+#define NITER      100
+
+/*
+Run with: mpirun -np 4 ./test_sync_touched.x
+Correct output:
+Rank 0: 20 incoming update(s), local block complete: yes
+Rank 1: 0 incoming update(s), local block complete: yes
+Rank 2: 0 incoming update(s), local block complete: yes
+Rank 3: 20 incoming update(s), local block complete: yes
+Round 2: 100 iteration(s), 0 incomplete local block(s)
+*/
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    int displs[3] = {0, 4, 8};
+    int my_rank, nprocs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+    GTMatrix_t gtm;
+    int zero = 0, blk[16], my_blk[16];
+    GTM_create(&gtm, MPI_COMM_WORLD, MPI_INT, 4, my_rank, 8, 8, 2, 2, &displs[0], &displs[0]);
+    GTM_fill(gtm, &zero);
+    GTM_sync(gtm);
+
+    int my_r0 = (my_rank / 2) * 4, my_c0 = (my_rank % 2) * 4;
+
+    // Only ranks 1 and 2 update, only ranks 0 and 3 are updated
+    for (int i = 0; i < 16; i++) blk[i] = 1;
+    if (my_rank == 1 || my_rank == 2)
+    {
+        for (int i = 0; i < 10; i++)
+        {
+            GTM_accBlockNB(gtm, 0, 4, 0, 4, &blk[0], 4);
+            GTM_accBlock  (gtm, 4, 4, 4, 4, &blk[0], 4);
+        }
+    }
+    int n_incoming, complete = 1;
+    GTM_syncTouched(gtm, &n_incoming);
+    GTM_getBlock(gtm, my_r0, 4, my_c0, 4, &my_blk[0], 4);
+    int expected = (my_rank == 0 || my_rank == 3) ? 20 : 0;
+    for (int i = 0; i < 16; i++) if (my_blk[i] != expected) complete = 0;
+    for (int r = 0; r < nprocs; r++)
+    {
+        if (r == my_rank)
+        {
+            printf(
+                "Rank %d: %d incoming update(s), local block complete: %s\n", 
+                my_rank, n_incoming, complete ? "yes" : "no"
+            );
+            fflush(stdout);
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+
+    // Each process accumulates to the next process, then checks its own block
+    int n_bad = 0, total_bad;
+    int next = (my_rank + 1) % nprocs;
+    int r0 = (next / 2) * 4, c0 = (next % 2) * 4;
+    for (int iter = 1; iter <= NITER; iter++)
+    {
+        GTM_accBlockNB(gtm, r0, 4, c0, 4, &blk[0], 4);
+        GTM_syncTouched(gtm, NULL);
+        GTM_getBlock(gtm, my_r0, 4, my_c0, 4, &my_blk[0], 4);
+        int base = (my_rank == 0 || my_rank == 3) ? 20 : 0;
+        for (int i = 0; i < 16; i++) 
+            if (my_blk[i] != base + iter) { n_bad++; break; }
+    }
+    MPI_Reduce(&n_bad, &total_bad, 1, MPI_INT, MPI_SUM, ACTOR_RANK, MPI_COMM_WORLD);
+    if (my_rank == ACTOR_RANK) 
+        printf("Round 2: %d iteration(s), %d incomplete local block(s)\n", NITER, total_bad);
+
+    GTM_sync(gtm);
+    GTM_destroy(gtm);
+
+    MPI_Finalize();
+}
@@ -0,0 +1,99 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 0
+#define NK         3
+#define NROWS      10
+#define NCOLS      9
+
+/*
+Run with: mpirun -np 4 ./test_tensor.x
+Correct output:
+put box [0:3, 0:10, 0:9]: 0 error(s)
+acc box [1:3, 2:8, 3:7]: 0 error(s)
+*/
+
+static double init_val(int k, int i, int j) { return (double) (k * 100 + i * 10 + j); }
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    int my_rank, comm_size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
+
+    int r_displs[3] = {0, 4, NROWS}, c_displs[3] = {0, 5, NCOLS};
+    GTM_Tensor_t gtt;
+    GTM_createTensor(
+        &gtt, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, NK, NROWS, NCOLS,
+        2, 2, &r_displs[0], &c_displs[0]
+    );
+
+    // Leading dimension and slice distance larger than the box
+    int ld = NCOLS + 1, kstride = (NROWS + 1) * ld;
+    double *buf = (double*) malloc(sizeof(double) * NK * kstride);
+    double *box = (double*) malloc(sizeof(double) * NK * kstride);
+    double zero = 0.0;
+    GTM_fillTensor(gtt, &zero);
+    GTM_syncTensor(gtt);
+
+    // Put the whole tensor, each process gets a single transfer
+    if (my_rank == ACTOR_RANK)
+    {
+        for (int k = 0; k < NK; k++)
+            for (int i = 0; i < NROWS; i++)
+                for (int j = 0; j < NCOLS; j++)
+                    buf[k * kstride + i * ld + j] = init_val(k, i, j);
+        GTM_putTensorBox(gtt, 0, NK, 0, NROWS, 0, NCOLS, buf, ld, kstride);
+    }
+    GTM_syncTensor(gtt);
+    if (my_rank == ACTOR_RANK)
+    {
+        int n_error = 0;
+        GTM_getTensorBox(gtt, 0, NK, 0, NROWS, 0, NCOLS, box, ld, kstride);
+        for (int k = 0; k < NK; k++)
+            for (int i = 0; i < NROWS; i++)
+                for (int j = 0; j < NCOLS; j++)
+                    if (box[k * kstride + i * ld + j] != init_val(k, i, j)) n_error++;
+        printf("put box [0:3, 0:10, 0:9]: %d error(s)\n", n_error);
+    }
+    GTM_syncTensor(gtt);
+
+    // All processes accumulate 1 to a box that spans all 4 process blocks
+    for (int k = 0; k < 2; k++)
+        for (int i = 0; i < 6; i++)
+            for (int j = 0; j < 4; j++)
+                buf[k * 6 * 4 + i * 4 + j] = 1.0;
+    GTM_accTensorBox(gtt, 1, 2, 2, 6, 3, 4, buf, 4, 6 * 4);
+    GTM_syncTensor(gtt);
+    if (my_rank == ACTOR_RANK)
+    {
+        int n_error = 0;
+        GTM_getTensorBox(gtt, 0, NK, 0, NROWS, 0, NCOLS, box, ld, kstride);
+        for (int k = 0; k < NK; k++)
+        {
+            for (int i = 0; i < NROWS; i++)
+            {
+                for (int j = 0; j < NCOLS; j++)
+                {
+                    double expected = init_val(k, i, j);
+                    if ((k >= 1) && (i >= 2) && (i < 8) && (j >= 3) && (j < 7)) expected += (double) comm_size;
+                    if (box[k * kstride + i * ld + j] != expected) n_error++;
+                }
+            }
+        }
+        printf("acc box [1:3, 2:8, 3:7]: %d error(s)\n", n_error);
+    }
+    GTM_syncTensor(gtt);
+
+    free(buf);
+    free(box);
+    GTM_destroyTensor(gtt);
+    MPI_Finalize();
+}
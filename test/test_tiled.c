@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 0
+#define N          10
+
+/*
+Run with: mpirun -np 4 ./test_tiled.x
+Correct output:
+full storage     : checksum = 6556.000, max |row-major - tiled| = 0.000
+symmetric storage: checksum = 8925.000, max |row-major - tiled| = 0.000
+*/
+
+// Apply the same sequence of operations to a matrix and get the whole matrix
+static void run_ops(GTMatrix_t gtm, int my_rank, double *mat)
+{
+    double zero = 0.0, half = 0.5, src[N * N], fetch[N * N], val;
+    int rows[4], cols[4];
+
+    GTM_fill(gtm, &zero);
+    GTM_sync(gtm);
+
+    // Put the whole matrix, every request crosses process blocks and tiles
+    if (my_rank == ACTOR_RANK)
+    {
+        for (int i = 0; i < N * N; i++) src[i] = (double) i;
+        GTM_putBlock(gtm, 0, N, 0, N, &src[0], N);
+    }
+    GTM_sync(gtm);
+
+    // Nonblocking, scaled and batched accumulation of unaligned blocks
+    for (int i = 0; i < N * N; i++) src[i] = (double) (my_rank + 1);
+    GTM_accBlockNB(gtm, 1, 7, 2, 8, &src[0], N);
+    GTM_waitNB(gtm);
+    GTM_accBlockScaled(gtm, 3, 6, 0, N, &src[0], N, &half);
+    GTM_startBatchAcc(gtm);
+    GTM_addAccBlockRequest(gtm, 0, 4, 4, 4, &src[0], N);
+    GTM_addAccBlockRequest(gtm, 6, 3, 1, 9, &src[0], N);
+    GTM_execBatchAcc(gtm);
+    GTM_stopBatchAcc(gtm);
+    GTM_sync(gtm);
+
+    // Element atomics and fetch-and-accumulate
+    for (int i = 0; i < 4; i++)
+    {
+        rows[i] = (my_rank + 3 * i) % N;
+        cols[i] = (7 * i + 2) % N;
+    }
+    val = 1.0;
+    for (int i = 0; i < 4; i++)
+        GTM_fetchAndOp(gtm, rows[i], cols[i], MPI_SUM, &val, &fetch[i]);
+    GTM_fetchAccBlock(gtm, 2, 5, 3, 6, &src[0], N, MPI_SUM, &fetch[0], N);
+    GTM_sync(gtm);
+
+    GTM_symmetrize(gtm);
+    GTM_getBlock(gtm, 0, N, 0, N, mat, N);
+    GTM_sync(gtm);
+}
+
+static void compare_layouts(int my_rank, int storage_flags, const char *name)
+{
+    int displs[3] = {0, 5, N};
+    double mat_r[N * N], mat_t[N * N];
+    GTMatrix_t gtm_r, gtm_t;
+
+    GTM_createEx(
+        &gtm_r, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, N, N,
+        2, 2, &displs[0], &displs[0], storage_flags
+    );
+    GTM_createEx(
+        &gtm_t, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, N, N,
+        2, 2, &displs[0], &displs[0], storage_flags | GTM_STORAGE_TILED
+    );
+    run_ops(gtm_r, my_rank, &mat_r[0]);
+    run_ops(gtm_t, my_rank, &mat_t[0]);
+    if (my_rank == ACTOR_RANK)
+    {
+        double checksum = 0.0, max_diff = 0.0;
+        for (int i = 0; i < N * N; i++)
+        {
+            checksum += mat_t[i];
+            double diff = mat_r[i] - mat_t[i];
+            if (diff < 0.0) diff = -diff;
+            if (diff > max_diff) max_diff = diff;
+        }
+        printf("%s: checksum = %.3lf, max |row-major - tiled| = %.3lf\n", name, checksum, max_diff);
+    }
+    GTM_destroy(gtm_r);
+    GTM_destroy(gtm_t);
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    // 4 * 4 tiles, the 5 * 5 local blocks have padded partial tiles
+    setenv("GTM_TILE_SIZE", "4", 1);
+
+    int my_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+    compare_layouts(my_rank, GTM_STORAGE_DEFAULT, "full storage     ");
+    compare_layouts(my_rank, GTM_STORAGE_SYMM,    "symmetric storage");
+
+    MPI_Finalize();
+}
@@ -0,0 +1,103 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 0
+
+/*
+Run with: mpirun -np 4 ./test_track.x
+Correct output:
+changed tiles since version 1: 5
+  rows [0, 1], cols [4, 5]
+  rows [0, 1], cols [6, 7]
+  rows [2, 3], cols [4, 5]
+  rows [2, 3], cols [6, 7]
+  rows [6, 7], cols [6, 7]
+changed tiles in rows [1, 2], cols [0, 7]: 4
+4 process(es) refreshed 5 tile(s), cached copies match the matrix: 4
+changed tiles since version 3: 0
+*/
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    // 2 * 2 tracking tiles
+    setenv("GTM_TRACK_TILE_SIZE", "2", 1);
+
+    int displs[3] = {0, 4, 8};
+    int my_rank, nprocs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+    GTMatrix_t gtm;
+    int zero = 0, cache[64], mat[64], tiles[4 * 16];
+    GTM_createEx(
+        &gtm, MPI_COMM_WORLD, MPI_INT, 4, my_rank, 8, 8, 
+        2, 2, &displs[0], &displs[0], GTM_STORAGE_TRACK
+    );
+    GTM_fill(gtm, &zero);
+    GTM_sync(gtm);
+
+    // Each process caches the whole matrix
+    GTM_getBlock(gtm, 0, 8, 0, 8, &cache[0], 8);
+    int cache_version = gtm->track_version;
+    GTM_sync(gtm);
+
+    // Rank 2 puts a block in rank 1's block, rank 3 accumulates an element
+    if (my_rank == 2)
+    {
+        int blk[4] = {1, 2, 3, 4};
+        GTM_putBlock(gtm, 1, 2, 5, 2, &blk[0], 2);
+    }
+    if (my_rank == 3)
+    {
+        int one = 1;
+        GTM_accBlock(gtm, 7, 1, 7, 1, &one, 1);
+    }
+    GTM_sync(gtm);
+
+    int n_tiles;
+    if (my_rank == ACTOR_RANK)
+    {
+        GTM_getChangedTiles(gtm, 0, 8, 0, 8, cache_version, 16, &n_tiles, &tiles[0]);
+        printf("changed tiles since version %d: %d\n", cache_version, n_tiles);
+        for (int i = 0; i < n_tiles; i++)
+        {
+            printf(
+                "  rows [%d, %d], cols [%d, %d]\n", tiles[4 * i], tiles[4 * i] + tiles[4 * i + 1] - 1,
+                tiles[4 * i + 2], tiles[4 * i + 2] + tiles[4 * i + 3] - 1
+            );
+        }
+        GTM_getChangedTiles(gtm, 1, 2, 0, 8, cache_version, 16, &n_tiles, &tiles[0]);
+        printf("changed tiles in rows [1, 2], cols [0, 7]: %d\n", n_tiles);
+    }
+
+    // Delta refresh of the cached copies
+    int n_refreshed, ok = 1, n_ok, n_refresh_ok;
+    GTM_refreshBlock(gtm, 0, 8, 0, 8, &cache[0], 8, cache_version, &n_refreshed);
+    GTM_getBlock(gtm, 0, 8, 0, 8, &mat[0], 8);
+    for (int i = 0; i < 64; i++) if (cache[i] != mat[i]) ok = 0;
+    int refresh_ok = (n_refreshed == 5) ? 1 : 0;
+    MPI_Reduce(&ok, &n_ok, 1, MPI_INT, MPI_SUM, ACTOR_RANK, MPI_COMM_WORLD);
+    MPI_Reduce(&refresh_ok, &n_refresh_ok, 1, MPI_INT, MPI_SUM, ACTOR_RANK, MPI_COMM_WORLD);
+    if (my_rank == ACTOR_RANK)
+        printf("%d process(es) refreshed 5 tile(s), cached copies match the matrix: %d\n", n_refresh_ok, n_ok);
+    cache_version = gtm->track_version;
+    GTM_sync(gtm);
+
+    // No update since the last refresh
+    if (my_rank == ACTOR_RANK)
+    {
+        GTM_getChangedTiles(gtm, 0, 8, 0, 8, cache_version, 16, &n_tiles, &tiles[0]);
+        printf("changed tiles since version %d: %d\n", cache_version, n_tiles);
+    }
+    GTM_sync(gtm);
+    GTM_destroy(gtm);
+
+    MPI_Finalize();
+}
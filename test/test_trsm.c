@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 0
+#define N          100
+#define NRHS       7
+#define NB         16
+
+/*
+Run with: mpirun -np 4 ./test_trsm.x
+Correct output:
+storage 0x00: distributed B max error < 1e-10, replicated B max error < 1e-10
+storage 0x18: distributed B max error < 1e-10, replicated B max error < 1e-10
+*/
+
+static double init_val(int i, int j)
+{
+    if (i == j) return (double) N;
+    return 1.0 / (double) (1 + (i > j ? i - j : j - i));
+}
+
+static double x_val(int i, int j) { return (double) ((i * 7 + j * 3) % 11) - 5.0; }
+
+static double max_error(GTMatrix_t gtm, double *X)
+{
+    double max_err = 0.0;
+    for (int i = 0; i < N; i++)
+    {
+        for (int j = 0; j < NRHS; j++)
+        {
+            double err = X[GTM_BUF_OFFSET(gtm, gtm->col_major_buf ? N : NRHS, i, j)] - x_val(i, j);
+            if (err < 0.0) err = -err;
+            if (err > max_err) max_err = err;
+        }
+    }
+    return max_err;
+}
+
+static void check_trsm(int my_rank, int storage_flags)
+{
+    int r_displs[3] = {0, 45, N}, c_displs[3] = {0, 55, N}, rhs_displs[3] = {0, 3, NRHS};
+    GTMatrix_t L, B;
+    GTM_createEx(&L, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, N, N,    2, 2, &r_displs[0], &c_displs[0],   storage_flags);
+    GTM_createEx(&B, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, N, NRHS, 2, 2, &r_displs[0], &rhs_displs[0], storage_flags);
+    if (storage_flags & GTM_STORAGE_COLMAJOR)
+    {
+        GTM_setBufferLayout(L, GTM_BUF_COL_MAJOR);
+        GTM_setBufferLayout(B, GTM_BUF_COL_MAJOR);
+    }
+    int ldb = (storage_flags & GTM_STORAGE_COLMAJOR) ? N : NRHS;
+
+    // B = A * X on all processes, A = L * L^T
+    double *mat = (double*) malloc(sizeof(double) * N * N);
+    double *rhs = (double*) malloc(sizeof(double) * N * NRHS);
+    for (int i = 0; i < N; i++)
+    {
+        for (int j = 0; j < NRHS; j++)
+        {
+            double b = 0.0;
+            for (int p = 0; p < N; p++) b += init_val(i, p) * x_val(p, j);
+            rhs[GTM_BUF_OFFSET(L, ldb, i, j)] = b;
+        }
+    }
+    if (my_rank == ACTOR_RANK)
+    {
+        for (int i = 0; i < N; i++)
+            for (int j = 0; j < N; j++)
+                mat[GTM_BUF_OFFSET(L, N, i, j)] = init_val(i, j);
+        GTM_putBlock(L, 0, N, 0, N, mat, N);
+        GTM_putBlock(B, 0, N, 0, NRHS, rhs, ldb);
+    }
+    GTM_sync(L);
+    GTM_sync(B);
+    GTM_potrf(L, NB);
+
+    // A * X = B: L * Y = B, then L^T * X = Y
+    GTM_trsm(L, 0, B, NB);
+    GTM_trsm(L, 1, B, NB);
+    GTM_trsmReplicated(L, 0, NRHS, rhs, ldb, NB);
+    GTM_trsmReplicated(L, 1, NRHS, rhs, ldb, NB);
+
+    double max_err_rep = max_error(L, rhs), max_err_rep_all;
+    MPI_Reduce(&max_err_rep, &max_err_rep_all, 1, MPI_DOUBLE, MPI_MAX, ACTOR_RANK, MPI_COMM_WORLD);
+    if (my_rank == ACTOR_RANK)
+    {
+        GTM_getBlock(B, 0, N, 0, NRHS, rhs, ldb);
+        double max_err_dist = max_error(B, rhs);
+        printf(
+            "storage 0x%02x: distributed B max error %s 1e-10, replicated B max error %s 1e-10\n",
+            storage_flags, (max_err_dist < 1e-10) ? "<" : ">=", (max_err_rep_all < 1e-10) ? "<" : ">="
+        );
+    }
+    GTM_sync(B);
+
+    free(mat);
+    free(rhs);
+    GTM_destroy(L);
+    GTM_destroy(B);
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    // 4 * 4 tiles for GTM_STORAGE_TILED, small segments to pipeline panels
+    setenv("GTM_TILE_SIZE", "4", 1);
+    setenv("GTM_PANEL_SEG_SIZE", "256", 1);
+
+    int my_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+    check_trsm(my_rank, GTM_STORAGE_DEFAULT);
+    check_trsm(my_rank, GTM_STORAGE_TILED | GTM_STORAGE_COLMAJOR);
+
+    MPI_Finalize();
+}
@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+#include <complex.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 1
+
+/*
+Run with: mpirun -np 4 ./test_update_op.x
+Correct output:
+int matrix:
+ 68	 68	 68	 64	 64	 64
+ 68	 68	 68	 64	 64	 64
+ 15	 15	 15	 15	 15	 15
+ 15	 15	 15	 15	 15	 15
+ 0	 0	 0	 0	 0	 0
+ 0	 0	 0	 0	 0	 0
+double matrix:
+ 1.500	 1.500	 1.500	 1.500	 1.500	 1.500
+ 1.500	 1.500	 1.500	 1.500	 1.500	 1.500
+ 1.500	 1.500	 1.500	 1.500	 1.500	 1.500
+-48.000	-48.000	-48.000	-48.000	-48.000	-48.000
+-48.000	-48.000	-48.000	-48.000	-48.000	-48.000
+-48.000	-48.000	-48.000	-48.000	-48.000	-48.000
+double _Complex A(0, 0) = -4.0+0.0i
+MPI_MAX on double _Complex returns 18, MPI_MAXLOC on int returns 18
+*/
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    int displs[3] = {0, 2, 6};
+    int my_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+    // int matrix
+    int imat[36], isrc[36], i_one = 1;
+    GTMatrix_t gtm_i;
+    GTM_create(&gtm_i, MPI_COMM_WORLD, MPI_INT, 4, my_rank, 6, 6, 2, 2, &displs[0], &displs[0]);
+    GTM_fill(gtm_i, &i_one);
+    GTM_sync(gtm_i);
+
+    for (int i = 0; i < 36; i++) isrc[i] = my_rank + 1;
+    GTM_updateBlockOp(gtm_i, 0, 6, 0, 6, &isrc[0], 6, MPI_MAX);
+    GTM_sync(gtm_i);
+    for (int i = 0; i < 36; i++) isrc[i] = 2;
+    GTM_updateBlockOpNB(gtm_i, 0, 2, 0, 6, &isrc[0], 6, MPI_PROD);
+    GTM_waitNB(gtm_i);
+    GTM_sync(gtm_i);
+
+    // Requests with different operations in one batch, they do not overlap
+    int imin[12], ibor[12], isum[6];
+    for (int i = 0; i < 12; i++) imin[i] = my_rank;
+    for (int i = 0; i < 12; i++) ibor[i] = 1 << my_rank;
+    for (int i = 0; i < 6;  i++) isum[i] = 1;
+    GTM_startBatchAcc(gtm_i);
+    GTM_addUpdateBlockOpRequest(gtm_i, 4, 1, 0, 6, &imin[0], 6, MPI_MIN);
+    GTM_addUpdateBlockOpRequest(gtm_i, 2, 2, 0, 6, &ibor[0], 6, MPI_BOR);
+    GTM_addUpdateBlockOpRequest(gtm_i, 5, 1, 0, 6, &imin[6], 6, MPI_MIN);
+    GTM_addUpdateBlockOpRequest(gtm_i, 0, 2, 0, 3, &isum[0], 3, MPI_SUM);
+    GTM_execBatchAcc(gtm_i);
+    GTM_stopBatchAcc(gtm_i);
+    GTM_sync(gtm_i);
+
+    if (my_rank == ACTOR_RANK)
+    {
+        GTM_getBlock(gtm_i, 0, 6, 0, 6, &imat[0], 6);
+        print_int_mat(&imat[0], 6, 6, 6, "int matrix");
+    }
+    GTM_sync(gtm_i);
+
+    // double matrix
+    double dmat[36], dsrc[36], d_zero = 0.0;
+    GTMatrix_t gtm_d;
+    GTM_create(&gtm_d, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, 6, 6, 2, 2, &displs[0], &displs[0]);
+    GTM_fill(gtm_d, &d_zero);
+    GTM_sync(gtm_d);
+
+    for (int i = 0; i < 36; i++) dsrc[i] = -1.0 * (double) my_rank;
+    GTM_updateBlockOp(gtm_d, 0, 6, 0, 6, &dsrc[0], 6, MPI_MIN);
+    GTM_sync(gtm_d);
+    for (int i = 0; i < 36; i++) dsrc[i] = 0.5 * (double) my_rank;
+    GTM_updateBlockOpNB(gtm_d, 0, 3, 0, 6, &dsrc[0], 6, MPI_MAX);
+    GTM_waitNB(gtm_d);
+    for (int i = 0; i < 36; i++) dsrc[i] = 2.0;
+    GTM_startBatchAcc(gtm_d);
+    GTM_addUpdateBlockOpRequest(gtm_d, 3, 3, 0, 6, &dsrc[0], 6, MPI_PROD);
+    GTM_execBatchAcc(gtm_d);
+    GTM_stopBatchAcc(gtm_d);
+    GTM_sync(gtm_d);
+
+    if (my_rank == ACTOR_RANK)
+    {
+        GTM_getBlock(gtm_d, 0, 6, 0, 6, &dmat[0], 6);
+        print_double_mat(&dmat[0], 6, 6, 6, "double matrix");
+    }
+    GTM_sync(gtm_d);
+
+    // double _Complex matrix: MPI_PROD is supported, MPI_MAX is not
+    double _Complex z_one = 1.0, zsrc = 1.0 + 1.0 * I, zval;
+    GTMatrix_t gtm_z;
+    GTM_create(&gtm_z, MPI_COMM_WORLD, MPI_C_DOUBLE_COMPLEX, 16, my_rank, 6, 6, 2, 2, &displs[0], &displs[0]);
+    GTM_fill(gtm_z, &z_one);
+    GTM_sync(gtm_z);
+    GTM_updateBlockOp(gtm_z, 0, 1, 0, 1, &zsrc, 1, MPI_PROD);
+    GTM_sync(gtm_z);
+
+    if (my_rank == ACTOR_RANK)
+    {
+        GTM_getBlock(gtm_z, 0, 1, 0, 1, &zval, 1);
+        printf("double _Complex A(0, 0) = %.1lf%+.1lfi\n", creal(zval), cimag(zval));
+        int ret_z = GTM_updateBlockOp(gtm_z, 0, 1, 0, 1, &zsrc, 1, MPI_MAX);
+        int ret_i = GTM_updateBlockOp(gtm_i, 0, 1, 0, 1, &isrc[0], 1, MPI_MAXLOC);
+        printf("MPI_MAX on double _Complex returns %d, MPI_MAXLOC on int returns %d\n", ret_z, ret_i);
+    }
+    GTM_sync(gtm_z);
+
+    GTM_destroy(gtm_i);
+    GTM_destroy(gtm_d);
+    GTM_destroy(gtm_z);
+
+    MPI_Finalize();
+}
@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <mpi.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 0
+#define NROWS      11
+#define NCOLS      9
+
+/*
+Run with: mpirun -np 4 ./test_vector.x
+Correct output:
+aligned partitions: 0 error(s)
+range put / get: 0 error(s)
+gather: 0 error(s)
+scatter accumulate: 0 error(s)
+dot = 506, nrm2 = 22.4944, asum = 66, amax = 11
+*/
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    int my_rank, comm_size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
+
+    int r_displs[3] = {0, 5, NROWS}, c_displs[3] = {0, 4, NCOLS};
+    GTMatrix_t gtm;
+    GTM_create(&gtm, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, NROWS, NCOLS, 2, 2, &r_displs[0], &c_displs[0]);
+
+    // Local segments are inside the row / column block of this process
+    GTM_Vector_t x, y;
+    GTM_createAlignedVector(&x, gtm, GTM_VEC_ALIGN_ROW);
+    GTM_createAlignedVector(&y, gtm, GTM_VEC_ALIGN_COL);
+    int n_error = 0, total_error;
+    int r_s = gtm->r_displs[gtm->my_rowblk], r_e = gtm->r_displs[gtm->my_rowblk + 1];
+    int c_s = gtm->c_displs[gtm->my_colblk], c_e = gtm->c_displs[gtm->my_colblk + 1];
+    if ((x->my_start < r_s) || (x->my_start + x->my_len > r_e)) n_error++;
+    if ((y->my_start < c_s) || (y->my_start + y->my_len > c_e)) n_error++;
+    MPI_Reduce(&n_error, &total_error, 1, MPI_INT, MPI_SUM, ACTOR_RANK, MPI_COMM_WORLD);
+    if (my_rank == ACTOR_RANK) printf("aligned partitions: %d error(s)\n", total_error);
+
+    // x(i) = i + 1
+    double buf[NROWS], got[NROWS];
+    for (int i = 0; i < NROWS; i++) buf[i] = (double) (i + 1);
+    if (my_rank == ACTOR_RANK) GTM_putVectorRange(x, 0, NROWS, &buf[0]);
+    GTM_syncVector(x);
+    if (my_rank == ACTOR_RANK)
+    {
+        n_error = 0;
+        GTM_getVectorRange(x, 2, 7, &got[0]);
+        for (int i = 0; i < 7; i++)
+            if (got[i] != buf[2 + i]) n_error++;
+        printf("range put / get: %d error(s)\n", n_error);
+
+        // Unordered and duplicate indices
+        int idx[8] = {10, 0, 5, 5, 3, 9, 1, 0};
+        n_error = 0;
+        GTM_gatherVector(x, 8, &idx[0], &got[0]);
+        for (int i = 0; i < 8; i++)
+            if (got[i] != buf[idx[i]]) n_error++;
+        printf("gather: %d error(s)\n", n_error);
+    }
+    GTM_syncVector(x);
+
+    // Each process adds 1 to y(j) for j % 4 == my_rank, and 1 to y(0) twice
+    int idx[NCOLS + 2], num = 0;
+    double ones[NCOLS + 2];
+    for (int j = my_rank; j < NCOLS; j += 4) idx[num++] = j;
+    idx[num++] = 0;
+    idx[num++] = 0;
+    for (int i = 0; i < num; i++) ones[i] = 1.0;
+    GTM_fillVector(y, 0.0);
+    GTM_syncVector(y);
+    GTM_scatterAccVector(y, num, &idx[0], &ones[0]);
+    GTM_syncVector(y);
+    if (my_rank == ACTOR_RANK)
+    {
+        n_error = 0;
+        GTM_getVectorRange(y, 0, NCOLS, &got[0]);
+        for (int j = 0; j < NCOLS; j++)
+        {
+            double expected = 1.0 + ((j == 0) ? 2.0 * comm_size : 0.0);
+            if (got[j] != expected) n_error++;
+        }
+        printf("scatter accumulate: %d error(s)\n", n_error);
+    }
+    GTM_syncVector(y);
+
+    // Reductions of x(i) = i + 1, x := 2 * x - x
+    GTM_Vector_t z;
+    GTM_createAlignedVector(&z, gtm, GTM_VEC_ALIGN_ROW);
+    GTM_fillVector(z, 0.0);
+    GTM_axpbyVector(1.0, x, 0.0, z);
+    GTM_scaleVector(z, 2.0);
+    GTM_axpbyVector(-1.0, x, 1.0, z);
+    double dot, nrm2, asum, amax;
+    GTM_dotVector(x, z, &dot);
+    GTM_nrm2Vector(z, &nrm2);
+    GTM_asumVector(z, &asum);
+    GTM_amaxVector(z, &amax);
+    if (my_rank == ACTOR_RANK) printf("dot = %g, nrm2 = %g, asum = %g, amax = %g\n", dot, nrm2, asum, amax);
+
+    GTM_destroyVector(x);
+    GTM_destroyVector(y);
+    GTM_destroyVector(z);
+    GTM_destroy(gtm);
+    MPI_Finalize();
+}
@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 0
+#define NROUND     10
+#define NITER      20
+
+/*
+Run with: mpirun -np 4 ./test_versioned.x
+Correct output:
+10 round(s) of concurrent reads and updates, 0 inconsistent read(s)
+published version 11, A(7, 7) = 801
+published version 2, symmetrized matrix:
+ 1.000	 2.000	 3.000	 4.000
+ 2.000	 3.000	 4.000	 5.000
+ 3.000	 4.000	 5.000	 6.000
+ 4.000	 5.000	 6.000	 7.000
+*/
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    int displs[3] = {0, 4, 8};
+    int my_rank, nprocs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+    GTMatrix_t gtm;
+    int one = 1, buf[64], mat[64];
+    GTM_createEx(
+        &gtm, MPI_COMM_WORLD, MPI_INT, 4, my_rank, 8, 8, 
+        2, 2, &displs[0], &displs[0], GTM_STORAGE_VERSIONED
+    );
+    GTM_fill(gtm, &one);
+    GTM_publish(gtm);
+
+    // In each round, all processes read the published version while 
+    // accumulating to the next version, without any synchronization
+    int n_bad = 0, total_bad, expected = 1;
+    for (int i = 0; i < 64; i++) buf[i] = 1;
+    for (int round = 0; round < NROUND; round++)
+    {
+        GTM_copyPublished(gtm);
+        for (int iter = 0; iter < NITER; iter++)
+        {
+            GTM_accBlock(gtm, 0, 8, 0, 8, &buf[0], 8);
+            GTM_getBlock(gtm, 0, 8, 0, 8, &mat[0], 8);
+            for (int i = 0; i < 64; i++) 
+                if (mat[i] != expected) { n_bad++; break; }
+        }
+        GTM_publish(gtm);
+        expected += nprocs * NITER;
+    }
+    MPI_Reduce(&n_bad, &total_bad, 1, MPI_INT, MPI_SUM, ACTOR_RANK, MPI_COMM_WORLD);
+    if (my_rank == ACTOR_RANK)
+    {
+        GTM_getBlock(gtm, 7, 1, 7, 1, &mat[0], 1);
+        printf(
+            "%d round(s) of concurrent reads and updates, %d inconsistent read(s)\n", 
+            NROUND, total_bad
+        );
+        printf("published version %d, A(7, 7) = %d\n", gtm->version, mat[0]);
+    }
+    GTM_sync(gtm);
+    GTM_destroy(gtm);
+
+    // Symmetrize a double matrix: the result is in the next version
+    GTMatrix_t gtm_d;
+    double d_buf[16];
+    int d_displs[3] = {0, 2, 4};
+    GTM_createEx(
+        &gtm_d, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, 4, 4, 
+        2, 2, &d_displs[0], &d_displs[0], GTM_STORAGE_VERSIONED
+    );
+    if (my_rank == ACTOR_RANK)
+    {
+        // Lower triangle holds 2 * (i + j + 1), upper triangle holds 0
+        for (int i = 0; i < 4; i++)
+        {
+            for (int j = 0; j < 4; j++)
+            {
+                d_buf[i * 4 + j] = 0.0;
+                if (i >  j) d_buf[i * 4 + j] = (double) (2 * (i + j + 1));
+                if (i == j) d_buf[i * 4 + j] = (double) (i + j + 1);
+            }
+        }
+        GTM_putBlock(gtm_d, 0, 4, 0, 4, &d_buf[0], 4);
+    }
+    GTM_publish(gtm_d);
+    GTM_symmetrize(gtm_d);
+    GTM_publish(gtm_d);
+    if (my_rank == ACTOR_RANK)
+    {
+        GTM_getBlock(gtm_d, 0, 4, 0, 4, &d_buf[0], 4);
+        printf("published version %d, ", gtm_d->version);
+        print_double_mat(&d_buf[0], 4, 4, 4, "symmetrized matrix");
+    }
+    GTM_sync(gtm_d);
+    GTM_destroy(gtm_d);
+
+    MPI_Finalize();
+}
@@ -0,0 +1,179 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#include "GTMatrix.h"
+#include "utils.h"
+
+#define ACTOR_RANK 0
+#define N          10
+
+/*
+Run with: mpirun -np 4 ./test_view.x
+Correct output:
+view    (rows 3-8, cols 2-9) owner blocks: rows [0, 1], cols [0, 1]
+subview (rows 4-7, cols 4-8) owner blocks: rows [1, 1], cols [1, 1]
+out-of-view access returns GTM_INVALID_BLOCK = 1
+full storage     : checksum = 1611.000, max |view - direct| = 0.000
+symmetric storage: checksum = 2686.000, max |view - direct| = 0.000
+*/
+
+// View: rows [3, 9), cols [2, 10); subview: rows [1, 5), cols [2, 7) of the view
+#define V_R0  3
+#define V_NR  6
+#define V_C0  2
+#define V_NC  8
+#define S_R0  1
+#define S_NR  4
+#define S_C0  2
+#define S_NC  5
+
+static int create_mat(GTMatrix_t *gtm, int my_rank, int storage_flags)
+{
+    int displs[3] = {0, 4, N};
+    return GTM_createEx(
+        gtm, MPI_COMM_WORLD, MPI_DOUBLE, 8, my_rank, N, N,
+        2, 2, &displs[0], &displs[0], storage_flags
+    );
+}
+
+// Same operations on the view handles and with explicit offsets, return the whole matrices
+static void run_ops(GTMatrix_t gtm_v, GTMatrix_t gtm_d, int my_rank, double *mat_v, double *mat_d)
+{
+    double zero = 0.0, one = 1.0, half = 0.5, src[N * N];
+    GTM_View_t view, sub;
+
+    GTM_createView(&view, gtm_v, V_R0, V_NR, V_C0, V_NC);
+    GTM_createSubView(&sub, view, S_R0, S_NR, S_C0, S_NC);
+
+    // Fill the view with 1, the same as putting a block of 1 to the region
+    GTM_fill(gtm_v, &zero);
+    GTM_fill(gtm_d, &zero);
+    GTM_sync(gtm_v);
+    GTM_sync(gtm_d);
+    GTM_viewFill(view, &one);
+    if (my_rank == ACTOR_RANK)
+    {
+        for (int i = 0; i < N * N; i++) src[i] = 1.0;
+        GTM_putBlock(gtm_d, V_R0, V_NR, V_C0, V_NC, &src[0], N);
+    }
+    GTM_sync(gtm_v);
+    GTM_sync(gtm_d);
+
+    // Accumulate from all processes: blocking, nonblocking, scaled and batched
+    for (int i = 0; i < N * N; i++) src[i] = (double) (i % 7 + my_rank);
+    GTM_viewAccBlock(view, 0, 3, 1, 5, &src[0], N);
+    GTM_accBlock(gtm_d, V_R0 + 0, 3, V_C0 + 1, 5, &src[0], N);
+    GTM_viewAccBlockNB(sub, 1, 3, 0, 5, &src[3], N);
+    GTM_accBlockNB(gtm_d, V_R0 + S_R0 + 1, 3, V_C0 + S_C0 + 0, 5, &src[3], N);
+    GTM_waitNB(gtm_v);
+    GTM_waitNB(gtm_d);
+    GTM_viewAccBlockScaled(view, 2, 4, 0, V_NC, &src[0], N, &half);
+    GTM_accBlockScaled(gtm_d, V_R0 + 2, 4, V_C0, V_NC, &src[0], N, &half);
+    GTM_startBatchAcc(gtm_v);
+    GTM_viewAddAccBlockRequest(view, 0, V_NR, 0, V_NC, &src[0], N);
+    GTM_viewAddAccBlockScaledRequest(sub, 0, S_NR, 0, S_NC, &src[5], N, &half);
+    GTM_execBatchAcc(gtm_v);
+    GTM_stopBatchAcc(gtm_v);
+    GTM_startBatchAcc(gtm_d);
+    GTM_addAccBlockRequest(gtm_d, V_R0, V_NR, V_C0, V_NC, &src[0], N);
+    GTM_addAccBlockScaledRequest(gtm_d, V_R0 + S_R0, S_NR, V_C0 + S_C0, S_NC, &src[5], N, &half);
+    GTM_execBatchAcc(gtm_d);
+    GTM_stopBatchAcc(gtm_d);
+    GTM_sync(gtm_v);
+    GTM_sync(gtm_d);
+
+    // Element-wise maximum and put on the subview
+    GTM_viewUpdateBlockOp(sub, 0, S_NR, 0, S_NC, &src[0], N, MPI_MAX);
+    GTM_updateBlockOp(gtm_d, V_R0 + S_R0, S_NR, V_C0 + S_C0, S_NC, &src[0], N, MPI_MAX);
+    GTM_sync(gtm_v);
+    GTM_sync(gtm_d);
+    if (my_rank == ACTOR_RANK)
+    {
+        GTM_viewPutBlock(sub, 2, 2, 1, 3, &src[0], N);
+        GTM_putBlock(gtm_d, V_R0 + S_R0 + 2, 2, V_C0 + S_C0 + 1, 3, &src[0], N);
+    }
+    GTM_sync(gtm_v);
+    GTM_sync(gtm_d);
+
+    // Read the view with batched gets, the rest of the matrix directly
+    if (my_rank == ACTOR_RANK)
+    {
+        GTM_getBlock(gtm_v, 0, N, 0, N, mat_v, N);
+        GTM_startBatchGet(gtm_v);
+        GTM_viewAddGetBlockRequest(view, 0, V_NR, 0, 4, &mat_v[V_R0 * N + V_C0], N);
+        GTM_viewAddGetBlockRequest(view, 0, V_NR, 4, V_NC - 4, &mat_v[V_R0 * N + V_C0 + 4], N);
+        GTM_execBatchGet(gtm_v);
+        GTM_stopBatchGet(gtm_v);
+        GTM_getBlock(gtm_d, 0, N, 0, N, mat_d, N);
+    }
+    GTM_sync(gtm_v);
+    GTM_sync(gtm_d);
+
+    GTM_destroyView(sub);
+    GTM_destroyView(view);
+}
+
+static void compare(int my_rank, int storage_flags, const char *name)
+{
+    GTMatrix_t gtm_v, gtm_d;
+    double mat_v[N * N], mat_d[N * N];
+    create_mat(&gtm_v, my_rank, storage_flags);
+    create_mat(&gtm_d, my_rank, storage_flags);
+    run_ops(gtm_v, gtm_d, my_rank, &mat_v[0], &mat_d[0]);
+    if (my_rank == ACTOR_RANK)
+    {
+        double checksum = 0.0, max_diff = 0.0;
+        for (int i = 0; i < N * N; i++)
+        {
+            checksum += mat_v[i];
+            double diff = mat_v[i] - mat_d[i];
+            if (diff < 0.0) diff = -diff;
+            if (diff > max_diff) max_diff = diff;
+        }
+        printf("%s: checksum = %.3lf, max |view - direct| = %.3lf\n", name, checksum, max_diff);
+    }
+    GTM_destroy(gtm_v);
+    GTM_destroy(gtm_d);
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    int my_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+    GTMatrix_t gtm;
+    GTM_View_t view, sub;
+    double buf[N * N];
+    create_mat(&gtm, my_rank, GTM_STORAGE_DEFAULT);
+    GTM_createView(&view, gtm, V_R0, V_NR, V_C0, V_NC);
+    GTM_createSubView(&sub, view, S_R0, S_NR, S_C0, S_NC);
+    if (my_rank == ACTOR_RANK)
+    {
+        int *vr = &view->owner_range[0], *sr = &sub->owner_range[0];
+        printf(
+            "view    (rows %d-%d, cols %d-%d) owner blocks: rows [%d, %d], cols [%d, %d]\n",
+            view->row_start, view->row_start + view->row_num - 1,
+            view->col_start, view->col_start + view->col_num - 1, vr[0], vr[1], vr[2], vr[3]
+        );
+        printf(
+            "subview (rows %d-%d, cols %d-%d) owner blocks: rows [%d, %d], cols [%d, %d]\n",
+            sub->row_start, sub->row_start + sub->row_num - 1,
+            sub->col_start, sub->col_start + sub->col_num - 1, sr[0], sr[1], sr[2], sr[3]
+        );
+        int ret = GTM_viewGetBlock(sub, 2, 3, 0, 1, &buf[0], N);
+        printf("out-of-view access returns GTM_INVALID_BLOCK = %d\n", (ret == GTM_INVALID_BLOCK) ? 1 : 0);
+    }
+    GTM_destroyView(sub);
+    GTM_destroyView(view);
+    GTM_sync(gtm);
+    GTM_destroy(gtm);
+
+    compare(my_rank, GTM_STORAGE_DEFAULT, "full storage     ");
+    compare(my_rank, GTM_STORAGE_SYMM,    "symmetric storage");
+
+    MPI_Finalize();
+}
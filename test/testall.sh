@@ -3,4 +3,29 @@ mpirun -np 16 ./test_batch_acc.x
 mpirun -np 16 ./test_nonblk_acc.x
 mpirun -np 16 ./test_Symmetrize.x
 mpirun -np 16 ./test_task_queue.x
-mpirun -np 4  ./test_complex.x
\ No newline at end of file
+mpirun -np 4  ./test_complex.x
+mpirun -np 4  ./test_blk_sparse.x
+mpirun -np 4  ./test_symm_storage.x
+mpirun -np 4  ./test_acc_sym.x
+mpirun -np 4  ./test_acc_scaled.x
+mpirun -np 4  ./test_update_op.x
+mpirun -np 4  ./test_atomic.x
+mpirun -np 4  ./test_region_lock.x
+mpirun -np 4  ./test_mutex.x
+mpirun -np 4  ./test_notify.x
+mpirun -np 4  ./test_sync.x
+mpirun -np 4  ./test_sync_touched.x
+mpirun -np 4  ./test_versioned.x
+mpirun -np 4  ./test_track.x
+mpirun -np 4  ./test_tiled.x
+mpirun -np 4  ./test_col_major.x
+mpirun -np 4  ./test_view.x
+mpirun -np 4  ./test_plan.x
+mpirun -np 4  ./test_halo.x
+mpirun -np 4  ./test_panel.x
+mpirun -np 4  ./test_potrf.x
+mpirun -np 4  ./test_trsm.x
+mpirun -np 4  ./test_csr.x
+mpirun -np 4  ./test_tensor.x
+mpirun -np 4  ./test_vector.x
+mpirun -np 4  ./test_buffer.x
\ No newline at end of file
@@ -103,6 +103,20 @@ void getRectIntersection(
     getSegmentIntersection(ys0, ye0, ys1, ye1, intersection, iys, iye);
 }
 
+int isZeroMatrixBlock(const void *blk, const int ld_bytes, const int nrows, const int row_bytes)
+{
+    const unsigned char *row_ptr = (const unsigned char*) blk;
+    for (int irow = 0; irow < nrows; irow++)
+    {
+        // OR reduction without early exit in a row, can be vectorized by compiler
+        unsigned char row_or = 0;
+        for (int i = 0; i < row_bytes; i++) row_or |= row_ptr[i];
+        if (row_or != 0) return 0;
+        row_ptr += ld_bytes;
+    }
+    return 1;
+}
+
 int getElementIndexInArray(const int elem, const int *array, const int array_size)
 {
     int ret = -1;
@@ -11,6 +11,8 @@ extern "C" {
 #define ALIGN64B_FREE(x)   _mm_free(x)
 #define DBL_SIZE           sizeof(double)
 #define INT_SIZE           sizeof(int)
+#define MAX(a, b)          ((a) > (b) ? (a) : (b))
+#define MIN(a, b)          ((a) < (b) ? (a) : (b))
 
 // Get current wall-clock time, similar to omp_get_wtime()
 double get_wtime_sec();
@@ -42,6 +44,10 @@ void getRectIntersection(
 	int *ixs, int *ixe, int *iys, int *iye
 );
 
+// Check if all bytes in a block of a matrix are zero, returning 1 means all zero
+// ld_bytes and row_bytes are the leading dimension and row size, unit is byte
+int isZeroMatrixBlock(const void *blk, const int ld_bytes, const int nrows, const int row_bytes);
+
 // Get the (first) index of an integer element in an array, returning -1 means no such element
 int getElementIndexInArray(const int elem, const int *array, const int array_size);
 